@@ -0,0 +1,192 @@
+/**
+ * @file lidar_benchmark.cpp
+ * @brief Correctness and throughput of the lidar kernels
+ *
+ * Every kernel the CPU supports is first checked against a plain reference
+ * loop on random scans and on scans built around the edges of the valid
+ * range: readings exactly at LIDAR_MIN_VALID, LIDAR_MAX_RANGE and
+ * OBSTACLE_THRESHOLD, out of range, negative, infinite and NaN. Masks,
+ * counts and minimums must match exactly and means to 1e-12; the kernels
+ * must also agree with each other bit for bit. Any mismatch is printed and
+ * makes the program exit with status 1.
+ *
+ * Then each kernel summarizes millions of scans stored in a SensorStore,
+ * best of 5 passes.
+ *
+ * Usage:
+ * @code
+ * rwa2_lidar_benchmark [--scans N]
+ * @endcode
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "lidar_kernels.hpp"
+#include "sensor_store.hpp"
+#include "sensor_types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr std::array<LidarKernel, 2> kKernels{LidarKernel::SCALAR, LidarKernel::AVX2};
+
+/// The processing step as written without the kernels
+LidarSummary reference(const double *readings) {
+  LidarSummary summary;
+  summary.min_distance = std::numeric_limits<double>::infinity();
+  double sum{0.0};
+  for (int i = 0; i < LIDAR_READINGS_COUNT; ++i) {
+    const double distance{readings[i]};
+    if (distance >= LIDAR_MIN_VALID && distance <= LIDAR_MAX_RANGE) {
+      summary.valid_mask = static_cast<std::uint8_t>(summary.valid_mask | 1u << i);
+      ++summary.valid_count;
+      summary.obstacles += distance < OBSTACLE_THRESHOLD ? 1 : 0;
+      summary.min_distance = std::min(summary.min_distance, distance);
+      sum += distance;
+    }
+  }
+  summary.mean_distance = summary.valid_count > 0 ? sum / summary.valid_count : 0.0;
+  return summary;
+}
+
+/// Random scans, half of them made of edge values
+std::vector<double> test_scans(std::size_t count) {
+  const std::array<double, 12> edges{LIDAR_MIN_VALID,
+                                     std::nextafter(LIDAR_MIN_VALID, 0.0),
+                                     LIDAR_MAX_RANGE,
+                                     std::nextafter(LIDAR_MAX_RANGE, 20.0),
+                                     OBSTACLE_THRESHOLD,
+                                     std::nextafter(OBSTACLE_THRESHOLD, 0.0),
+                                     LIDAR_MIN_RANGE,
+                                     0.0,
+                                     -1.0,
+                                     1e9,
+                                     std::numeric_limits<double>::infinity(),
+                                     std::numeric_limits<double>::quiet_NaN()};
+  std::mt19937 gen{7};
+  std::uniform_real_distribution<double> distance{LIDAR_MIN_RANGE, LIDAR_MAX_RANGE};
+  std::uniform_int_distribution<std::size_t> edge{0, edges.size() - 1};
+  std::vector<double> scans(count * LIDAR_READINGS_COUNT);
+  for (std::size_t i = 0; i < scans.size(); ++i) {
+    scans[i] = i / LIDAR_READINGS_COUNT % 2 == 0 ? distance(gen) : edges[edge(gen)];
+  }
+  return scans;
+}
+
+bool same(const LidarSummary &a, const LidarSummary &b, bool exact) {
+  const bool mean{exact ? std::memcmp(&a.mean_distance, &b.mean_distance, sizeof(double)) == 0
+                        : std::abs(a.mean_distance - b.mean_distance) <=
+                              1e-12 * std::max(1.0, std::abs(b.mean_distance))};
+  return a.valid_mask == b.valid_mask && a.valid_count == b.valid_count &&
+         a.obstacles == b.obstacles && a.min_distance == b.min_distance && mean;
+}
+
+/// Number of scans on which a kernel disagrees with the reference or the
+/// scalar kernel
+std::size_t check(LidarKernel kernel, const std::vector<double> &scans) {
+  const std::size_t count{scans.size() / LIDAR_READINGS_COUNT};
+  std::vector<LidarSummary> got(count);
+  std::vector<LidarSummary> scalar(count);
+  summarize_lidar(kernel, scans.data(), count, got.data());
+  summarize_lidar(LidarKernel::SCALAR, scans.data(), count, scalar.data());
+  std::size_t errors{0};
+  for (std::size_t i = 0; i < count; ++i) {
+    const LidarSummary expected{reference(scans.data() + i * LIDAR_READINGS_COUNT)};
+    if (!same(got[i], expected, false) || !same(got[i], scalar[i], true)) {
+      if (errors++ < 5) {
+        std::cout << "  " << to_string(kernel) << " scan " << i << ": mask "
+                  << int{got[i].valid_mask} << " vs " << int{expected.valid_mask}
+                  << ", obstacles " << got[i].obstacles << " vs " << expected.obstacles
+                  << ", min " << got[i].min_distance << " vs " << expected.min_distance
+                  << ", mean " << got[i].mean_distance << " vs " << expected.mean_distance
+                  << '\n';
+      }
+    }
+  }
+  return errors;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t count{4'000'000};
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (arg == "--scans" && i + 1 < argc) {
+      count = std::stoul(argv[++i]);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--scans N]\n";
+      return 1;
+    }
+  }
+
+  std::cout << "best kernel: " << to_string(best_lidar_kernel()) << "\n\n";
+  const std::vector<double> scans{test_scans(100'000)};
+  bool failed{false};
+  for (LidarKernel kernel : kKernels) {
+    if (!lidar_kernel_supported(kernel)) {
+      std::cout << std::left << std::setw(8) << to_string(kernel) << "not supported\n";
+      continue;
+    }
+    const std::size_t errors{check(kernel, scans)};
+    failed = failed || errors > 0;
+    std::cout << std::left << std::setw(8) << to_string(kernel)
+              << (errors == 0 ? "matches" : "MISMATCHES") << " the reference on "
+              << scans.size() / LIDAR_READINGS_COUNT << " scans\n";
+  }
+
+  SensorStore store;
+  store.reserve(count);
+  std::mt19937 gen{1};
+  std::uniform_real_distribution<double> distance{LIDAR_MIN_RANGE, LIDAR_MAX_RANGE};
+  for (std::size_t t = 0; t < count; ++t) {
+    double *block{store.append(static_cast<int>(t), CameraData{0, 0, 0})};
+    for (int i = 0; i < LIDAR_READINGS_COUNT; ++i) {
+      block[i] = distance(gen);
+    }
+  }
+  std::vector<LidarSummary> summaries(count);
+
+  std::cout << '\n'
+            << count << " scans\n"
+            << std::left << std::setw(12) << "kernel" << std::right << std::setw(14)
+            << "M scans/s" << std::setw(10) << "GB/s" << std::setw(12) << "obstacles" << '\n';
+  for (LidarKernel kernel : kKernels) {
+    if (!lidar_kernel_supported(kernel)) {
+      continue;
+    }
+    double best{std::numeric_limits<double>::infinity()};
+    for (int pass = 0; pass < 5; ++pass) {
+      const auto start{std::chrono::steady_clock::now()};
+      summarize_lidar(kernel, store.lidar_data(), count, summaries.data());
+      best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                          start)
+                                .count());
+    }
+    long obstacles{0};
+    for (const LidarSummary &summary : summaries) {
+      obstacles += summary.obstacles;
+    }
+    std::cout << std::left << std::setw(12) << to_string(kernel) << std::right << std::fixed
+              << std::setprecision(1) << std::setw(14) << count / best / 1e6 << std::setw(10)
+              << count * LIDAR_READINGS_COUNT * sizeof(double) / best / 1e9 << std::setw(12)
+              << obstacles << '\n';
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,293 @@
+/**
+ * @file pipeline_benchmark.cpp
+ * @brief Batch processing against the streaming SensorPipeline
+ *
+ * For growing numbers of readings, the same random readings are processed
+ * twice:
+ * - batch, as rwa2_demo does: generate everything into a SensorStore, then
+ *   summarize the lidar column and fold the totals;
+ * - streaming: a SensorPipeline generates, processes and folds each reading
+ *   on three threads connected by bounded queues.
+ *
+ * Reported are the throughput, the peak heap memory of each run, measured by
+ * counting allocations, and the latency from ingestion to statistics. In
+ * batch mode a reading waits at least for every later reading to be
+ * generated, so only the worst case, that of the first reading, is shown;
+ * the streaming percentiles are the pipeline's own StreamingQuantile
+ * estimates. Both modes must agree on every total, or the program exits
+ * with status 1.
+ *
+ * The streaming stages only overlap with more than one CPU; on a single CPU
+ * they take turns, and the queue capacity bounds how many readings are
+ * handed over per turn.
+ *
+ * A last run paces the source at a sensor rate, as a live robot would, and
+ * reports the CPU time the pipeline used against the wall-clock time: the
+ * stages sleep between readings rather than spin.
+ *
+ * Usage:
+ * @code
+ * rwa2_pipeline_benchmark [--readings N] [--capacity C] [--rate R]
+ * @endcode
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "lidar_kernels.hpp"
+#include "sensor_pipeline.hpp"
+#include "sensor_store.hpp"
+#include "sensor_types.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Heap accounting: every block carries its size in a header. The pipeline
+// allocates from several threads, hence the atomics.
+constexpr std::size_t kHeader{alignof(std::max_align_t)};
+std::atomic<std::size_t> g_live_bytes{0};
+std::atomic<std::size_t> g_peak_bytes{0};
+
+void *allocate(std::size_t size, std::size_t alignment) {
+  const std::size_t header{std::max(kHeader, alignment)};
+  const std::size_t total{(size + header + alignment - 1) / alignment * alignment};
+  auto *block{static_cast<char *>(alignment > kHeader ? std::aligned_alloc(alignment, total)
+                                                      : std::malloc(total))};
+  if (block == nullptr) {
+    throw std::bad_alloc{};
+  }
+  // The size sits just before the returned pointer, whatever the alignment
+  char *pointer{block + header};
+  reinterpret_cast<std::size_t *>(pointer)[-1] = size;
+  reinterpret_cast<std::size_t *>(pointer)[-2] = header;
+  const std::size_t live{g_live_bytes.fetch_add(size) + size};
+  std::size_t peak{g_peak_bytes.load()};
+  while (live > peak && !g_peak_bytes.compare_exchange_weak(peak, live)) {
+  }
+  return pointer;
+}
+
+void deallocate(void *pointer) {
+  if (pointer == nullptr) {
+    return;
+  }
+  const std::size_t *sizes{static_cast<const std::size_t *>(pointer)};
+  g_live_bytes.fetch_sub(sizes[-1]);
+  std::free(static_cast<char *>(pointer) - sizes[-2]);
+}
+
+/**
+ * @brief Peak heap growth over a scope
+ */
+class HeapWatermark {
+public:
+  HeapWatermark() : base_{g_live_bytes.load()} { g_peak_bytes.store(base_); }
+  [[nodiscard]] std::size_t peak() const { return g_peak_bytes.load() - base_; }
+
+private:
+  std::size_t base_;
+};
+
+/**
+ * @brief Random readings, the same sequence for a given seed
+ */
+class Generator {
+public:
+  explicit Generator(unsigned seed) : gen_{seed} {}
+
+  void next(double *lidar, CameraData &camera) {
+    for (int i = 0; i < LIDAR_READINGS_COUNT; ++i) {
+      lidar[i] = distance_(gen_);
+    }
+    camera = CameraData{color_(gen_), color_(gen_), color_(gen_)};
+  }
+
+private:
+  std::mt19937 gen_;
+  std::uniform_real_distribution<double> distance_{LIDAR_MIN_RANGE, LIDAR_MAX_RANGE};
+  std::uniform_int_distribution<int> color_{RGB_MIN, RGB_MAX};
+};
+
+constexpr unsigned kSeed{42};
+
+PipelineTotals run_batch(std::size_t count) {
+  SensorStore store;
+  store.reserve(count);
+  Generator generator{kSeed};
+  for (std::size_t t = 0; t < count; ++t) {
+    CameraData camera;
+    std::array<double, LIDAR_READINGS_COUNT> lidar;
+    generator.next(lidar.data(), camera);
+    std::copy(lidar.begin(), lidar.end(), store.append(static_cast<int>(t), camera));
+  }
+  std::vector<LidarSummary> summaries(count);
+  summarize_lidar(store.lidar_data(), count, summaries.data());
+
+  PipelineTotals totals;
+  for (std::size_t t = 0; t < count; ++t) {
+    const LidarSummary &lidar{summaries[t]};
+    const double brightness{(store.red()[t] + store.green()[t] + store.blue()[t]) / 3.0};
+    ++totals.readings;
+    if (lidar.valid_count > 0) {
+      totals.lidar_distance.add(lidar.mean_distance);
+    }
+    totals.obstacles += lidar.obstacles;
+    totals.quality.record<SensorKind::LIDAR>(lidar.valid_count == LIDAR_READINGS_COUNT);
+    totals.brightness.add(brightness);
+    totals.quality.record<SensorKind::CAMERA>(brightness > BRIGHTNESS_THRESHOLD);
+    if (brightness > DAY_NIGHT_THRESHOLD) {
+      ++totals.day;
+    } else {
+      ++totals.night;
+    }
+  }
+  return totals;
+}
+
+bool same(const PipelineTotals &a, const PipelineTotals &b) {
+  const auto same_stats{[](const RunningStats &x, const RunningStats &y) {
+    return x.count() == y.count() && x.mean() == y.mean() && x.variance() == y.variance() &&
+           x.min() == y.min() && x.max() == y.max();
+  }};
+  return a.readings == b.readings && same_stats(a.lidar_distance, b.lidar_distance) &&
+         a.obstacles == b.obstacles && same_stats(a.brightness, b.brightness) &&
+         a.quality == b.quality &&
+         a.day == b.day && a.night == b.night;
+}
+
+void print_row(const char *mode, std::size_t count, double seconds, std::size_t heap) {
+  std::cout << std::left << std::setw(11) << mode << std::right << std::setw(10) << count
+            << std::fixed << std::setprecision(1) << std::setw(12) << count / seconds / 1e6
+            << std::setw(14) << static_cast<double>(heap) / 1024;
+}
+
+} // namespace
+
+void *operator new(std::size_t size) { return allocate(size, kHeader); }
+void *operator new(std::size_t size, std::align_val_t alignment) {
+  return allocate(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void *pointer) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, std::size_t /*size*/) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, std::align_val_t /*alignment*/) noexcept {
+  deallocate(pointer);
+}
+void operator delete(void *pointer, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  deallocate(pointer);
+}
+
+int main(int argc, char *argv[]) {
+  using clock = std::chrono::steady_clock;
+  std::size_t max_count{4'000'000};
+  std::size_t capacity{256};
+  double rate{2000.0};
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (arg == "--readings" && i + 1 < argc) {
+      max_count = std::stoul(argv[++i]);
+    } else if (arg == "--capacity" && i + 1 < argc) {
+      capacity = std::stoul(argv[++i]);
+    } else if (arg == "--rate" && i + 1 < argc) {
+      rate = std::stod(argv[++i]);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--readings N] [--capacity C] [--rate R]\n";
+      return 1;
+    }
+  }
+
+  std::cout << std::thread::hardware_concurrency() << " CPU(s), queue capacity " << capacity
+            << "\n\n"
+            << std::left << std::setw(11) << "mode" << std::right << std::setw(10) << "readings"
+            << std::setw(12) << "M/s" << std::setw(14) << "heap KiB" << std::setw(12)
+            << "p50 us" << std::setw(12) << "p99 us" << std::setw(12) << "max us" << '\n';
+  bool failed{false};
+  for (const std::size_t divisor : {16, 4, 1}) {
+    const std::size_t count{std::max<std::size_t>(max_count / divisor, 1)};
+    PipelineTotals batch;
+    {
+      const HeapWatermark heap;
+      const auto start{clock::now()};
+      batch = run_batch(count);
+      const double seconds{std::chrono::duration<double>(clock::now() - start).count()};
+      print_row("batch", count, seconds, heap.peak());
+      std::cout << std::setw(12) << '-' << std::setw(12) << '-' << std::setw(12)
+                << seconds * 1e6 << '\n';
+    }
+
+    PipelineTotals streamed;
+    {
+      Generator generator{kSeed};
+      int timestamp{0};
+      const SensorPipeline::Source source{[&](SensorReading &reading) {
+        if (static_cast<std::size_t>(timestamp) == count) {
+          return false;
+        }
+        reading.timestamp = timestamp++;
+        generator.next(reading.lidar.data(), reading.camera);
+        return true;
+      }};
+      const SensorPipeline pipeline{capacity};
+      const HeapWatermark heap;
+      const auto start{clock::now()};
+      streamed = pipeline.run(source);
+      const double seconds{std::chrono::duration<double>(clock::now() - start).count()};
+      print_row("streaming", count, seconds, heap.peak());
+      std::cout << std::setw(12) << streamed.latency_median.value() * 1e6 << std::setw(12)
+                << streamed.latency_p99.value() * 1e6 << std::setw(12)
+                << streamed.latency.max() * 1e6 << '\n';
+    }
+
+    if (!same(batch, streamed)) {
+      std::cout << "  MISMATCH: " << batch.obstacles << " vs " << streamed.obstacles
+                << " obstacles, " << batch.day << " vs " << streamed.day << " day frames\n";
+      failed = true;
+    }
+  }
+
+  // Half a second of readings, each released at its time
+  const auto paced_count{static_cast<std::size_t>(std::max(rate / 2, 1.0))};
+  Generator generator{kSeed};
+  std::size_t released{0};
+  const auto start{clock::now()};
+  const SensorPipeline::Source paced{[&](SensorReading &reading) {
+    if (released == paced_count) {
+      return false;
+    }
+    std::this_thread::sleep_until(
+        start + std::chrono::duration_cast<clock::duration>(
+                    std::chrono::duration<double>(static_cast<double>(released) / rate)));
+    reading.timestamp = static_cast<int>(released++);
+    generator.next(reading.lidar.data(), reading.camera);
+    return true;
+  }};
+  const std::clock_t cpu_start{std::clock()};
+  const PipelineTotals totals{SensorPipeline{capacity}.run(paced)};
+  const double cpu{static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC};
+  const double wall{std::chrono::duration<double>(clock::now() - start).count()};
+  std::cout << "\npaced source, " << totals.readings << " readings at " << std::setprecision(0)
+            << rate << "/s: wall " << std::setprecision(1) << wall * 1e3 << " ms, CPU "
+            << cpu * 1e3 << " ms (" << cpu / wall * 100 << "% of one CPU), p50 latency "
+            << totals.latency_median.value() * 1e6 << " us\n";
+  if (static_cast<std::size_t>(totals.readings) != paced_count) {
+    std::cout << "  MISMATCH: " << totals.readings << " of " << paced_count << " readings\n";
+    failed = true;
+  }
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,200 @@
+/**
+ * @file registry_benchmark.cpp
+ * @brief Per-reading cost of counting valid and total sensor readings
+ *
+ * Every reading counts one lidar scan and one camera frame, valid or not
+ * from a random pattern, with:
+ * - std::unordered_map<std::string, int> keyed by "LIDAR" and "Camera", as
+ *   rwa2_demo declared them;
+ * - QualityCounters with the kind known at compile time, then at run time;
+ * - several threads sharing one array of atomic counters, and several
+ *   threads each recording into a shard of ShardedQualityCounters.
+ *
+ * Every method must end with the same counts, or the program exits with
+ * status 1. Times are the best of 3 passes. The threaded methods only show
+ * their contention with more than one CPU.
+ *
+ * Usage:
+ * @code
+ * rwa2_registry_benchmark [--readings N] [--threads T]
+ * @endcode
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "sensor_registry.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Validity of each reading: lidar at even indices, camera at odd ones
+using Pattern = std::vector<std::uint8_t>;
+
+Pattern random_pattern(std::size_t readings) {
+  std::mt19937 gen{11};
+  std::bernoulli_distribution valid{0.8};
+  Pattern pattern(readings * 2);
+  for (std::uint8_t &flag : pattern) {
+    flag = valid(gen) ? 1 : 0;
+  }
+  return pattern;
+}
+
+QualityCounters count_map(const Pattern &pattern) {
+  std::unordered_map<std::string, int> valid_readings{{"LIDAR", 0}, {"Camera", 0}};
+  std::unordered_map<std::string, int> total_readings{{"LIDAR", 0}, {"Camera", 0}};
+  for (std::size_t i = 0; i < pattern.size(); i += 2) {
+    ++total_readings["LIDAR"];
+    valid_readings["LIDAR"] += pattern[i];
+    ++total_readings["Camera"];
+    valid_readings["Camera"] += pattern[i + 1];
+  }
+  QualityCounters counters;
+  counters.add(SensorKind::LIDAR, static_cast<std::uint64_t>(valid_readings["LIDAR"]),
+               static_cast<std::uint64_t>(total_readings["LIDAR"]));
+  counters.add(SensorKind::CAMERA, static_cast<std::uint64_t>(valid_readings["Camera"]),
+               static_cast<std::uint64_t>(total_readings["Camera"]));
+  return counters;
+}
+
+QualityCounters count_static(const Pattern &pattern) {
+  QualityCounters counters;
+  for (std::size_t i = 0; i < pattern.size(); i += 2) {
+    counters.record<SensorKind::LIDAR>(pattern[i] != 0);
+    counters.record<SensorKind::CAMERA>(pattern[i + 1] != 0);
+  }
+  return counters;
+}
+
+QualityCounters count_dynamic(const Pattern &pattern) {
+  // The kinds come from data, as they would from a table of sensors
+  const std::array<SensorKind, 2> kinds{SensorKind::LIDAR, SensorKind::CAMERA};
+  QualityCounters counters;
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    counters.record(kinds[i % 2], pattern[i] != 0);
+  }
+  return counters;
+}
+
+/// Runs @p work(thread, begin, end) on @p threads threads over the readings
+void split(const Pattern &pattern, std::size_t threads,
+           const std::function<void(std::size_t, std::size_t, std::size_t)> &work) {
+  const std::size_t readings{pattern.size() / 2};
+  std::vector<std::thread> workers;
+  for (std::size_t t = 0; t < threads; ++t) {
+    workers.emplace_back(work, t, readings * t / threads * 2, readings * (t + 1) / threads * 2);
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+QualityCounters count_shared_atomics(const Pattern &pattern, std::size_t threads) {
+  std::array<std::atomic<std::uint64_t>, SENSOR_KIND_COUNT> valid{};
+  std::array<std::atomic<std::uint64_t>, SENSOR_KIND_COUNT> total{};
+  split(pattern, threads, [&](std::size_t, std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; i += 2) {
+      total[0].fetch_add(1, std::memory_order_relaxed);
+      valid[0].fetch_add(pattern[i], std::memory_order_relaxed);
+      total[1].fetch_add(1, std::memory_order_relaxed);
+      valid[1].fetch_add(pattern[i + 1], std::memory_order_relaxed);
+    }
+  });
+  QualityCounters counters;
+  for (SensorKind kind : all_sensor_kinds()) {
+    const auto index{static_cast<std::size_t>(kind)};
+    counters.add(kind, valid[index].load(), total[index].load());
+  }
+  return counters;
+}
+
+QualityCounters count_sharded(const Pattern &pattern, std::size_t threads) {
+  ShardedQualityCounters counters{threads};
+  split(pattern, threads, [&](std::size_t thread, std::size_t begin, std::size_t end) {
+    ShardedQualityCounters::Shard &shard{counters.shard(thread)};
+    for (std::size_t i = begin; i < end; i += 2) {
+      shard.record<SensorKind::LIDAR>(pattern[i] != 0);
+      shard.record<SensorKind::CAMERA>(pattern[i + 1] != 0);
+    }
+  });
+  return counters.snapshot();
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t readings{10'000'000};
+  std::size_t threads{std::max(2u, std::thread::hardware_concurrency())};
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (arg == "--readings" && i + 1 < argc) {
+      readings = std::stoul(argv[++i]);
+    } else if (arg == "--threads" && i + 1 < argc) {
+      threads = std::max<std::size_t>(1, std::stoul(argv[++i]));
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--readings N] [--threads T]\n";
+      return 1;
+    }
+  }
+
+  const Pattern pattern{random_pattern(readings)};
+  QualityCounters expected;
+  for (std::size_t i = 0; i < pattern.size(); ++i) {
+    expected.add(i % 2 == 0 ? SensorKind::LIDAR : SensorKind::CAMERA, pattern[i], 1);
+  }
+  std::cout << readings << " readings of " << SENSOR_KIND_COUNT << " sensors, "
+            << std::thread::hardware_concurrency() << " CPU(s)\n";
+  for (SensorKind kind : all_sensor_kinds()) {
+    std::cout << "  " << to_string(kind) << ": " << expected.valid(kind) << '/'
+              << expected.total(kind) << " valid\n";
+  }
+
+  const std::string threaded{" (" + std::to_string(threads) + " threads)"};
+  const std::vector<std::pair<std::string, std::function<QualityCounters()>>> methods{
+      {"unordered_map<string>", [&] { return count_map(pattern); }},
+      {"QualityCounters<Kind>", [&] { return count_static(pattern); }},
+      {"QualityCounters(kind)", [&] { return count_dynamic(pattern); }},
+      {"shared atomics" + threaded, [&] { return count_shared_atomics(pattern, threads); }},
+      {"sharded" + threaded, [&] { return count_sharded(pattern, threads); }}};
+
+  std::cout << '\n' << std::left << std::setw(30) << "method" << std::right << std::setw(14)
+            << "ns/reading" << '\n';
+  bool failed{false};
+  for (const auto &[name, method] : methods) {
+    double best{1e300};
+    bool same{true};
+    for (int pass = 0; pass < 3; ++pass) {
+      const auto start{std::chrono::steady_clock::now()};
+      const QualityCounters counters{method()};
+      best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                          start)
+                                .count());
+      same = same && counters == expected;
+    }
+    failed = failed || !same;
+    std::cout << std::left << std::setw(30) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(14)
+              << best / static_cast<double>(readings) * 1e9 << (same ? "" : "  MISMATCH")
+              << '\n';
+  }
+  return failed ? 1 : 0;
+}
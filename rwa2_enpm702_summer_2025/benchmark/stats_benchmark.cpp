@@ -0,0 +1,203 @@
+/**
+ * @file stats_benchmark.cpp
+ * @brief Accuracy and cost of the running statistics
+ *
+ * RunningStats is checked against an exact two-pass computation in long
+ * double on uniform distances and on distances offset by 1e9, directly and
+ * after merging per-thread partitions. The offset values are badly
+ * conditioned: the variance is then allowed a relative error of 1e-6
+ * instead of 1e-9, and the error of the sum-of-squares formula is shown for
+ * comparison. StreamingQuantile is checked against the sorted values for
+ * the median and the 99th percentile of uniform, normal and exponential
+ * values: its error must stay within 1% of the spread between the 1st and
+ * 99th percentiles. Any failure is printed and makes the program exit with
+ * status 1.
+ *
+ * Then the cost of one update is measured, against the memory the raw
+ * history would need.
+ *
+ * Usage:
+ * @code
+ * rwa2_stats_benchmark [--values N]
+ * @endcode
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "running_stats.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+bool g_failed{false};
+// Results of the timed loops land here so that they are not optimized away
+volatile double g_sink{0.0};
+
+void report(const std::string &name, double error, double tolerance) {
+  const bool ok{error <= tolerance};
+  g_failed = g_failed || !ok;
+  std::cout << "  " << std::left << std::setw(40) << name << std::right << std::scientific
+            << std::setprecision(2) << std::setw(10) << error << (ok ? "  ok" : "  FAILED")
+            << '\n';
+}
+
+double relative(double value, long double exact) {
+  return static_cast<double>(std::abs((value - exact) / (exact != 0.0L ? exact : 1.0L)));
+}
+
+void check_moments(const std::string &name, const std::vector<double> &values,
+                   double variance_tolerance) {
+  long double mean{0.0L};
+  for (double value : values) {
+    mean += value;
+  }
+  mean /= static_cast<long double>(values.size());
+  long double m2{0.0L};
+  for (double value : values) {
+    m2 += (value - mean) * (value - mean);
+  }
+  const long double variance{m2 / static_cast<long double>(values.size())};
+
+  RunningStats stats;
+  // Four partitions, as four threads would fill them
+  std::vector<RunningStats> parts(4);
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    stats.add(values[i]);
+    parts[i * parts.size() / values.size()].add(values[i]);
+  }
+  RunningStats merged;
+  for (const RunningStats &part : parts) {
+    merged.merge(part);
+  }
+  const auto [min, max] = std::minmax_element(values.begin(), values.end());
+  double sum{0.0};
+  double sum_of_squares{0.0};
+  for (double value : values) {
+    sum += value;
+    sum_of_squares += value * value;
+  }
+  const double naive_mean{sum / static_cast<double>(values.size())};
+  const double naive{sum_of_squares / static_cast<double>(values.size()) -
+                     naive_mean * naive_mean};
+
+  report(name + ": mean", relative(stats.mean(), mean), 1e-12);
+  report(name + ": variance", relative(stats.variance(), variance), variance_tolerance);
+  report(name + ": min and max",
+         std::max(std::abs(stats.min() - *min), std::abs(stats.max() - *max)), 0.0);
+  report(name + ": merged mean", relative(merged.mean(), mean), 1e-12);
+  report(name + ": merged variance", relative(merged.variance(), variance),
+         variance_tolerance);
+  std::cout << "  " << std::left << std::setw(40) << name + ": sum-of-squares variance"
+            << std::right << std::setw(10) << relative(naive, variance) << "  (not checked)\n";
+}
+
+void check_quantile(const std::string &name, std::vector<double> values, double probability) {
+  StreamingQuantile quantile{probability};
+  for (double value : values) {
+    quantile.add(value);
+  }
+  std::sort(values.begin(), values.end());
+  const auto at{[&](double p) {
+    return values[static_cast<std::size_t>(p * static_cast<double>(values.size() - 1))];
+  }};
+  const double spread{at(0.99) - at(0.01)};
+  report(name, std::abs(quantile.value() - at(probability)) / spread, 0.01);
+}
+
+template <typename Distribution>
+std::vector<double> sample(Distribution distribution, std::size_t count, double offset = 0.0) {
+  std::mt19937 gen{3};
+  std::vector<double> values(count);
+  for (double &value : values) {
+    value = offset + distribution(gen);
+  }
+  return values;
+}
+
+double nanoseconds_per_value(const std::vector<double> &values,
+                             const std::function<double(const std::vector<double> &)> &run) {
+  double best{1e300};
+  for (int pass = 0; pass < 3; ++pass) {
+    const auto start{std::chrono::steady_clock::now()};
+    g_sink = run(values);
+    best = std::min(best, std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                                        start)
+                              .count());
+  }
+  return best / static_cast<double>(values.size()) * 1e9;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t count{10'000'000};
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (arg == "--values" && i + 1 < argc) {
+      count = std::stoul(argv[++i]);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--values N]\n";
+      return 1;
+    }
+  }
+
+  const std::size_t checked{std::min<std::size_t>(count, 1'000'000)};
+  std::cout << "accuracy on " << checked << " values (relative error)\n";
+  const std::uniform_real_distribution<double> uniform{0.01, 10.0};
+  check_moments("uniform", sample(uniform, checked), 1e-9);
+  check_moments("uniform + 1e9", sample(uniform, checked, 1e9), 1e-6);
+  for (double probability : {0.5, 0.99}) {
+    const std::string suffix{probability == 0.5 ? " median" : " p99"};
+    check_quantile("uniform" + suffix, sample(uniform, checked), probability);
+    check_quantile("normal" + suffix, sample(std::normal_distribution<double>{5.0, 1.0}, checked),
+                   probability);
+    check_quantile("exponential" + suffix,
+                   sample(std::exponential_distribution<double>{1.0}, checked), probability);
+  }
+
+  const std::vector<double> values{sample(uniform, count)};
+  std::cout << '\n'
+            << count << " values, history would take " << std::fixed << std::setprecision(1)
+            << static_cast<double>(count * sizeof(double)) / (1 << 20) << " MiB\n"
+            << std::left << std::setw(20) << "update" << std::right << std::setw(10)
+            << "ns/value" << std::setw(10) << "bytes" << '\n';
+  const auto row{[](const char *name, double ns, std::size_t bytes) {
+    std::cout << std::left << std::setw(20) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(10) << ns << std::setw(10) << bytes << '\n';
+  }};
+  row("RunningStats",
+      nanoseconds_per_value(values,
+                            [](const std::vector<double> &v) {
+                              RunningStats stats;
+                              for (double value : v) {
+                                stats.add(value);
+                              }
+                              return stats.mean();
+                            }),
+      sizeof(RunningStats));
+  row("StreamingQuantile",
+      nanoseconds_per_value(values,
+                            [](const std::vector<double> &v) {
+                              StreamingQuantile quantile{0.99};
+                              for (double value : v) {
+                                quantile.add(value);
+                              }
+                              return quantile.value();
+                            }),
+      sizeof(StreamingQuantile));
+  return g_failed ? 1 : 0;
+}
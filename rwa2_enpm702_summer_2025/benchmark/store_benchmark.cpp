@@ -0,0 +1,181 @@
+/**
+ * @file store_benchmark.cpp
+ * @brief Ingest and processing throughput of std::vector<TimestampData>
+ * against the columnar SensorStore, at millions of timestamps
+ *
+ * Both containers ingest the same readings, drawn from a pool generated up
+ * front so that random number generation is not timed, then a processing
+ * pass computes the mean lidar distance and mean camera brightness over
+ * every timestamp, once through the TimestampData-style iterator and once
+ * over the raw columns.
+ *
+ * Usage:
+ * @code
+ * rwa2_store_benchmark [--timestamps N]
+ * @endcode
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "sensor_store.hpp"
+#include "sensor_types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kPool{4096};
+
+struct Pool {
+  std::vector<double> lidar;
+  std::vector<CameraData> camera;
+};
+
+Pool make_pool() {
+  std::mt19937 gen{42};
+  std::uniform_real_distribution<double> lidar_dist{LIDAR_MIN_RANGE, LIDAR_MAX_RANGE};
+  std::uniform_int_distribution<int> camera_dist{RGB_MIN, RGB_MAX};
+  Pool pool;
+  for (std::size_t i = 0; i < kPool * LIDAR_READINGS_COUNT; ++i) {
+    pool.lidar.push_back(lidar_dist(gen));
+  }
+  for (std::size_t i = 0; i < kPool; ++i) {
+    pool.camera.emplace_back(camera_dist(gen), camera_dist(gen), camera_dist(gen));
+  }
+  return pool;
+}
+
+double brightness(const CameraData &camera) {
+  const auto [r, g, b] = camera;
+  return (r + g + b) / 3.0;
+}
+
+struct Means {
+  double lidar{0.0};
+  double brightness{0.0};
+};
+
+/// The processing loop of main(), on any container of timestamps
+template <typename Readings>
+Means process(const Readings &readings) {
+  Means means;
+  for (const auto &data : readings) {
+    double sum{0.0};
+    for (double distance : data.lidar_readings) {
+      sum += distance;
+    }
+    means.lidar += sum / LIDAR_READINGS_COUNT;
+    means.brightness += brightness(data.camera_readings);
+  }
+  means.lidar /= static_cast<double>(readings.size());
+  means.brightness /= static_cast<double>(readings.size());
+  return means;
+}
+
+/// The same pass over the raw columns of a store
+Means process_columns(const SensorStore &store) {
+  static_assert(LIDAR_READINGS_COUNT % 4 == 0, "Lidar blocks split into 4 lanes");
+  const std::size_t count{store.size()};
+  const double *lidar{store.lidar_data()};
+  // Independent partial sums, so the additions do not wait on each other
+  double partial[4]{};
+  for (std::size_t i = 0; i < count * LIDAR_READINGS_COUNT; i += 4) {
+    for (std::size_t lane = 0; lane < 4; ++lane) {
+      partial[lane] += lidar[i + lane];
+    }
+  }
+  const double lidar_sum{(partial[0] + partial[1]) + (partial[2] + partial[3])};
+  long channel_sum{0};
+  for (std::size_t i = 0; i < count; ++i) {
+    channel_sum += store.red()[i] + store.green()[i] + store.blue()[i];
+  }
+  Means means;
+  means.lidar = lidar_sum / static_cast<double>(count * LIDAR_READINGS_COUNT);
+  means.brightness = static_cast<double>(channel_sum) / 3.0 / static_cast<double>(count);
+  return means;
+}
+
+template <typename Function>
+double seconds(Function &&function) {
+  const auto start{std::chrono::steady_clock::now()};
+  function();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void report(std::string_view name, std::size_t count, double ingest, double pass,
+            double bytes, const Means &means) {
+  // Millions of timestamps per second
+  std::cout << std::left << std::setw(26) << name << std::right << std::fixed
+            << std::setprecision(1) << std::setw(12) << count / ingest / 1e6 << std::setw(12)
+            << count / pass / 1e6 << std::setw(12) << bytes
+            << std::setprecision(4) << std::setw(10) << means.lidar << std::setw(10)
+            << means.brightness << '\n';
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  std::size_t count{4'000'000};
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg{argv[i]};
+    if (arg == "--timestamps" && i + 1 < argc) {
+      count = std::stoul(argv[++i]);
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--timestamps N]\n";
+      return 1;
+    }
+  }
+  const Pool pool{make_pool()};
+
+  std::cout << count << " timestamps\n"
+            << std::left << std::setw(26) << "container" << std::right << std::setw(12)
+            << "ingest M/s" << std::setw(12) << "process M/s" << std::setw(12) << "bytes/ts"
+            << std::setw(10) << "lidar" << std::setw(10) << "bright" << '\n';
+
+  {
+    std::vector<TimestampData> readings;
+    const double ingest{seconds([&] {
+      readings.reserve(count);
+      for (std::size_t t = 0; t < count; ++t) {
+        const double *lidar{pool.lidar.data() + t % kPool * LIDAR_READINGS_COUNT};
+        readings.push_back(TimestampData{LidarData(lidar, lidar + LIDAR_READINGS_COUNT),
+                                         pool.camera[t % kPool], static_cast<int>(t)});
+      }
+    })};
+    Means means;
+    const double pass{seconds([&] { means = process(readings); })};
+    // Each LidarData buffer is a separate heap block, whose allocator
+    // overhead is not counted
+    const double bytes{sizeof(TimestampData) + LIDAR_READINGS_COUNT * sizeof(double)};
+    report("vector<TimestampData>", count, ingest, pass, bytes, means);
+  }
+
+  SensorStore store;
+  const double ingest{seconds([&] {
+    store.reserve(count);
+    for (std::size_t t = 0; t < count; ++t) {
+      const double *lidar{pool.lidar.data() + t % kPool * LIDAR_READINGS_COUNT};
+      double *block{store.append(static_cast<int>(t), pool.camera[t % kPool])};
+      std::copy(lidar, lidar + LIDAR_READINGS_COUNT, block);
+    }
+  })};
+  Means means;
+  const double pass{seconds([&] { means = process(store); })};
+  const double bytes{static_cast<double>(store.capacity_bytes()) / static_cast<double>(count)};
+  report("SensorStore (iterator)", count, ingest, pass, bytes, means);
+  const double column_pass{seconds([&] { means = process_columns(store); })};
+  report("SensorStore (columns)", count, ingest, column_pass, bytes, means);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file lidar_kernels.hpp
+ * @brief Vectorized validation and obstacle detection on lidar scans
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef LIDAR_KERNELS_HPP
+#define LIDAR_KERNELS_HPP
+
+#include "sensor_types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+static_assert(LIDAR_READINGS_COUNT == 8, "The lidar kernels process scans of 8 readings");
+
+/**
+ * @brief Everything the processing step needs from one lidar scan
+ *
+ * A reading is valid when it lies within [LIDAR_MIN_VALID, LIDAR_MAX_RANGE];
+ * NaN is never valid. Only valid readings count as obstacles or enter the
+ * minimum and the mean.
+ */
+struct LidarSummary {
+    std::uint8_t valid_mask{0}; ///< Bit i set if reading i is valid
+    int valid_count{0};         ///< Number of valid readings
+    int obstacles{0};           ///< Valid readings closer than OBSTACLE_THRESHOLD
+    double min_distance{0.0};   ///< Closest valid reading, infinity if none
+    double mean_distance{0.0};  ///< Mean of the valid readings, 0 if none
+};
+
+/**
+ * @brief Implementations of the lidar kernels
+ */
+enum class LidarKernel {
+    SCALAR, ///< Portable C++
+    AVX2    ///< Two 256-bit vectors per scan, x86-64 CPUs with AVX2 only
+};
+
+/**
+ * @brief Name of a kernel
+ */
+const char *to_string(LidarKernel kernel);
+
+/**
+ * @brief Check whether a kernel can run on this CPU
+ */
+bool lidar_kernel_supported(LidarKernel kernel);
+
+/**
+ * @brief Fastest kernel this CPU supports, detected once at run time
+ */
+LidarKernel best_lidar_kernel();
+
+/**
+ * @brief Summarize consecutive scans with the fastest supported kernel
+ *
+ * Every kernel gives bit-identical results: the scalar kernel adds the
+ * readings in the same order as the vector lanes.
+ * @param scans @p count blocks of LIDAR_READINGS_COUNT readings, e.g.
+ * SensorStore::lidar_data()
+ * @param count Number of scans
+ * @param summaries Output, @p count summaries
+ */
+void summarize_lidar(const double *scans, std::size_t count, LidarSummary *summaries);
+
+/**
+ * @brief Summarize consecutive scans with a given kernel
+ * @throws std::invalid_argument if this CPU does not support @p kernel
+ */
+void summarize_lidar(LidarKernel kernel, const double *scans, std::size_t count,
+                     LidarSummary *summaries);
+
+#endif // LIDAR_KERNELS_HPP
@@ -0,0 +1,104 @@
+/**
+ * @file sensor_pipeline.hpp
+ * @brief Streaming ingestion of sensor readings on three threads
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SENSOR_PIPELINE_HPP
+#define SENSOR_PIPELINE_HPP
+
+#include "lidar_kernels.hpp"
+#include "running_stats.hpp"
+#include "sensor_registry.hpp"
+#include "sensor_types.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+/**
+ * @brief Readings of both sensors at one timestamp, as they arrive
+ */
+struct SensorReading {
+    int timestamp{0};                                 ///< Timestamp
+    std::array<double, LIDAR_READINGS_COUNT> lidar{}; ///< Lidar scan
+    CameraData camera{};                              ///< Camera color
+    std::chrono::steady_clock::time_point captured{}; ///< When it was ingested
+};
+
+/**
+ * @brief A reading once both sensors were processed
+ */
+struct ProcessedReading {
+    int timestamp{0};                                 ///< Timestamp
+    LidarSummary lidar;                               ///< Lidar scan summary
+    double brightness{0.0};                           ///< Mean of R, G and B
+    std::chrono::steady_clock::time_point captured{}; ///< When it was ingested
+};
+
+/**
+ * @brief Running statistics of a pipeline, updated as each reading arrives
+ *
+ * Nothing grows with the number of readings: every field is a counter, a
+ * RunningStats, a StreamingQuantile or QualityCounters.
+ */
+struct PipelineTotals {
+    long readings{0};             ///< Readings processed
+    RunningStats lidar_distance;  ///< Mean distance of each scan with a valid reading
+    long obstacles{0};            ///< Obstacles detected
+    RunningStats brightness;      ///< Camera brightness
+    long day{0};                  ///< Frames brighter than DAY_NIGHT_THRESHOLD
+    long night{0};                ///< Other frames
+    /// Valid readings: scans with every reading valid, frames brighter than
+    /// BRIGHTNESS_THRESHOLD
+    QualityCounters quality;
+    RunningStats latency;         ///< Ingest-to-statistics seconds
+    StreamingQuantile latency_median{0.5}; ///< Estimated median latency
+    StreamingQuantile latency_p99{0.99};   ///< Estimated 99th percentile latency
+};
+
+/**
+ * @brief Producer, processing and statistics stages, each on its own thread,
+ * connected by bounded SpscQueue rings
+ *
+ * The producer pulls readings from a source and stamps them; the processing
+ * stage summarizes the lidar scan with summarize_lidar() and computes the
+ * camera brightness; the statistics stage folds each result into the
+ * running totals and hands it to an optional sink. A full queue blocks the
+ * stage feeding it, so memory is fixed by the queue capacity whatever the
+ * length of the run, and a reading waits behind at most two queues.
+ */
+class SensorPipeline {
+public:
+    /// Fills in the next reading; returns false when there is none left
+    using Source = std::function<bool(SensorReading &)>;
+    /// Receives each processed reading and the totals including it
+    using Sink = std::function<void(const ProcessedReading &, const PipelineTotals &)>;
+
+    /**
+     * @brief Construct a pipeline
+     * @param capacity Readings each queue holds before blocking its producer
+     */
+    explicit SensorPipeline(std::size_t capacity = 256) : capacity_{capacity} {}
+
+    /**
+     * @brief Stream every reading of a source through the stages
+     *
+     * Blocks until the source is exhausted and every reading was processed.
+     * The source runs on the producer thread and the sink on the statistics
+     * thread. An exception thrown by either is rethrown here once the stages
+     * have stopped.
+     * @return The final totals
+     */
+    PipelineTotals run(const Source &source, const Sink &sink = {}) const;
+
+private:
+    std::size_t capacity_; ///< Capacity of each queue
+};
+
+#endif // SENSOR_PIPELINE_HPP
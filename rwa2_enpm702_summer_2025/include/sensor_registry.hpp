@@ -0,0 +1,203 @@
+/**
+ * @file sensor_registry.hpp
+ * @brief Kinds of sensors and their quality counters
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SENSOR_REGISTRY_HPP
+#define SENSOR_REGISTRY_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Kinds of sensors on the robot
+ *
+ * Adding a sensor, e.g. an IMU or an ultrasonic ranger, takes a new
+ * enumerator before COUNT and its name in SENSOR_KIND_NAMES: the counters
+ * size themselves from COUNT, so the loops recording readings of the other
+ * sensors do not change.
+ */
+enum class SensorKind : std::size_t {
+    LIDAR,  ///< 8-beam lidar
+    CAMERA, ///< RGB camera
+    COUNT   ///< Number of kinds, not a sensor
+};
+
+/// Number of kinds of sensors
+constexpr std::size_t SENSOR_KIND_COUNT{static_cast<std::size_t>(SensorKind::COUNT)};
+
+/// Name of each kind of sensor, in the order of SensorKind
+constexpr std::array<const char *, SENSOR_KIND_COUNT> SENSOR_KIND_NAMES{"LIDAR", "Camera"};
+
+/**
+ * @brief Name of a kind of sensor
+ */
+constexpr const char *to_string(SensorKind kind) {
+    return SENSOR_KIND_NAMES[static_cast<std::size_t>(kind)];
+}
+
+/**
+ * @brief Every kind of sensor, in order, for loops over all of them
+ */
+constexpr std::array<SensorKind, SENSOR_KIND_COUNT> all_sensor_kinds() {
+    std::array<SensorKind, SENSOR_KIND_COUNT> kinds{};
+    for (std::size_t i = 0; i < SENSOR_KIND_COUNT; ++i) {
+        kinds[i] = static_cast<SensorKind>(i);
+    }
+    return kinds;
+}
+
+/**
+ * @brief Valid and total readings of each kind of sensor
+ *
+ * Replaces std::unordered_map<std::string, int> keyed by sensor name: a
+ * kind is an index into two fixed arrays, known at compile time in
+ * record<Kind>(), so recording a reading is two increments, with no string
+ * to build or hash.
+ */
+class QualityCounters {
+public:
+    /**
+     * @brief Count a reading of a sensor known at compile time
+     * @param valid Whether the reading passed its quality check
+     */
+    template <SensorKind Kind>
+    void record(bool valid) {
+        static_assert(Kind < SensorKind::COUNT, "Not a sensor");
+        constexpr auto index{static_cast<std::size_t>(Kind)};
+        ++total_[index];
+        valid_[index] += valid ? 1 : 0;
+    }
+
+    /**
+     * @brief Count a reading of a sensor known at run time
+     */
+    void record(SensorKind kind, bool valid) {
+        const auto index{static_cast<std::size_t>(kind)};
+        ++total_[index];
+        valid_[index] += valid ? 1 : 0;
+    }
+
+    /**
+     * @brief Count many readings of a sensor at once
+     */
+    void add(SensorKind kind, std::uint64_t valid, std::uint64_t total) {
+        valid_[static_cast<std::size_t>(kind)] += valid;
+        total_[static_cast<std::size_t>(kind)] += total;
+    }
+
+    /**
+     * @brief Add the counts of another instance, e.g. one per thread
+     */
+    void merge(const QualityCounters &other) {
+        for (std::size_t i = 0; i < SENSOR_KIND_COUNT; ++i) {
+            valid_[i] += other.valid_[i];
+            total_[i] += other.total_[i];
+        }
+    }
+
+    /// @brief Readings of @p kind that passed their quality check
+    std::uint64_t valid(SensorKind kind) const { return valid_[static_cast<std::size_t>(kind)]; }
+    /// @brief Readings of @p kind
+    std::uint64_t total(SensorKind kind) const { return total_[static_cast<std::size_t>(kind)]; }
+
+    bool operator==(const QualityCounters &other) const {
+        return valid_ == other.valid_ && total_ == other.total_;
+    }
+    bool operator!=(const QualityCounters &other) const { return !(*this == other); }
+
+private:
+    std::array<std::uint64_t, SENSOR_KIND_COUNT> valid_{};
+    std::array<std::uint64_t, SENSOR_KIND_COUNT> total_{};
+};
+
+/**
+ * @brief Quality counters updated by several threads and read by any
+ *
+ * Each thread records into its own shard, on its own cache line, so that
+ * threads never write to the same line; snapshot() adds the shards up. A
+ * shard has a single writer, which updates it with plain relaxed loads and
+ * stores instead of atomic read-modify-writes; the atomics only make
+ * snapshot() safe to call while the writers run.
+ */
+class ShardedQualityCounters {
+public:
+    /**
+     * @brief Counters of one thread
+     */
+    class alignas(64) Shard {
+    public:
+        /**
+         * @brief Count a reading of a sensor known at compile time
+         */
+        template <SensorKind Kind>
+        void record(bool valid) {
+            static_assert(Kind < SensorKind::COUNT, "Not a sensor");
+            constexpr auto index{static_cast<std::size_t>(Kind)};
+            bump(total_[index], 1);
+            bump(valid_[index], valid ? 1 : 0);
+        }
+
+        /**
+         * @brief Count a reading of a sensor known at run time
+         */
+        void record(SensorKind kind, bool valid) {
+            const auto index{static_cast<std::size_t>(kind)};
+            bump(total_[index], 1);
+            bump(valid_[index], valid ? 1 : 0);
+        }
+
+    private:
+        friend class ShardedQualityCounters;
+
+        static void bump(std::atomic<std::uint64_t> &counter, std::uint64_t amount) {
+            counter.store(counter.load(std::memory_order_relaxed) + amount,
+                          std::memory_order_relaxed);
+        }
+
+        std::array<std::atomic<std::uint64_t>, SENSOR_KIND_COUNT> valid_{};
+        std::array<std::atomic<std::uint64_t>, SENSOR_KIND_COUNT> total_{};
+    };
+
+    /**
+     * @brief Construct the counters
+     * @param shards Number of shards, one per writing thread
+     */
+    explicit ShardedQualityCounters(std::size_t shards) : shards_(shards) {}
+
+    /**
+     * @brief Shard of the @p index-th writing thread
+     */
+    Shard &shard(std::size_t index) { return shards_[index]; }
+
+    /// @brief Number of shards
+    std::size_t shards() const { return shards_.size(); }
+
+    /**
+     * @brief Sum of every shard
+     */
+    QualityCounters snapshot() const {
+        QualityCounters sum;
+        for (const Shard &part : shards_) {
+            for (SensorKind kind : all_sensor_kinds()) {
+                const auto index{static_cast<std::size_t>(kind)};
+                sum.add(kind, part.valid_[index].load(std::memory_order_relaxed),
+                        part.total_[index].load(std::memory_order_relaxed));
+            }
+        }
+        return sum;
+    }
+
+private:
+    std::vector<Shard> shards_;
+};
+
+#endif // SENSOR_REGISTRY_HPP
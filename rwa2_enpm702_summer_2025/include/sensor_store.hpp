@@ -0,0 +1,218 @@
+/**
+ * @file sensor_store.hpp
+ * @brief Columnar storage of the sensor readings of many timestamps
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SENSOR_STORE_HPP
+#define SENSOR_STORE_HPP
+
+#include "sensor_types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <new>
+#include <vector>
+
+/**
+ * @brief Allocator returning memory aligned to a cache line
+ *
+ * A block of LIDAR_READINGS_COUNT doubles is then exactly one cache line.
+ */
+template <typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+    static constexpr std::size_t ALIGNMENT{64};
+
+    CacheAlignedAllocator() = default;
+    template <typename U>
+    CacheAlignedAllocator(const CacheAlignedAllocator<U> &) {}
+
+    T *allocate(std::size_t count) {
+        return static_cast<T *>(::operator new(count * sizeof(T), std::align_val_t{ALIGNMENT}));
+    }
+    void deallocate(T *pointer, std::size_t) {
+        ::operator delete(pointer, std::align_val_t{ALIGNMENT});
+    }
+
+    template <typename U>
+    bool operator==(const CacheAlignedAllocator<U> &) const { return true; }
+    template <typename U>
+    bool operator!=(const CacheAlignedAllocator<U> &) const { return false; }
+};
+
+/**
+ * @brief Read-only view of the LIDAR_READINGS_COUNT readings of a timestamp
+ *
+ * Iterates and indexes like the LidarData vector it stands for.
+ */
+class LidarView {
+public:
+    explicit LidarView(const double *readings) : readings_{readings} {}
+
+    const double *begin() const { return readings_; }
+    const double *end() const { return readings_ + LIDAR_READINGS_COUNT; }
+    const double *data() const { return readings_; }
+    static constexpr std::size_t size() { return LIDAR_READINGS_COUNT; }
+    double operator[](std::size_t index) const { return readings_[index]; }
+
+private:
+    const double *readings_;
+};
+
+/**
+ * @brief Readings of one timestamp in a SensorStore, with the members of
+ * TimestampData
+ */
+struct TimestampView {
+    LidarView lidar_readings;
+    CameraData camera_readings;
+    int timestamp;
+};
+
+/**
+ * @brief Sensor readings of many timestamps, one contiguous column per field
+ *
+ * Replaces std::vector<TimestampData>, which allocates a LidarData vector
+ * per timestamp and interleaves the camera tuple with it. Here the lidar
+ * readings are one array of fixed blocks of LIDAR_READINGS_COUNT doubles,
+ * each block a cache line, and the red, green and blue channels and the
+ * timestamps are arrays of their own. Ingesting a timestamp appends to
+ * each column and only allocates when a column grows, and a pass over one
+ * field streams through memory holding nothing else.
+ *
+ * Iterating yields TimestampView values, so loops written for
+ * std::vector<TimestampData> keep working:
+ * @code
+ * for (const auto &data : store) {
+ *     std::cout << data.timestamp << ' ' << data.lidar_readings[0] << '\n';
+ * }
+ * @endcode
+ */
+class SensorStore {
+public:
+    /**
+     * @brief Iterator over the timestamps of a store
+     */
+    class const_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = TimestampView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = TimestampView;
+
+        const_iterator(const SensorStore *store, std::size_t index)
+            : store_{store}, index_{index} {}
+
+        TimestampView operator*() const { return (*store_)[index_]; }
+        TimestampView operator[](difference_type offset) const {
+            return (*store_)[index_ + static_cast<std::size_t>(offset)];
+        }
+        const_iterator &operator++() { ++index_; return *this; }
+        const_iterator operator++(int) { const_iterator old{*this}; ++index_; return old; }
+        const_iterator &operator--() { --index_; return *this; }
+        const_iterator operator--(int) { const_iterator old{*this}; --index_; return old; }
+        const_iterator &operator+=(difference_type offset) {
+            index_ += static_cast<std::size_t>(offset);
+            return *this;
+        }
+        const_iterator &operator-=(difference_type offset) {
+            index_ -= static_cast<std::size_t>(offset);
+            return *this;
+        }
+        const_iterator operator+(difference_type offset) const {
+            return const_iterator{*this} += offset;
+        }
+        const_iterator operator-(difference_type offset) const {
+            return const_iterator{*this} -= offset;
+        }
+        difference_type operator-(const const_iterator &other) const {
+            return static_cast<difference_type>(index_) - static_cast<difference_type>(other.index_);
+        }
+        bool operator==(const const_iterator &other) const { return index_ == other.index_; }
+        bool operator!=(const const_iterator &other) const { return index_ != other.index_; }
+        bool operator<(const const_iterator &other) const { return index_ < other.index_; }
+        bool operator>(const const_iterator &other) const { return index_ > other.index_; }
+        bool operator<=(const const_iterator &other) const { return index_ <= other.index_; }
+        bool operator>=(const const_iterator &other) const { return index_ >= other.index_; }
+
+    private:
+        const SensorStore *store_;
+        std::size_t index_;
+    };
+
+    /**
+     * @brief Reserve space in every column
+     * @param count Number of timestamps to hold without reallocating
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Append the readings of a timestamp
+     * @param data Readings; the lidar must have LIDAR_READINGS_COUNT values
+     * and the color channels must be within RGB_MIN and RGB_MAX
+     * @throws std::invalid_argument if the readings do not fit the columns
+     */
+    void push_back(const TimestampData &data);
+
+    /**
+     * @brief Append a timestamp and let the caller write its lidar readings
+     * in place
+     * @param timestamp Timestamp of the readings
+     * @param camera Color of the camera, within RGB_MIN and RGB_MAX
+     * @return The block of LIDAR_READINGS_COUNT readings to fill in
+     * @throws std::invalid_argument if a color channel is out of range
+     */
+    double *append(int timestamp, const CameraData &camera);
+
+    /// @brief Remove every timestamp, keeping the memory
+    void clear();
+
+    /// @brief Number of timestamps
+    std::size_t size() const { return timestamps_.size(); }
+    /// @brief Check whether the store holds no timestamp
+    bool empty() const { return timestamps_.empty(); }
+
+    /// @brief Readings of the @p index-th timestamp
+    TimestampView operator[](std::size_t index) const {
+        return TimestampView{LidarView{lidar(index)},
+                             CameraData{red_[index], green_[index], blue_[index]},
+                             timestamps_[index]};
+    }
+
+    const_iterator begin() const { return const_iterator{this, 0}; }
+    const_iterator end() const { return const_iterator{this, size()}; }
+
+    /// @brief Lidar block of the @p index-th timestamp
+    const double *lidar(std::size_t index) const {
+        return lidar_.data() + index * LIDAR_READINGS_COUNT;
+    }
+    /// @brief Lidar column: size() blocks of LIDAR_READINGS_COUNT readings
+    const double *lidar_data() const { return lidar_.data(); }
+    /// @brief Red channel column
+    const std::uint8_t *red() const { return red_.data(); }
+    /// @brief Green channel column
+    const std::uint8_t *green() const { return green_.data(); }
+    /// @brief Blue channel column
+    const std::uint8_t *blue() const { return blue_.data(); }
+    /// @brief Timestamp column
+    const int *timestamps() const { return timestamps_.data(); }
+
+    /// @brief Bytes of memory reserved by the columns
+    std::size_t capacity_bytes() const;
+
+private:
+    std::vector<double, CacheAlignedAllocator<double>> lidar_; ///< Lidar blocks
+    std::vector<std::uint8_t> red_;                            ///< Red channel
+    std::vector<std::uint8_t> green_;                          ///< Green channel
+    std::vector<std::uint8_t> blue_;                           ///< Blue channel
+    std::vector<int> timestamps_;                              ///< Timestamps
+};
+
+#endif // SENSOR_STORE_HPP
@@ -0,0 +1,196 @@
+/**
+ * @file spsc_queue.hpp
+ * @brief Bounded lock-free queue between one producer and one consumer thread
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#ifndef SPSC_QUEUE_HPP
+#define SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Fixed-capacity ring buffer for exactly one producer thread and one
+ * consumer thread
+ *
+ * The producer only writes the tail index and the consumer only the head
+ * index, each on its own cache line, so neither side takes a lock. push()
+ * blocks while the queue is full, which is the backpressure that keeps a
+ * slow stage from letting the queue, and memory, grow. A waiting side spins
+ * a little, yields its time slice a few times, and then sleeps on a
+ * condition variable until the other side pushes, pops or closes. The
+ * other side only takes the lock to wake it when someone sleeps, so a busy
+ * queue stays lock-free, and a stage waiting for a slow source uses no
+ * CPU.
+ *
+ * @tparam T Element type, default-constructible and movable
+ */
+template <typename T>
+class SpscQueue {
+public:
+    /**
+     * @brief Construct a queue
+     * @param capacity Maximum number of elements, rounded up to a power of two
+     * @throws std::invalid_argument if @p capacity is 0
+     */
+    explicit SpscQueue(std::size_t capacity) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+        std::size_t size{1};
+        while (size < capacity) {
+            size *= 2;
+        }
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    /**
+     * @brief Append an element without waiting, from the producer thread
+     * @return false if the queue is full
+     */
+    bool try_push(T &value) {
+        const std::size_t tail{tail_.load(std::memory_order_relaxed)};
+        if (tail - cached_head_ == slots_.size()) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ == slots_.size()) {
+                return false;
+            }
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        wake();
+        return true;
+    }
+
+    /**
+     * @brief Append an element, waiting while the queue is full
+     */
+    void push(T value) {
+        for (int attempt = 0; !try_push(value); ++attempt) {
+            wait(attempt, [this] {
+                return tail_.load(std::memory_order_relaxed) -
+                           head_.load(std::memory_order_acquire) !=
+                       slots_.size();
+            });
+        }
+    }
+
+    /**
+     * @brief Remove the oldest element without waiting, from the consumer
+     * thread
+     * @return false if the queue is empty
+     */
+    bool try_pop(T &value) {
+        const std::size_t head{head_.load(std::memory_order_relaxed)};
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) {
+                return false;
+            }
+        }
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        wake();
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element, waiting while the queue is empty
+     * @return false once the queue is closed and empty
+     */
+    bool pop(T &value) {
+        for (int attempt = 0; !try_pop(value); ++attempt) {
+            if (closed_.load(std::memory_order_acquire)) {
+                // Elements pushed before close() are still delivered
+                return try_pop(value);
+            }
+            wait(attempt, [this] {
+                return closed_.load(std::memory_order_acquire) ||
+                       tail_.load(std::memory_order_acquire) !=
+                           head_.load(std::memory_order_relaxed);
+            });
+        }
+        return true;
+    }
+
+    /**
+     * @brief Tell the consumer that nothing more will be pushed
+     */
+    void close() {
+        closed_.store(true, std::memory_order_release);
+        wake();
+    }
+
+    /// @brief Maximum number of elements
+    std::size_t capacity() const { return slots_.size(); }
+
+private:
+    /// Attempts spent spinning, then yielding, before a waiting side sleeps
+    static constexpr int SPINS{64};
+    static constexpr int YIELDS{16};
+
+    /**
+     * @brief Wait before the next attempt, sleeping once the other side is
+     * clearly not about to make progress
+     * @param attempt Number of failed attempts so far
+     * @param ready Whether the attempt can now succeed
+     */
+    template <typename Ready>
+    void wait(int attempt, Ready ready) {
+        if (attempt < SPINS) {
+            return;
+        }
+        if (attempt < SPINS + YIELDS) {
+            std::this_thread::yield();
+            return;
+        }
+        std::unique_lock<std::mutex> lock{mutex_};
+        sleepers_.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in wake(): either the other side sees the
+        // sleeper and notifies, or this side sees its update in ready()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wakeup_.wait(lock, ready);
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Wake the other side if it sleeps in wait()
+     */
+    void wake() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers_.load(std::memory_order_relaxed) > 0) {
+            // Taking the lock orders the notification after the sleeper's
+            // last check of ready()
+            const std::lock_guard<std::mutex> lock{mutex_};
+            wakeup_.notify_all();
+        }
+    }
+
+    std::vector<T> slots_;  ///< Ring of elements
+    std::size_t mask_{0};   ///< capacity() - 1
+    alignas(64) std::atomic<std::size_t> head_{0}; ///< Next element to pop
+    std::size_t cached_tail_{0};                   ///< Consumer's copy of tail_
+    alignas(64) std::atomic<std::size_t> tail_{0}; ///< Next slot to push
+    std::size_t cached_head_{0};                   ///< Producer's copy of head_
+    alignas(64) std::atomic<bool> closed_{false};  ///< No more pushes
+    std::atomic<int> sleepers_{0};                 ///< Sides sleeping in wait()
+    std::mutex mutex_;                             ///< Guards the sleep
+    std::condition_variable wakeup_;               ///< Wakes a sleeping side
+};
+
+#endif // SPSC_QUEUE_HPP
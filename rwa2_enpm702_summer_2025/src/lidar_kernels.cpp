@@ -0,0 +1,163 @@
+/**
+ * @file lidar_kernels.cpp
+ * @brief Scalar and AVX2 lidar kernels, and their run-time dispatch
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "lidar_kernels.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define LIDAR_KERNELS_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr double kInfinity{std::numeric_limits<double>::infinity()};
+
+void summarize_scalar(const double *scans, std::size_t count, LidarSummary *summaries) {
+  for (std::size_t scan = 0; scan < count; ++scan) {
+    const double *readings{scans + scan * LIDAR_READINGS_COUNT};
+    LidarSummary summary;
+    summary.min_distance = kInfinity;
+    // Lane k holds readings k and k + 4, as in the AVX2 kernel
+    double lanes[4]{};
+    for (int i = 0; i < LIDAR_READINGS_COUNT; ++i) {
+      const double distance{readings[i]};
+      if (!(distance >= LIDAR_MIN_VALID && distance <= LIDAR_MAX_RANGE)) {
+        continue;
+      }
+      summary.valid_mask = static_cast<std::uint8_t>(summary.valid_mask | 1u << i);
+      ++summary.valid_count;
+      if (distance < OBSTACLE_THRESHOLD) {
+        ++summary.obstacles;
+      }
+      if (distance < summary.min_distance) {
+        summary.min_distance = distance;
+      }
+      lanes[i % 4] += distance;
+    }
+    const double sum{(lanes[0] + lanes[2]) + (lanes[1] + lanes[3])};
+    summary.mean_distance = summary.valid_count > 0 ? sum / summary.valid_count : 0.0;
+    summaries[scan] = summary;
+  }
+}
+
+#ifdef LIDAR_KERNELS_AVX2
+
+__attribute__((target("avx2,popcnt"))) void summarize_avx2(const double *scans, std::size_t count,
+                                                           LidarSummary *summaries) {
+  const __m256d min_valid{_mm256_set1_pd(LIDAR_MIN_VALID)};
+  const __m256d max_range{_mm256_set1_pd(LIDAR_MAX_RANGE)};
+  const __m256d threshold{_mm256_set1_pd(OBSTACLE_THRESHOLD)};
+  const __m256d infinity{_mm256_set1_pd(kInfinity)};
+  for (std::size_t scan = 0; scan < count; ++scan) {
+    const double *readings{scans + scan * LIDAR_READINGS_COUNT};
+    const __m256d low{_mm256_loadu_pd(readings)};
+    const __m256d high{_mm256_loadu_pd(readings + 4)};
+    // Ordered comparisons are false on NaN, which is then invalid
+    const __m256d valid_low{_mm256_and_pd(_mm256_cmp_pd(low, min_valid, _CMP_GE_OQ),
+                                          _mm256_cmp_pd(low, max_range, _CMP_LE_OQ))};
+    const __m256d valid_high{_mm256_and_pd(_mm256_cmp_pd(high, min_valid, _CMP_GE_OQ),
+                                           _mm256_cmp_pd(high, max_range, _CMP_LE_OQ))};
+    const __m256d near_low{_mm256_and_pd(valid_low, _mm256_cmp_pd(low, threshold, _CMP_LT_OQ))};
+    const __m256d near_high{
+        _mm256_and_pd(valid_high, _mm256_cmp_pd(high, threshold, _CMP_LT_OQ))};
+
+    LidarSummary summary;
+    const int valid{_mm256_movemask_pd(valid_low) | _mm256_movemask_pd(valid_high) << 4};
+    summary.valid_mask = static_cast<std::uint8_t>(valid);
+    summary.valid_count = __builtin_popcount(static_cast<unsigned>(valid));
+    summary.obstacles = __builtin_popcount(static_cast<unsigned>(
+        _mm256_movemask_pd(near_low) | _mm256_movemask_pd(near_high) << 4));
+
+    // Invalid readings become infinity for the minimum and zero for the sum
+    __m256d minimum{_mm256_min_pd(_mm256_blendv_pd(infinity, low, valid_low),
+                                  _mm256_blendv_pd(infinity, high, valid_high))};
+    __m128d min_pair{_mm_min_pd(_mm256_castpd256_pd128(minimum),
+                                _mm256_extractf128_pd(minimum, 1))};
+    min_pair = _mm_min_sd(min_pair, _mm_unpackhi_pd(min_pair, min_pair));
+    summary.min_distance = _mm_cvtsd_f64(min_pair);
+
+    const __m256d lanes{
+        _mm256_add_pd(_mm256_and_pd(low, valid_low), _mm256_and_pd(high, valid_high))};
+    __m128d sum_pair{
+        _mm_add_pd(_mm256_castpd256_pd128(lanes), _mm256_extractf128_pd(lanes, 1))};
+    sum_pair = _mm_add_sd(sum_pair, _mm_unpackhi_pd(sum_pair, sum_pair));
+    summary.mean_distance =
+        summary.valid_count > 0 ? _mm_cvtsd_f64(sum_pair) / summary.valid_count : 0.0;
+    summaries[scan] = summary;
+  }
+}
+
+#endif
+
+using Kernel = void (*)(const double *, std::size_t, LidarSummary *);
+
+Kernel kernel_function(LidarKernel kernel) {
+  switch (kernel) {
+#ifdef LIDAR_KERNELS_AVX2
+  case LidarKernel::AVX2:
+    return summarize_avx2;
+#endif
+  case LidarKernel::SCALAR:
+    return summarize_scalar;
+  default:
+    return nullptr;
+  }
+}
+
+} // namespace
+
+const char *to_string(LidarKernel kernel) {
+  switch (kernel) {
+  case LidarKernel::AVX2:
+    return "avx2";
+  case LidarKernel::SCALAR:
+  default:
+    return "scalar";
+  }
+}
+
+bool lidar_kernel_supported(LidarKernel kernel) {
+  switch (kernel) {
+  case LidarKernel::SCALAR:
+    return true;
+  case LidarKernel::AVX2:
+#ifdef LIDAR_KERNELS_AVX2
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#else
+    return false;
+#endif
+  default:
+    return false;
+  }
+}
+
+LidarKernel best_lidar_kernel() {
+  static const LidarKernel best{lidar_kernel_supported(LidarKernel::AVX2) ? LidarKernel::AVX2
+                                                                          : LidarKernel::SCALAR};
+  return best;
+}
+
+void summarize_lidar(const double *scans, std::size_t count, LidarSummary *summaries) {
+  static const Kernel kernel{kernel_function(best_lidar_kernel())};
+  kernel(scans, count, summaries);
+}
+
+void summarize_lidar(LidarKernel kernel, const double *scans, std::size_t count,
+                     LidarSummary *summaries) {
+  if (!lidar_kernel_supported(kernel)) {
+    throw std::invalid_argument(std::string{"Lidar kernel not supported by this CPU: "} +
+                                to_string(kernel));
+  }
+  kernel_function(kernel)(scans, count, summaries);
+}
@@ -9,6 +9,10 @@
  * 
  */
 
+#include "lidar_kernels.hpp"
+#include "running_stats.hpp"
+#include "sensor_registry.hpp"
+#include "sensor_store.hpp"
 #include "sensor_types.hpp"
 #include <algorithm>
 #include <iomanip>
@@ -16,25 +20,18 @@
 #include <numeric>
 #include <random>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 int main() {
-  // Storage for all sensor data across timestamps
-  std::vector<TimestampData> sensor_readings;
-
-  // Quality tracking variables
-  const std::unordered_map<std::string, int> initial_counts{{"LIDAR", 0},
-                                                            {"Camera", 0}};
-  std::unordered_map<std::string, int> valid_readings{initial_counts};
-  std::unordered_map<std::string, int> total_readings{initial_counts};
-
-  // Variables for calculating summary statistics
-  double total_lidar_avg_distance{0.0};
-  double total_camera_brightness{0.0};
+  // Summary statistics, updated once per reading: each is available at any
+  // moment without keeping the readings
+  RunningStats lidar_distance_stats;
+  RunningStats camera_brightness_stats;
   int total_obstacles_detected{0};
   int day_mode_count{0};
   int night_mode_count{0};
+  // Valid and total readings of each sensor, indexed by SensorKind
+  QualityCounters quality;
 
   std::cout << "=== ROBOT DUAL-SENSOR SYSTEM ===\n\n";
 
@@ -46,43 +43,95 @@ int main() {
   std::uniform_real_distribution<double> lidar_dist{LIDAR_MIN_RANGE,
                                                     LIDAR_MAX_RANGE};
   std::uniform_int_distribution<int> camera_dist{RGB_MIN, RGB_MAX};
-  // Create a vector to store all sensor readings
-  std::vector<TimestampData> sensor_readings;
-  sensor_readings.reserve(NUM_TIMESTAMPS); // Optional: pre-allocate space
+  // Columnar storage for all sensor readings: one contiguous block of
+  // lidar readings per timestamp, and one array per color channel
+  SensorStore sensor_readings;
+  sensor_readings.reserve(NUM_TIMESTAMPS);
   // Generate and store data for all timestamps
   for (int t = 0; t < NUM_TIMESTAMPS; ++t) {
-    // TODO: Generate LIDAR and Camera data
-    // TODO: Create TimestampData and add to vector
+    const CameraData camera{camera_dist(gen), camera_dist(gen), camera_dist(gen)};
+    // The lidar readings are generated in place, without a temporary vector
+    double *lidar{sensor_readings.append(t, camera)};
+    for (int i = 0; i < LIDAR_READINGS_COUNT; ++i) {
+      lidar[i] = lidar_dist(gen);
+    }
   }
 
   // ========================================================================
   // Step 2: Data Processing Loop
   // ========================================================================
+  // Every lidar scan is validated and summarized in one vectorized pass
+  // over the lidar column (AVX2 when the CPU has it)
+  std::vector<LidarSummary> lidar_summaries(sensor_readings.size());
+  summarize_lidar(sensor_readings.lidar_data(), sensor_readings.size(),
+                  lidar_summaries.data());
+
+  std::size_t index{0};
   for (const auto &data : sensor_readings) {
     std::cout << "Processing Timestamp: " << data.timestamp << '\n';
-    // TODO: Process LIDAR and Camera sensors independently
+    const LidarSummary &lidar{lidar_summaries[index++]};
+    std::cout << std::fixed << std::setprecision(2)
+              << "  LIDAR: average " << lidar.mean_distance << " m, closest "
+              << lidar.min_distance << " m, " << lidar.obstacles
+              << " obstacle(s), " << lidar.valid_count << '/'
+              << LIDAR_READINGS_COUNT << " valid\n";
+    // A scan with no valid reading has no distance, not a distance of 0 m
+    if (lidar.valid_count > 0) {
+      lidar_distance_stats.add(lidar.mean_distance);
+    }
+    total_obstacles_detected += lidar.obstacles;
+    quality.record<SensorKind::LIDAR>(lidar.valid_count == LIDAR_READINGS_COUNT);
+
+    const auto [red, green, blue] = data.camera_readings;
+    const double brightness{(red + green + blue) / 3.0};
+    const bool day{brightness > DAY_NIGHT_THRESHOLD};
+    std::cout << "  Camera: brightness " << brightness << ", "
+              << (day ? "DAY" : "NIGHT") << '\n';
+    camera_brightness_stats.add(brightness);
+    quality.record<SensorKind::CAMERA>(brightness > BRIGHTNESS_THRESHOLD);
+    if (day) {
+      ++day_mode_count;
+    } else {
+      ++night_mode_count;
+    }
   }
 
   // ========================================================================
   // Step 3: Sensor-Specific Processing
   // ========================================================================
-  // TODO: Lidar processing
-  // TODO: Camera processing
+  // Lidar processing: summarize_lidar() in Step 2
+  // Camera processing: brightness and day/night mode in Step 2
 
   // ========================================================================
   // Step 4: Quality Assessment and Status Determination
   // ========================================================================
-  const std::unordered_map<std::string, int> initial_counts{{"LIDAR", 0},
-                                                            {"Camera", 0}};
-  std::unordered_map<std::string, int> valid_readings{initial_counts};
-  std::unordered_map<std::string, int> total_readings{initial_counts};
-
-  // TODO: Track sensor reliability (GOOD, POOR, DAY, NIGHT)
+  // Readings are counted as they are processed in Step 2: a lidar scan is
+  // GOOD when all its readings are valid, a camera frame when it is brighter
+  // than BRIGHTNESS_THRESHOLD; DAY and NIGHT are counted there too
 
   // ========================================================================
   // STEP 5: Calculate summary statistics and display
   // ========================================================================
   std::cout << "=== SUMMARY STATISTICS ===\n";
 
-  // TODO: Calculate and display statistics for each sensor
+  // Nothing is recomputed from the stored readings: the running statistics
+  // already hold every summary
+  if (lidar_distance_stats.count() > 0) {
+    std::cout << "LIDAR: mean distance " << lidar_distance_stats.mean()
+              << " m (std dev " << lidar_distance_stats.stddev() << ", range "
+              << lidar_distance_stats.min() << "-" << lidar_distance_stats.max()
+              << "), ";
+  } else {
+    std::cout << "LIDAR: no valid distance, ";
+  }
+  std::cout << total_obstacles_detected << " obstacle(s)\n";
+  std::cout << "Camera: mean brightness " << camera_brightness_stats.mean()
+            << " (std dev " << camera_brightness_stats.stddev() << ", range "
+            << camera_brightness_stats.min() << "-"
+            << camera_brightness_stats.max() << "), " << day_mode_count
+            << " day / " << night_mode_count << " night\n";
+  for (SensorKind kind : all_sensor_kinds()) {
+    std::cout << to_string(kind) << " reliability: " << quality.valid(kind)
+              << '/' << quality.total(kind) << " readings GOOD\n";
+  }
 }
\ No newline at end of file
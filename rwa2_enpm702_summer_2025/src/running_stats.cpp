@@ -0,0 +1,115 @@
+/**
+ * @file running_stats.cpp
+ * @brief Merging of running statistics and the P² quantile estimator
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "running_stats.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+void RunningStats::merge(const RunningStats &other) {
+  if (other.count_ == 0) {
+    return;
+  }
+  if (count_ == 0) {
+    *this = other;
+    return;
+  }
+  // Chan et al.: combine the means and sums of squares of two partitions
+  const double count{static_cast<double>(count_)};
+  const double other_count{static_cast<double>(other.count_)};
+  const double total{count + other_count};
+  const double delta{other.mean_ - mean_};
+  mean_ += delta * other_count / total;
+  m2_ += other.m2_ + delta * delta * count * other_count / total;
+  count_ += other.count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+StreamingQuantile::StreamingQuantile(double probability) : probability_{probability} {
+  if (!(probability > 0.0 && probability < 1.0)) {
+    throw std::invalid_argument("Quantile probability must be within (0, 1)");
+  }
+  const double p{probability};
+  desired_ = {0.0, 2.0 * p, 4.0 * p, 2.0 + 2.0 * p, 4.0};
+  increments_ = {0.0, p / 2.0, p, (1.0 + p) / 2.0, 1.0};
+  positions_ = {0.0, 1.0, 2.0, 3.0, 4.0};
+}
+
+void StreamingQuantile::add(double value) {
+  // The first five values are the initial markers
+  if (count_ < heights_.size()) {
+    heights_[count_++] = value;
+    if (count_ == heights_.size()) {
+      std::sort(heights_.begin(), heights_.end());
+    }
+    return;
+  }
+  ++count_;
+
+  // Cell k holds the value: heights_[k] <= value < heights_[k + 1]
+  std::size_t cell{0};
+  if (value < heights_[0]) {
+    heights_[0] = value;
+  } else if (value >= heights_[4]) {
+    heights_[4] = value;
+    cell = 3;
+  } else {
+    while (value >= heights_[cell + 1]) {
+      ++cell;
+    }
+  }
+  for (std::size_t i = cell + 1; i < positions_.size(); ++i) {
+    positions_[i] += 1.0;
+  }
+  for (std::size_t i = 0; i < desired_.size(); ++i) {
+    desired_[i] += increments_[i];
+  }
+
+  // Move each middle marker at most one rank towards where it should be
+  for (std::size_t i = 1; i < 4; ++i) {
+    const double offset{desired_[i] - positions_[i]};
+    if ((offset >= 1.0 && positions_[i + 1] - positions_[i] > 1.0) ||
+        (offset <= -1.0 && positions_[i - 1] - positions_[i] < -1.0)) {
+      const double step{offset > 0.0 ? 1.0 : -1.0};
+      const double below{positions_[i] - positions_[i - 1]};
+      const double above{positions_[i + 1] - positions_[i]};
+      const double parabolic{
+          heights_[i] + step / (positions_[i + 1] - positions_[i - 1]) *
+                            ((below + step) * (heights_[i + 1] - heights_[i]) / above +
+                             (above - step) * (heights_[i] - heights_[i - 1]) / below)};
+      if (heights_[i - 1] < parabolic && parabolic < heights_[i + 1]) {
+        heights_[i] = parabolic;
+      } else {
+        // The parabola overshoots a neighbour: interpolate linearly instead
+        const std::size_t neighbour{step > 0.0 ? i + 1 : i - 1};
+        heights_[i] += step * (heights_[neighbour] - heights_[i]) /
+                       (positions_[neighbour] - positions_[i]);
+      }
+      positions_[i] += step;
+    }
+  }
+}
+
+double StreamingQuantile::value() const {
+  if (count_ == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (count_ <= heights_.size()) {
+    // Too few values for the markers to move: the exact quantile
+    std::array<double, 5> sorted{heights_};
+    std::sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(count_));
+    const auto rank{
+        static_cast<std::size_t>(probability_ * static_cast<double>(count_ - 1) + 0.5)};
+    return sorted[rank];
+  }
+  return heights_[2];
+}
@@ -0,0 +1,114 @@
+/**
+ * @file sensor_pipeline.cpp
+ * @brief Producer, processing and statistics threads of SensorPipeline
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "sensor_pipeline.hpp"
+#include "spsc_queue.hpp"
+
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+ProcessedReading process(const SensorReading &reading) {
+  ProcessedReading processed;
+  processed.timestamp = reading.timestamp;
+  processed.captured = reading.captured;
+  summarize_lidar(reading.lidar.data(), 1, &processed.lidar);
+  const auto [red, green, blue] = reading.camera;
+  processed.brightness = (red + green + blue) / 3.0;
+  return processed;
+}
+
+void accumulate(PipelineTotals &totals, const ProcessedReading &processed) {
+  ++totals.readings;
+  if (processed.lidar.valid_count > 0) {
+    totals.lidar_distance.add(processed.lidar.mean_distance);
+  }
+  totals.obstacles += processed.lidar.obstacles;
+  totals.quality.record<SensorKind::LIDAR>(processed.lidar.valid_count == LIDAR_READINGS_COUNT);
+  totals.brightness.add(processed.brightness);
+  totals.quality.record<SensorKind::CAMERA>(processed.brightness > BRIGHTNESS_THRESHOLD);
+  if (processed.brightness > DAY_NIGHT_THRESHOLD) {
+    ++totals.day;
+  } else {
+    ++totals.night;
+  }
+  const double latency{
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - processed.captured)
+          .count()};
+  totals.latency.add(latency);
+  totals.latency_median.add(latency);
+  totals.latency_p99.add(latency);
+}
+
+} // namespace
+
+PipelineTotals SensorPipeline::run(const Source &source, const Sink &sink) const {
+  SpscQueue<SensorReading> raw{capacity_};
+  SpscQueue<ProcessedReading> processed{capacity_};
+  PipelineTotals totals;
+  // Set by the statistics stage when the sink throws, so that the producer
+  // stops early; the other stages still drain their queue and exit
+  std::atomic<bool> failed{false};
+  std::exception_ptr source_error;
+  std::exception_ptr sink_error;
+
+  std::thread producer{[&] {
+    try {
+      SensorReading reading;
+      while (!failed.load(std::memory_order_relaxed) && source(reading)) {
+        reading.captured = std::chrono::steady_clock::now();
+        raw.push(reading);
+      }
+    } catch (...) {
+      source_error = std::current_exception();
+    }
+    raw.close();
+  }};
+
+  std::thread processor{[&] {
+    SensorReading reading;
+    while (raw.pop(reading)) {
+      processed.push(process(reading));
+    }
+    processed.close();
+  }};
+
+  std::thread statistics{[&] {
+    ProcessedReading reading;
+    while (processed.pop(reading)) {
+      if (sink_error) {
+        continue;
+      }
+      accumulate(totals, reading);
+      if (sink) {
+        try {
+          sink(reading, totals);
+        } catch (...) {
+          sink_error = std::current_exception();
+          failed.store(true, std::memory_order_relaxed);
+        }
+      }
+    }
+  }};
+
+  producer.join();
+  processor.join();
+  statistics.join();
+  if (source_error) {
+    std::rethrow_exception(source_error);
+  }
+  if (sink_error) {
+    std::rethrow_exception(sink_error);
+  }
+  return totals;
+}
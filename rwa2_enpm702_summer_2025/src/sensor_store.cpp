@@ -0,0 +1,71 @@
+/**
+ * @file sensor_store.cpp
+ * @brief Implementation of the columnar sensor store
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "sensor_store.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::uint8_t channel(int value) {
+  if (value < RGB_MIN || value > RGB_MAX) {
+    throw std::invalid_argument("Camera channel out of range: " + std::to_string(value));
+  }
+  return static_cast<std::uint8_t>(value);
+}
+
+} // namespace
+
+void SensorStore::reserve(std::size_t count) {
+  lidar_.reserve(count * LIDAR_READINGS_COUNT);
+  red_.reserve(count);
+  green_.reserve(count);
+  blue_.reserve(count);
+  timestamps_.reserve(count);
+}
+
+void SensorStore::push_back(const TimestampData &data) {
+  if (data.lidar_readings.size() != LIDAR_READINGS_COUNT) {
+    throw std::invalid_argument("Expected " + std::to_string(LIDAR_READINGS_COUNT) +
+                                " lidar readings, got " +
+                                std::to_string(data.lidar_readings.size()));
+  }
+  double *block{append(data.timestamp, data.camera_readings)};
+  std::copy(data.lidar_readings.begin(), data.lidar_readings.end(), block);
+}
+
+double *SensorStore::append(int timestamp, const CameraData &camera) {
+  const auto [r, g, b] = camera;
+  // Validate before touching any column, so a failure leaves them aligned
+  const std::uint8_t red{channel(r)};
+  const std::uint8_t green{channel(g)};
+  const std::uint8_t blue{channel(b)};
+  lidar_.resize(lidar_.size() + LIDAR_READINGS_COUNT);
+  red_.push_back(red);
+  green_.push_back(green);
+  blue_.push_back(blue);
+  timestamps_.push_back(timestamp);
+  return lidar_.data() + lidar_.size() - LIDAR_READINGS_COUNT;
+}
+
+void SensorStore::clear() {
+  lidar_.clear();
+  red_.clear();
+  green_.clear();
+  blue_.clear();
+  timestamps_.clear();
+}
+
+std::size_t SensorStore::capacity_bytes() const {
+  return lidar_.capacity() * sizeof(double) + red_.capacity() + green_.capacity() +
+         blue_.capacity() + timestamps_.capacity() * sizeof(int);
+}
@@ -0,0 +1,80 @@
+/**
+ * @file bfs_benchmark.cpp
+ * @brief Cells per second of the scalar and bitboard BFS engines
+ *
+ * Both engines flood the same fully known mazes from the centre cells. Each
+ * size is run on a perfect maze (long corridors, narrow frontier) and on an
+ * open maze where most inner walls were knocked down (short distances, wide
+ * frontier). The distance fields of the two engines are compared.
+ *
+ * @version 1.0
+ * @date 2025-08-13
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/flood_fill.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Time repeated full recomputes with one engine
+ * @return Cells flooded per second
+ */
+double cells_per_second(maze::FloodFill &field, int cells, int repeats) {
+  const auto start{std::chrono::steady_clock::now()};
+  for (int i = 0; i < repeats; ++i) {
+    field.recompute();
+  }
+  const auto stop{std::chrono::steady_clock::now()};
+  const double seconds{std::chrono::duration<double>(stop - start).count()};
+  return static_cast<double>(cells) * repeats / seconds;
+}
+
+} // namespace
+
+int main() {
+  struct Workload {
+    int size;
+    int repeats;
+  };
+  constexpr std::array<Workload, 5> kWorkloads{
+      {{16, 20000}, {32, 5000}, {64, 1000}, {256, 50}, {1024, 3}}};
+
+  std::cout << std::left << std::setw(12) << "size" << std::setw(10) << "maze"
+            << std::right << std::setw(18) << "scalar cells/s" << std::setw(20)
+            << "bitboard cells/s" << std::setw(12) << "identical" << '\n';
+
+  for (const auto &[size, repeats] : kWorkloads) {
+    for (bool open : {false, true}) {
+      maze::MazeMap map{maze::generate_backtracker_maze(size, size, 1)};
+      if (open) {
+        maze::remove_random_walls(map, 0.75, 2);
+      }
+      maze::FloodFill field{map, map.centre_cells()};
+      const std::vector<int> scalar_distances{field.distances()};
+      const double scalar{cells_per_second(field, map.cell_count(), repeats)};
+
+      field.set_engine(maze::BfsEngine::BITBOARD);
+      field.recompute();
+      const bool identical{field.distances() == scalar_distances};
+      const double bitboard{cells_per_second(field, map.cell_count(), repeats)};
+
+      std::cout << std::left << std::setw(12)
+                << (std::to_string(size) + "x" + std::to_string(size))
+                << std::setw(10) << (open ? "open" : "perfect") << std::right
+                << std::setw(18) << std::scientific << std::setprecision(2)
+                << scalar << std::setw(20) << bitboard << std::setw(12)
+                << (identical ? "yes" : "NO") << '\n';
+    }
+  }
+}
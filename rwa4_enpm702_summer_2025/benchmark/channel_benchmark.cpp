@@ -0,0 +1,306 @@
+/**
+ * @file channel_benchmark.cpp
+ * @brief Counts syscalls and round trips per solved maze, with and without
+ * batching of the simulator commands, and with asynchronous wall queries
+ *
+ * std::cout and std::cin are redirected to a loopback simulator that
+ * answers the mms text protocol. Every flush of std::cout stands for one
+ * write() to the simulator pipe and every refill of std::cin for one
+ * blocking read(), i.e. one round trip.
+ *
+ * @version 1.0
+ * @date 2025-08-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_types.hpp"
+#include "maze_solver/simulator_backend.hpp"
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Text front-end of the in-process simulator
+ *
+ * Speaks the mms protocol on behalf of a SimulatorBackend. Commands are only
+ * processed when the solver flushes std::cout, exactly as the real simulator
+ * only sees what reaches the pipe.
+ */
+class LoopbackSimulator {
+public:
+  explicit LoopbackSimulator(maze::SimulatorBackend &simulator)
+      : simulator_{simulator} {}
+
+  std::streambuf *output() { return &output_; }
+  std::streambuf *input() { return &input_; }
+
+  long writes() const { return writes_; }
+  long reads() const { return reads_; }
+  long commands() const { return commands_; }
+
+private:
+  class OutputBuffer : public std::streambuf {
+  public:
+    explicit OutputBuffer(LoopbackSimulator &loopback) : loopback_{loopback} {}
+
+  protected:
+    int_type overflow(int_type ch) override {
+      if (ch != traits_type::eof()) {
+        loopback_.outbox_.push_back(traits_type::to_char_type(ch));
+      }
+      return ch;
+    }
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+      loopback_.outbox_.append(s, static_cast<std::size_t>(n));
+      return n;
+    }
+    int sync() override {
+      loopback_.process_outbox();
+      return 0;
+    }
+
+  private:
+    LoopbackSimulator &loopback_;
+  };
+
+  class InputBuffer : public std::streambuf {
+  public:
+    explicit InputBuffer(LoopbackSimulator &loopback) : loopback_{loopback} {}
+
+  protected:
+    int_type underflow() override {
+      if (loopback_.inbox_.empty()) {
+        throw std::runtime_error{"solver waits for a reply that never comes"};
+      }
+      ++loopback_.reads_;
+      current_.swap(loopback_.inbox_);
+      loopback_.inbox_.clear();
+      setg(current_.data(), current_.data(),
+           current_.data() + current_.size());
+      return traits_type::to_int_type(current_.front());
+    }
+
+  private:
+    LoopbackSimulator &loopback_;
+    std::string current_;
+  };
+
+  void process_outbox() {
+    if (outbox_.empty()) {
+      return;
+    }
+    ++writes_;
+    std::size_t start{0};
+    std::size_t end{0};
+    while ((end = outbox_.find('\n', start)) != std::string::npos) {
+      execute(outbox_.substr(start, end - start));
+      start = end + 1;
+    }
+    outbox_.erase(0, start);
+  }
+
+  void reply(std::string_view text) {
+    inbox_.append(text);
+    inbox_.push_back('\n');
+  }
+
+  void reply_bool(bool value) { reply(value ? "true" : "false"); }
+
+  void execute(const std::string &line) {
+    ++commands_;
+    std::istringstream command{line};
+    std::string name;
+    command >> name;
+    if (name == "mazeWidth") {
+      reply(std::to_string(simulator_.get_maze_width()));
+    } else if (name == "mazeHeight") {
+      reply(std::to_string(simulator_.get_maze_height()));
+    } else if (name == "wallFront") {
+      reply_bool(simulator_.has_wall_front());
+    } else if (name == "wallRight") {
+      reply_bool(simulator_.has_wall_right());
+    } else if (name == "wallLeft") {
+      reply_bool(simulator_.has_wall_left());
+    } else if (name == "moveForward") {
+      int distance{1};
+      if (!(command >> distance)) {
+        distance = 1;
+      }
+      try {
+        simulator_.move_forward(distance);
+        reply("ack");
+      } catch (const std::runtime_error &) {
+        reply("crash");
+      }
+    } else if (name == "turnRight") {
+      simulator_.turn_right();
+      reply("ack");
+    } else if (name == "turnLeft") {
+      simulator_.turn_left();
+      reply("ack");
+    } else if (name == "wasReset") {
+      reply_bool(simulator_.was_reset());
+    } else if (name == "ackReset") {
+      simulator_.ack_reset();
+      reply("ack");
+    }
+    // setWall, clearWall, setColor, setText, clear*: no reply
+  }
+
+  maze::SimulatorBackend &simulator_;
+  OutputBuffer output_{*this};
+  InputBuffer input_{*this};
+  std::string outbox_;
+  std::string inbox_;
+  long writes_{0};
+  long reads_{0};
+  long commands_{0};
+};
+
+/**
+ * @brief How the solver talks to the simulator
+ */
+enum class Mode {
+  FLUSH_PER_COMMAND,  ///< One blocking round trip per query and movement
+  ASYNC_QUERIES,      ///< The three wall queries in flight together
+  BATCHED_PIPELINED,  ///< sense_walls() and deferred movement replies
+};
+
+/**
+ * @brief Left-hand rule solver that maps and colours every visited cell
+ * @param mode How the walls are sensed
+ * @return Number of moves to reach the goal
+ */
+int solve(int size, Mode mode) {
+  const auto is_goal = [size](int v) {
+    return v == size / 2 || v == size / 2 - 1;
+  };
+  int x{0};
+  int y{0};
+  maze::Heading heading{maze::Heading::NORTH};
+  int moves{0};
+  while (!is_goal(x) || !is_goal(y)) {
+    maze::WallReadings walls;
+    if (mode == Mode::BATCHED_PIPELINED) {
+      walls = maze::MazeControlAPI::sense_walls();
+    } else if (mode == Mode::ASYNC_QUERIES) {
+      maze::WallFuture front{maze::MazeControlAPI::has_wall_front_async()};
+      maze::WallFuture left{maze::MazeControlAPI::has_wall_left_async()};
+      maze::WallFuture right{maze::MazeControlAPI::has_wall_right_async()};
+      walls.front = front.get();
+      walls.left = left.get();
+      walls.right = right.get();
+    } else {
+      walls.front = maze::MazeControlAPI::has_wall_front();
+      walls.left = maze::MazeControlAPI::has_wall_left();
+      walls.right = maze::MazeControlAPI::has_wall_right();
+    }
+    const std::array<std::pair<bool, maze::Heading>, 3> seen{
+        {{walls.front, heading},
+         {walls.left, maze::turned_left(heading)},
+         {walls.right, maze::turned_right(heading)}}};
+    for (const auto &[wall, side] : seen) {
+      if (wall) {
+        maze::MazeControlAPI::set_wall(x, y, maze::to_char(side));
+      }
+    }
+    maze::MazeControlAPI::set_color(x, y, 'G');
+
+    if (!walls.left) {
+      maze::MazeControlAPI::turn_left();
+      heading = maze::turned_left(heading);
+    } else if (walls.front && !walls.right) {
+      maze::MazeControlAPI::turn_right();
+      heading = maze::turned_right(heading);
+    } else if (walls.front) {
+      maze::MazeControlAPI::turn_right();
+      maze::MazeControlAPI::turn_right();
+      heading = maze::reversed(heading);
+    }
+    maze::MazeControlAPI::move_forward();
+    x += maze::dx(heading);
+    y += maze::dy(heading);
+    ++moves;
+  }
+  return moves;
+}
+
+struct Result {
+  long moves{0};
+  long commands{0};
+  long writes{0};
+  long reads{0};
+  double seconds{0.0};
+};
+
+Result run(int size, unsigned seed, Mode mode) {
+  maze::SimulatorBackend simulator{maze::generate_backtracker_maze(size, size, seed)};
+  LoopbackSimulator loopback{simulator};
+  std::streambuf *saved_out{std::cout.rdbuf(loopback.output())};
+  std::streambuf *saved_in{std::cin.rdbuf(loopback.input())};
+
+  const auto start{std::chrono::steady_clock::now()};
+  maze::MazeControlAPI::set_batching(mode == Mode::BATCHED_PIPELINED);
+  Result result;
+  result.moves = solve(size, mode);
+  maze::MazeControlAPI::set_batching(false);
+  maze::MazeControlAPI::flush();
+  const auto stop{std::chrono::steady_clock::now()};
+
+  std::cout.rdbuf(saved_out);
+  std::cin.rdbuf(saved_in);
+  result.commands = loopback.commands();
+  result.writes = loopback.writes();
+  result.reads = loopback.reads();
+  result.seconds = std::chrono::duration<double>(stop - start).count();
+  return result;
+}
+
+} // namespace
+
+int main() {
+  constexpr int kMazesPerSize{20};
+  std::cout << std::left << std::setw(8) << "size" << std::setw(22) << "mode"
+            << std::right << std::setw(10) << "moves" << std::setw(12)
+            << "commands" << std::setw(12) << "writes" << std::setw(12)
+            << "reads" << std::setw(12) << "time (us)" << '\n';
+
+  for (int size : {16, 32}) {
+    for (const auto &[mode, name] :
+         {std::pair<Mode, const char *>{Mode::FLUSH_PER_COMMAND, "flush per command"},
+          std::pair<Mode, const char *>{Mode::ASYNC_QUERIES, "async wall queries"},
+          std::pair<Mode, const char *>{Mode::BATCHED_PIPELINED, "batched + pipelined"}}) {
+      Result total;
+      for (int i = 0; i < kMazesPerSize; ++i) {
+        const Result result{run(size, static_cast<unsigned>(i + 1), mode)};
+        total.moves += result.moves;
+        total.commands += result.commands;
+        total.writes += result.writes;
+        total.reads += result.reads;
+        total.seconds += result.seconds;
+      }
+      // Averages per solved maze
+      std::cout << std::left << std::setw(8)
+                << (std::to_string(size) + "x" + std::to_string(size))
+                << std::setw(22) << name
+                << std::right << std::setw(10) << total.moves / kMazesPerSize
+                << std::setw(12) << total.commands / kMazesPerSize
+                << std::setw(12) << total.writes / kMazesPerSize
+                << std::setw(12) << total.reads / kMazesPerSize
+                << std::setw(12) << std::fixed << std::setprecision(1)
+                << total.seconds * 1e6 / kMazesPerSize << '\n';
+    }
+  }
+}
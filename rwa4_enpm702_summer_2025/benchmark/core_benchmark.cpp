@@ -0,0 +1,196 @@
+/**
+ * @file core_benchmark.cpp
+ * @brief Solver cores specialized for 16x16 and 32x32 mazes against the
+ * dynamic MazeMap/FloodFill core
+ *
+ * Two measures per size: full BFS recomputes per second on a fully known
+ * maze, and a complete exploration (sense, record the walls, recompute,
+ * move) in the in-process simulator, run through dispatch_solver_core() so
+ * that each size gets the core the dispatcher picks. 20x20 has no
+ * specialization and shows the fallback. The two kinds of core alternate
+ * over three passes and the fastest pass of each is kept, as a single pass
+ * over 200 mazes varies by 10-20% from run to run.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/simulator_backend.hpp"
+#include "maze_solver/solver_core.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::array<maze::Heading, 4> kSides{maze::Heading::NORTH, maze::Heading::EAST,
+                                              maze::Heading::SOUTH, maze::Heading::WEST};
+
+/**
+ * @brief Copy every wall of a maze into a core
+ */
+template <typename Core>
+void load(Core &core, const maze::MazeMap &truth) {
+  for (int cell = 0; cell < truth.cell_count(); ++cell) {
+    for (maze::Heading side : kSides) {
+      core.set_wall(cell, side, truth.has_wall(cell, side));
+    }
+  }
+}
+
+/**
+ * @brief Time repeated full recomputes
+ * @return Recomputes per second
+ */
+template <typename Core>
+double recomputes_per_second(Core &core, int repeats) {
+  const auto start{clock_type::now()};
+  for (int i = 0; i < repeats; ++i) {
+    core.recompute();
+  }
+  return repeats / std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+template <typename Core>
+std::vector<int> distances(const Core &core, int cells) {
+  std::vector<int> result(static_cast<std::size_t>(cells));
+  for (int cell = 0; cell < cells; ++cell) {
+    result[static_cast<std::size_t>(cell)] = core.distance(cell);
+  }
+  return result;
+}
+
+/**
+ * @brief Explore the current maze with a core until the goal
+ * @return Number of cells moved
+ */
+template <typename Core>
+long explore(Core &core) {
+  using maze::MazeControlAPI;
+  int x{0};
+  int y{0};
+  maze::Heading heading{maze::Heading::NORTH};
+  long moves{0};
+  while (true) {
+    const int cell{core.index(x, y)};
+    const maze::WallReadings walls{MazeControlAPI::sense_walls()};
+    bool changed{false};
+    changed |= core.set_wall(cell, heading, walls.front);
+    changed |= core.set_wall(cell, maze::turned_left(heading), walls.left);
+    changed |= core.set_wall(cell, maze::turned_right(heading), walls.right);
+    if (changed) {
+      core.recompute();
+    }
+    if (core.distance(cell) == 0) {
+      return moves;
+    }
+    const maze::Heading next{core.best_side(cell, heading)};
+    if (next == maze::turned_left(heading)) {
+      MazeControlAPI::turn_left();
+    } else if (next == maze::turned_right(heading)) {
+      MazeControlAPI::turn_right();
+    } else if (next != heading) {
+      MazeControlAPI::turn_right();
+      MazeControlAPI::turn_right();
+    }
+    heading = next;
+    MazeControlAPI::move_forward();
+    x += maze::dx(heading);
+    y += maze::dy(heading);
+    ++moves;
+  }
+}
+
+/**
+ * @brief Time explorations of generated mazes with one kind of core
+ * @param dispatched Use dispatch_solver_core() instead of the dynamic core
+ * @return Total seconds and cells moved
+ */
+std::pair<double, long> explorations(int size, int mazes, bool dispatched) {
+  double seconds{0.0};
+  long moves{0};
+  for (int i = 0; i < mazes; ++i) {
+    maze::MazeControlAPI::set_backend(std::make_unique<maze::SimulatorBackend>(
+        maze::generate_backtracker_maze(size, size, static_cast<unsigned>(i + 1))));
+    const auto start{clock_type::now()};
+    if (dispatched) {
+      moves += maze::dispatch_solver_core(size, size, [](auto &core) { return explore(core); });
+    } else {
+      maze::DynamicSolverCore core{size, size};
+      moves += explore(core);
+    }
+    seconds += std::chrono::duration<double>(clock_type::now() - start).count();
+  }
+  maze::MazeControlAPI::set_backend(nullptr);
+  return {seconds, moves};
+}
+
+template <int Size>
+void report_recompute(int repeats) {
+  const maze::MazeMap truth{maze::generate_backtracker_maze(Size, Size, 1)};
+  maze::FixedSolverCore<Size, Size> fixed;
+  maze::DynamicSolverCore dynamic{Size, Size};
+  load(fixed, truth);
+  load(dynamic, truth);
+  const double fixed_rate{recomputes_per_second(fixed, repeats)};
+  const double dynamic_rate{recomputes_per_second(dynamic, repeats)};
+  const bool identical{distances(fixed, truth.cell_count()) ==
+                       distances(dynamic, truth.cell_count())};
+  std::cout << std::left << std::setw(8) << (std::to_string(Size) + "x" + std::to_string(Size))
+            << std::right << std::setw(18) << std::fixed << std::setprecision(0)
+            << dynamic_rate << std::setw(18) << fixed_rate << std::setw(10)
+            << std::setprecision(2) << fixed_rate / dynamic_rate << 'x' << std::setw(12)
+            << (identical ? "yes" : "NO") << '\n';
+}
+
+} // namespace
+
+int main() {
+  std::cout << "Full BFS recomputes per second\n"
+            << std::left << std::setw(8) << "size" << std::right << std::setw(18)
+            << "dynamic" << std::setw(18) << "fixed" << std::setw(11) << "speedup"
+            << std::setw(12) << "identical" << '\n';
+  report_recompute<16>(200000);
+  report_recompute<32>(50000);
+
+  constexpr int kMazes{200};
+  constexpr int kPasses{3};
+  std::cout << "\nExploration with a recompute per new wall, " << kMazes
+            << " mazes, best of " << kPasses << '\n'
+            << std::left << std::setw(8) << "size" << std::right << std::setw(18)
+            << "dynamic (ms)" << std::setw(18) << "dispatched (ms)" << std::setw(11)
+            << "speedup" << std::setw(12) << "same path" << '\n';
+  for (int size : {16, 20, 32}) {
+    double dynamic_seconds{1e300};
+    double dispatched_seconds{1e300};
+    long dynamic_moves{0};
+    long dispatched_moves{0};
+    for (int pass = 0; pass < kPasses; ++pass) {
+      const auto [dynamic, dynamic_count]{explorations(size, kMazes, false)};
+      const auto [dispatched, dispatched_count]{explorations(size, kMazes, true)};
+      dynamic_seconds = std::min(dynamic_seconds, dynamic);
+      dispatched_seconds = std::min(dispatched_seconds, dispatched);
+      dynamic_moves = dynamic_count;
+      dispatched_moves = dispatched_count;
+    }
+    std::cout << std::left << std::setw(8) << (std::to_string(size) + "x" + std::to_string(size))
+              << std::right << std::fixed << std::setprecision(2) << std::setw(18)
+              << dynamic_seconds * 1e3 << std::setw(18) << dispatched_seconds * 1e3
+              << std::setw(10) << dynamic_seconds / dispatched_seconds << 'x' << std::setw(12)
+              << (dynamic_moves == dispatched_moves ? "yes" : "NO") << '\n';
+  }
+}
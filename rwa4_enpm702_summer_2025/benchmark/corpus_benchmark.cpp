@@ -0,0 +1,131 @@
+/**
+ * @file corpus_benchmark.cpp
+ * @brief Startup cost of a large maze suite: text maze files against a
+ * memory-mapped maze corpus
+ *
+ * Generates a suite of mazes (10000 by default, or the count given as the
+ * first argument), stores it both as one .num file per maze and as a
+ * single .mzc corpus in a temporary directory, then times getting a
+ * SimulatorBackend ready for every maze from each.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/maze_corpus.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/simulator_backend.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Write a maze as a .num text file
+ */
+void write_num(const std::string &path, const maze::MazeMap &map) {
+  std::ofstream out{path};
+  for (int x = 0; x < map.width(); ++x) {
+    for (int y = 0; y < map.height(); ++y) {
+      const int cell{map.index(x, y)};
+      out << x << ' ' << y;
+      for (maze::Heading side : {maze::Heading::NORTH, maze::Heading::EAST,
+                                 maze::Heading::SOUTH, maze::Heading::WEST}) {
+        out << ' ' << (map.has_wall(cell, side) ? 1 : 0);
+      }
+      out << '\n';
+    }
+  }
+}
+
+/**
+ * @brief Check that a simulator runs exactly the walls of a maze
+ */
+bool same_walls(const maze::SimulatorBackend &simulator, const maze::MazeMap &map) {
+  for (int x = 0; x < map.width(); ++x) {
+    for (int y = 0; y < map.height(); ++y) {
+      for (maze::Heading side : {maze::Heading::NORTH, maze::Heading::EAST,
+                                 maze::Heading::SOUTH, maze::Heading::WEST}) {
+        if (simulator.has_wall(x, y, side) != map.has_wall(map.index(x, y), side)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  using clock = std::chrono::steady_clock;
+  const int count{argc > 1 ? std::stoi(argv[1]) : 10000};
+  constexpr int kSize{16};
+
+  const std::filesystem::path directory{std::filesystem::temp_directory_path() /
+                                        "rwa4_corpus_benchmark"};
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  std::vector<maze::MazeMap> mazes;
+  mazes.reserve(static_cast<std::size_t>(count));
+  std::vector<std::string> files;
+  for (int i = 0; i < count; ++i) {
+    mazes.push_back(maze::generate_backtracker_maze(kSize, kSize, static_cast<unsigned>(i + 1)));
+    files.push_back((directory / ("maze" + std::to_string(i) + ".num")).string());
+    write_num(files.back(), mazes.back());
+  }
+  const std::string corpus_path{(directory / "suite.mzc").string()};
+  maze::MazeCorpus::write(corpus_path, mazes);
+
+  // Parse every text file into a simulator
+  long started_text{0};
+  const auto text_start{clock::now()};
+  for (const std::string &file : files) {
+    const auto simulator{maze::SimulatorBackend::load(file)};
+    started_text += simulator->get_maze_width() == kSize;
+  }
+  const double text_seconds{std::chrono::duration<double>(clock::now() - text_start).count()};
+
+  // Map the corpus once and run every maze in place
+  long started_corpus{0};
+  const auto corpus_start{clock::now()};
+  const maze::MazeCorpus corpus{maze::MazeCorpus::open(corpus_path)};
+  for (std::size_t i = 0; i < corpus.size(); ++i) {
+    maze::SimulatorBackend simulator{corpus[i]};
+    started_corpus += simulator.get_maze_width() == kSize;
+  }
+  const double corpus_seconds{std::chrono::duration<double>(clock::now() - corpus_start).count()};
+
+  // Both sources must give the generated mazes back, wall for wall
+  bool identical{started_text == count && started_corpus == count};
+  for (std::size_t i = 0; i < mazes.size() && identical; ++i) {
+    identical = same_walls(maze::SimulatorBackend{corpus[i]}, mazes[i]) &&
+                (i >= 100 || same_walls(*maze::SimulatorBackend::load(files[i]), mazes[i]));
+  }
+
+  std::cout << count << " mazes of " << kSize << 'x' << kSize << '\n'
+            << std::left << std::setw(16) << "source" << std::right << std::setw(14)
+            << "startup (ms)" << std::setw(16) << "per maze (us)" << '\n'
+            << std::fixed << std::setprecision(3);
+  for (const auto &[name, seconds] :
+       {std::pair<const char *, double>{".num files", text_seconds},
+        std::pair<const char *, double>{".mzc corpus", corpus_seconds}}) {
+    std::cout << std::left << std::setw(16) << name << std::right << std::setw(14)
+              << seconds * 1e3 << std::setw(16) << seconds * 1e6 / count << '\n';
+  }
+  std::cout << "identical mazes: " << (identical ? "yes" : "NO") << '\n';
+
+  std::filesystem::remove_all(directory);
+}
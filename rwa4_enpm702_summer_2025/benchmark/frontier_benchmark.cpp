@@ -0,0 +1,138 @@
+/**
+ * @file frontier_benchmark.cpp
+ * @brief BFS frontier on std::queue against the fixed-capacity FrontierQueue
+ *
+ * Each BFS floods a generated maze with loops (a tenth of the inner walls
+ * of a backtracker maze removed) from its centre. The std::queue variants
+ * are built per BFS, as a straightforward BFS would do, once with (x, y)
+ * pairs and once with cell indices; the FrontierQueue is sized when the
+ * maze is created and reused.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/frontier_queue.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::array<maze::Heading, 4> kSides{maze::Heading::NORTH, maze::Heading::EAST,
+                                              maze::Heading::SOUTH, maze::Heading::WEST};
+constexpr int kUnreached{-1};
+
+void bfs_pairs(const maze::MazeMap &map, int start, std::vector<int> &distances) {
+  distances.assign(distances.size(), kUnreached);
+  std::queue<std::pair<int, int>> frontier;
+  distances[static_cast<std::size_t>(start)] = 0;
+  frontier.emplace(map.x_of(start), map.y_of(start));
+  while (!frontier.empty()) {
+    const auto [x, y] = frontier.front();
+    frontier.pop();
+    const int cell{map.index(x, y)};
+    const int next{distances[static_cast<std::size_t>(cell)] + 1};
+    for (maze::Heading side : kSides) {
+      if (map.has_wall(cell, side)) {
+        continue;
+      }
+      const int neighbour{map.neighbour(cell, side)};
+      if (distances[static_cast<std::size_t>(neighbour)] == kUnreached) {
+        distances[static_cast<std::size_t>(neighbour)] = next;
+        frontier.emplace(x + maze::dx(side), y + maze::dy(side));
+      }
+    }
+  }
+}
+
+template <typename Queue>
+void bfs_indices(const maze::MazeMap &map, int start, std::vector<int> &distances,
+                 Queue &frontier) {
+  distances.assign(distances.size(), kUnreached);
+  distances[static_cast<std::size_t>(start)] = 0;
+  frontier.push(start);
+  while (!frontier.empty()) {
+    const int cell{frontier.front()};
+    frontier.pop();
+    const int next{distances[static_cast<std::size_t>(cell)] + 1};
+    for (maze::Heading side : kSides) {
+      if (map.has_wall(cell, side)) {
+        continue;
+      }
+      const int neighbour{map.neighbour(cell, side)};
+      if (distances[static_cast<std::size_t>(neighbour)] == kUnreached) {
+        distances[static_cast<std::size_t>(neighbour)] = next;
+        frontier.push(neighbour);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Time repeated runs of a BFS
+ * @return Nanoseconds per cell
+ */
+template <typename Run>
+double ns_per_cell(Run &&run, int repeats, int cells) {
+  const auto start{clock_type::now()};
+  for (int i = 0; i < repeats; ++i) {
+    run();
+  }
+  const std::chrono::duration<double, std::nano> elapsed{clock_type::now() - start};
+  return elapsed.count() / repeats / cells;
+}
+
+} // namespace
+
+int main() {
+  // About 20 million cells flooded per variant and size
+  constexpr long kCellsPerSize{20'000'000};
+  std::cout << "Nanoseconds per cell flooded\n"
+            << std::left << std::setw(12) << "size" << std::right << std::setw(16)
+            << "queue<pair>" << std::setw(14) << "queue<int>" << std::setw(16)
+            << "FrontierQueue" << std::setw(10) << "speedup" << std::setw(12)
+            << "identical" << '\n';
+  for (int size : {16, 32, 64, 128, 256, 512, 1024}) {
+    maze::MazeMap map{maze::generate_backtracker_maze(size, size, 1)};
+    maze::remove_random_walls(map, 0.1, 1);
+    const int cells{map.cell_count()};
+    const int start{map.index(size / 2, size / 2)};
+    const int repeats{static_cast<int>(kCellsPerSize / cells)};
+    maze::FrontierQueue ring{cells};
+
+    std::vector<int> pairs_result(static_cast<std::size_t>(cells));
+    std::vector<int> indices_result(pairs_result.size());
+    std::vector<int> ring_result(pairs_result.size());
+    const double pairs{
+        ns_per_cell([&] { bfs_pairs(map, start, pairs_result); }, repeats, cells)};
+    const double indices{ns_per_cell(
+        [&] {
+          std::queue<int> frontier;
+          bfs_indices(map, start, indices_result, frontier);
+        },
+        repeats, cells)};
+    const double fixed{
+        ns_per_cell([&] { bfs_indices(map, start, ring_result, ring); }, repeats, cells)};
+    const bool identical{pairs_result == ring_result && indices_result == ring_result};
+
+    std::cout << std::left << std::setw(12)
+              << (std::to_string(size) + "x" + std::to_string(size)) << std::right
+              << std::fixed << std::setprecision(2) << std::setw(16) << pairs
+              << std::setw(14) << indices << std::setw(16) << fixed << std::setw(9)
+              << pairs / fixed << 'x' << std::setw(12) << (identical ? "yes" : "NO")
+              << '\n';
+  }
+}
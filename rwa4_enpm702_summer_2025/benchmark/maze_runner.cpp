@@ -0,0 +1,367 @@
+/**
+ * @file maze_runner.cpp
+ * @brief Run an exploration strategy over many mazes on all cores
+ *
+ * Every maze file (.maz or .num) of a directory, every maze of a corpus
+ * file (.mzc), or a set of generated mazes (backtracker, Kruskal or
+ * braided, see --generator), is solved in its own in-process
+ * SimulatorBackend. The mazes are
+ * spread over a work-stealing thread pool and one line per maze is
+ * reported: cells explored, cells moved, turns, protocol commands and solve
+ * time, as CSV or JSON. The strategy is flood fill unless --strategy picks
+ * another one of StrategyEngine.
+ *
+ * Usage:
+ * @code
+ * rwa4_maze_runner [--threads N] [--format csv|json] [--generate COUNT]
+ *                  [--size N] [--generator NAME] [--strategy NAME]
+ *                  [--write-corpus FILE] [MAZE_DIRECTORY | CORPUS]
+ * @endcode
+ *
+ * With --write-corpus the mazes are stored in a corpus file instead of
+ * being solved.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/exploration_strategy.hpp"
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_corpus.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/simulator_backend.hpp"
+#include "maze_solver/strategy_engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Outcome of one maze
+ */
+struct Result {
+  std::string name;     ///< Maze file name, or seed of a generated maze
+  int width{0};         ///< Maze width in cells
+  int height{0};        ///< Maze height in cells
+  bool solved{false};   ///< Goal reached
+  int explored{0};      ///< Distinct cells visited
+  long steps{0};        ///< Cells moved
+  long turns{0};        ///< Quarter turns made
+  long commands{0};     ///< Protocol commands issued
+  double seconds{0.0};  ///< Wall-clock solve time
+  std::string error;    ///< Why the maze could not be run, if it could not
+};
+
+/**
+ * @brief Thread pool running a fixed set of tasks
+ *
+ * Each worker owns a deque of task indices and takes work from its back.
+ * A worker whose deque is empty steals from the front of the others, so
+ * a worker stuck on a large maze does not hold up the small ones queued
+ * behind it.
+ */
+class WorkStealingPool {
+public:
+  explicit WorkStealingPool(unsigned workers)
+      : queues_(std::max(workers, 1u)) {}
+
+  /**
+   * @brief Run body(i) for every i in [0, tasks) and wait for all of them
+   */
+  void run(std::size_t tasks, const std::function<void(std::size_t)> &body) {
+    for (std::size_t i = 0; i < tasks; ++i) {
+      queues_[i % queues_.size()].tasks.push_back(i);
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(queues_.size());
+    for (std::size_t worker = 0; worker < queues_.size(); ++worker) {
+      threads.emplace_back([this, worker, &body] {
+        while (const std::optional<std::size_t> task{next(worker)}) {
+          body(*task);
+        }
+      });
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+  }
+
+private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::size_t> tasks;
+  };
+
+  /**
+   * @brief Take a task from the worker's own queue, or steal one
+   * @return The task, or nothing once every queue is empty
+   */
+  std::optional<std::size_t> next(std::size_t worker) {
+    {
+      Queue &own{queues_[worker]};
+      std::lock_guard<std::mutex> lock{own.mutex};
+      if (!own.tasks.empty()) {
+        const std::size_t task{own.tasks.back()};
+        own.tasks.pop_back();
+        return task;
+      }
+    }
+    // No task is ever added while running, so one empty sweep means done
+    for (std::size_t offset = 1; offset < queues_.size(); ++offset) {
+      Queue &victim{queues_[(worker + offset) % queues_.size()]};
+      std::lock_guard<std::mutex> lock{victim.mutex};
+      if (!victim.tasks.empty()) {
+        const std::size_t task{victim.tasks.front()};
+        victim.tasks.pop_front();
+        return task;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::vector<Queue> queues_;
+};
+
+/**
+ * @brief Solve one maze on the calling thread and collect its statistics
+ */
+void run_maze(std::unique_ptr<maze::SimulatorBackend> simulator,
+              maze::StrategyKind strategy, Result &result) {
+  using clock = std::chrono::steady_clock;
+  const maze::SimulatorBackend &stats{*simulator};
+  result.width = stats.maze().width();
+  result.height = stats.maze().height();
+  maze::MazeControlAPI::set_backend(std::move(simulator));
+
+  const auto start{clock::now()};
+  maze::StrategyEngine engine{strategy, result.width, result.height};
+  const maze::ExplorationStats exploration{engine.run()};
+  result.seconds = std::chrono::duration<double>(clock::now() - start).count();
+  result.solved = exploration.reached_goal;
+  result.explored = exploration.explored_cells;
+  result.steps = stats.cells_moved();
+  result.turns = stats.turns();
+  result.commands = stats.commands();
+  maze::MazeControlAPI::set_backend(nullptr);
+}
+
+/**
+ * @brief Copy a maze into a map of its own
+ */
+maze::MazeMap to_map(const maze::MazeView &view) {
+  maze::MazeMap map{view.width(), view.height()};
+  for (int i = 0; i < view.cell_count(); ++i) {
+    map.set_cell_walls(i, view.cell(i));
+  }
+  return map;
+}
+
+std::string json_escape(std::string_view text) {
+  std::string escaped;
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+    }
+    escaped += c;
+  }
+  return escaped;
+}
+
+void print_csv(const std::vector<Result> &results) {
+  std::cout << "maze,width,height,solved,explored,steps,turns,commands,seconds,error\n";
+  for (const Result &r : results) {
+    std::cout << r.name << ',' << r.width << ',' << r.height << ','
+              << (r.solved ? 1 : 0) << ',' << r.explored << ',' << r.steps << ',' << r.turns << ','
+              << r.commands << ',' << r.seconds << ',';
+    if (!r.error.empty()) {
+      std::cout << '"' << r.error << '"';
+    }
+    std::cout << '\n';
+  }
+}
+
+void print_json(const std::vector<Result> &results) {
+  std::cout << "[\n";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result &r{results[i]};
+    std::cout << "  {\"maze\": \"" << json_escape(r.name)
+              << "\", \"width\": " << r.width << ", \"height\": " << r.height
+              << ", \"solved\": " << (r.solved ? "true" : "false")
+              << ", \"explored\": " << r.explored
+              << ", \"steps\": " << r.steps << ", \"turns\": " << r.turns
+              << ", \"commands\": " << r.commands
+              << ", \"seconds\": " << r.seconds;
+    if (!r.error.empty()) {
+      std::cout << ", \"error\": \"" << json_escape(r.error) << '"';
+    }
+    std::cout << '}' << (i + 1 < results.size() ? "," : "") << '\n';
+  }
+  std::cout << "]\n";
+}
+
+int usage(const char *program) {
+  std::cerr << "Usage: " << program
+            << " [--threads N] [--format csv|json] [--generate COUNT]"
+               " [--size N] [--generator backtracker|kruskal|braided]"
+               " [--strategy wall-follower|flood-fill|a-star|frontier]"
+               " [--write-corpus FILE] [MAZE_DIRECTORY | CORPUS]\n";
+  return 1;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  unsigned threads{std::max(std::thread::hardware_concurrency(), 1u)};
+  std::string format{"csv"};
+  int generate{64};
+  int size{16};
+  maze::MazeAlgorithm generator{maze::MazeAlgorithm::BACKTRACKER};
+  maze::StrategyKind strategy{maze::StrategyKind::FLOOD_FILL};
+  std::string directory;
+  std::string corpus_output;
+
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg{argv[i]};
+      const bool has_value{i + 1 < argc};
+      if (arg == "--threads" && has_value) {
+        threads = static_cast<unsigned>(std::stoul(argv[++i]));
+      } else if (arg == "--format" && has_value) {
+        format = argv[++i];
+      } else if (arg == "--generate" && has_value) {
+        generate = std::stoi(argv[++i]);
+      } else if (arg == "--size" && has_value) {
+        size = std::stoi(argv[++i]);
+      } else if (arg == "--generator" && has_value) {
+        generator = maze::maze_algorithm_from_string(argv[++i]);
+      } else if (arg == "--strategy" && has_value) {
+        strategy = maze::strategy_from_string(argv[++i]);
+      } else if (arg == "--write-corpus" && has_value) {
+        corpus_output = argv[++i];
+      } else if (!arg.empty() && arg.front() != '-' && directory.empty()) {
+        directory = arg;
+      } else {
+        return usage(argv[0]);
+      }
+    }
+  } catch (const std::exception &) {
+    return usage(argv[0]);
+  }
+  if (format != "csv" && format != "json") {
+    return usage(argv[0]);
+  }
+
+  // A corpus file is mapped once and its mazes are run in place
+  std::optional<maze::MazeCorpus> corpus;
+  if (std::filesystem::path{directory}.extension() == ".mzc") {
+    try {
+      corpus = maze::MazeCorpus::open(directory);
+    } catch (const std::exception &e) {
+      std::cerr << e.what() << '\n';
+      return 1;
+    }
+  }
+
+  // Maze files in name order, so that the report is reproducible
+  std::vector<std::filesystem::path> files;
+  if (!directory.empty() && !corpus) {
+    std::error_code error;
+    for (const auto &entry :
+         std::filesystem::directory_iterator{directory, error}) {
+      const std::filesystem::path extension{entry.path().extension()};
+      if (entry.is_regular_file() && (extension == ".maz" || extension == ".num")) {
+        files.push_back(entry.path());
+      }
+    }
+    if (error) {
+      std::cerr << "Cannot read " << directory << ": " << error.message() << '\n';
+      return 1;
+    }
+    std::sort(files.begin(), files.end());
+  }
+
+  const std::size_t count{corpus                ? corpus->size()
+                          : directory.empty() ? static_cast<std::size_t>(generate)
+                                              : files.size()};
+
+  if (!corpus_output.empty()) {
+    try {
+      std::vector<maze::MazeMap> mazes;
+      mazes.reserve(count);
+      for (std::size_t i = 0; i < count; ++i) {
+        if (corpus) {
+          mazes.push_back(to_map((*corpus)[i]));
+        } else if (directory.empty()) {
+          mazes.push_back(
+              maze::generate_maze(generator, size, size, static_cast<unsigned>(i + 1)));
+        } else {
+          mazes.push_back(
+              to_map(maze::SimulatorBackend::load(files[i].string())->maze()));
+        }
+      }
+      maze::MazeCorpus::write(corpus_output, mazes);
+    } catch (const std::exception &e) {
+      std::cerr << e.what() << '\n';
+      return 1;
+    }
+    std::cerr << count << " mazes written to " << corpus_output << '\n';
+    return 0;
+  }
+
+  std::vector<Result> results(count);
+  const auto start{std::chrono::steady_clock::now()};
+
+  WorkStealingPool pool{threads};
+  pool.run(count, [&](std::size_t i) {
+    Result &result{results[i]};
+    try {
+      if (corpus) {
+        result.name = "corpus-" + std::to_string(i);
+        run_maze(std::make_unique<maze::SimulatorBackend>((*corpus)[i]), strategy, result);
+      } else if (directory.empty()) {
+        const unsigned seed{static_cast<unsigned>(i + 1)};
+        result.name = std::string{maze::to_string(generator)} + "-" + std::to_string(size) +
+                      "-" + std::to_string(seed);
+        run_maze(std::make_unique<maze::SimulatorBackend>(
+                     maze::generate_maze(generator, size, size, seed)),
+                 strategy, result);
+      } else {
+        result.name = files[i].filename().string();
+        run_maze(maze::SimulatorBackend::load(files[i].string()), strategy, result);
+      }
+    } catch (const std::exception &e) {
+      result.error = e.what();
+      maze::MazeControlAPI::set_backend(nullptr);
+    }
+  });
+
+  const double elapsed{
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()};
+  if (format == "json") {
+    print_json(results);
+  } else {
+    print_csv(results);
+  }
+  const long solved{static_cast<long>(std::count_if(
+      results.begin(), results.end(), [](const Result &r) { return r.solved; }))};
+  std::cerr << solved << '/' << count << " mazes solved on " << threads
+            << " threads in " << elapsed << " s\n";
+  return solved == static_cast<long>(count) ? 0 : 2;
+}
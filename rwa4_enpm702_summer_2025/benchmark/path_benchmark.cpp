@@ -0,0 +1,121 @@
+/**
+ * @file path_benchmark.cpp
+ * @brief Speed run with the turn-aware PathPlanner against a cell-by-cell
+ * shortest path
+ *
+ * Both runs go from the start cell to the centre of a fully discovered maze
+ * through the in-process simulator. The baseline follows the flood-fill
+ * distances one move_forward() per cell; the optimizer searches with the
+ * turn cost model and merges straightaways into move_forward(n). Run time
+ * is evaluated with the same CostModel for both, a single-cell command
+ * always paying the cost of a first cell.
+ *
+ * @version 1.0
+ * @date 2025-08-14
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/flood_fill.hpp"
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/path_planner.hpp"
+#include "maze_solver/simulator_backend.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+struct Result {
+  double run_time{0.0};
+  long commands{0};
+  long turns{0};
+};
+
+maze::SimulatorBackend &install_simulator(const maze::MazeMap &maze) {
+  auto simulator{std::make_unique<maze::SimulatorBackend>(maze)};
+  maze::SimulatorBackend &installed{*simulator};
+  maze::MazeControlAPI::set_backend(std::move(simulator));
+  return installed;
+}
+
+// Follow the flood-fill distances one cell at a time
+Result cell_by_cell(const maze::MazeMap &maze, const maze::CostModel &cost) {
+  maze::SimulatorBackend &simulator{install_simulator(maze)};
+  maze::FloodFill field{maze, maze.centre_cells()};
+  maze::Heading heading{maze::Heading::NORTH};
+  Result result;
+  int cell{0};
+  while (field.distance(cell) != 0) {
+    const maze::Heading next{field.best_side(cell, heading)};
+    if (next == maze::turned_left(heading)) {
+      maze::MazeControlAPI::turn_left();
+    } else if (next == maze::turned_right(heading)) {
+      maze::MazeControlAPI::turn_right();
+    } else if (next != heading) {
+      maze::MazeControlAPI::turn_right();
+      maze::MazeControlAPI::turn_right();
+    }
+    heading = next;
+    maze::MazeControlAPI::move_forward();
+    result.run_time += cost.first_cell;
+    cell = maze.neighbour(cell, heading);
+  }
+  result.turns = simulator.turns();
+  result.run_time += static_cast<double>(result.turns) * cost.quarter_turn;
+  result.commands = simulator.commands();
+  return result;
+}
+
+Result optimized(const maze::MazeMap &maze, const maze::CostModel &cost) {
+  maze::SimulatorBackend &simulator{install_simulator(maze)};
+  const maze::PathPlanner planner{cost};
+  const maze::Plan plan{
+      planner.plan(maze, 0, maze::Heading::NORTH, maze.centre_cells())};
+  maze::PathPlanner::execute(plan);
+  if (!simulator.at_goal()) {
+    throw std::runtime_error{"the planned run missed the goal"};
+  }
+  return {plan.cost, simulator.commands(), simulator.turns()};
+}
+
+} // namespace
+
+int main() {
+  constexpr int kMazes{50};
+  const maze::CostModel cost;
+  std::cout << std::left << std::setw(10) << "size" << std::setw(16) << "run"
+            << std::right << std::setw(12) << "run time" << std::setw(12)
+            << "commands" << std::setw(10) << "turns" << '\n';
+
+  for (int size : {16, 32}) {
+    Result totals[2];
+    for (int i = 0; i < kMazes; ++i) {
+      maze::MazeMap maze{
+          maze::generate_backtracker_maze(size, size, static_cast<unsigned>(i + 1))};
+      // Loops give the optimizer a choice between routes
+      maze::remove_random_walls(maze, 0.15, static_cast<unsigned>(i + 1));
+      const Result results[2]{cell_by_cell(maze, cost), optimized(maze, cost)};
+      for (int run = 0; run < 2; ++run) {
+        totals[run].run_time += results[run].run_time;
+        totals[run].commands += results[run].commands;
+        totals[run].turns += results[run].turns;
+      }
+    }
+    for (int run = 0; run < 2; ++run) {
+      // Averages per maze
+      std::cout << std::left << std::setw(10)
+                << (std::to_string(size) + "x" + std::to_string(size))
+                << std::setw(16) << (run == 0 ? "cell by cell" : "turn-aware")
+                << std::right << std::setw(12) << std::fixed
+                << std::setprecision(1) << totals[run].run_time / kMazes
+                << std::setw(12) << totals[run].commands / kMazes
+                << std::setw(10) << totals[run].turns / kMazes << '\n';
+    }
+  }
+}
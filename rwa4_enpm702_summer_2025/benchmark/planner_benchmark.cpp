@@ -0,0 +1,145 @@
+/**
+ * @file planner_benchmark.cpp
+ * @brief Incremental flood-fill repair against a full BFS recompute after
+ * every discovered wall
+ *
+ * A flood-fill solver explores generated mazes through MazeControlAPI, with
+ * the in-process SimulatorBackend installed. Both planners drive the same
+ * robot, so they see the same walls in the same order; the final distance
+ * fields are compared to check that the repair is exact.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/flood_fill.hpp"
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/simulator_backend.hpp"
+
+#include <array>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Result {
+  long moves{0};
+  long cells_updated{0};
+  double planner_seconds{0.0};
+  std::vector<int> distances;
+};
+
+/**
+ * @brief Explore a maze with a flood-fill solver until it reaches the goal
+ * @param incremental Repair the field per wall instead of recomputing it
+ */
+Result explore(const maze::MazeMap &truth, bool incremental) {
+  using clock = std::chrono::steady_clock;
+  using maze::MazeControlAPI;
+  MazeControlAPI::set_backend(std::make_unique<maze::SimulatorBackend>(truth));
+
+  maze::MazeMap known{maze::MazeMap::from_api()};
+  maze::FloodFill field{known, known.centre_cells()};
+  int x{0};
+  int y{0};
+  maze::Heading heading{maze::Heading::NORTH};
+  Result result;
+  clock::duration planning{};
+
+  while (field.distance(known.index(x, y)) != 0) {
+    const int cell{known.index(x, y)};
+    const maze::WallReadings walls{MazeControlAPI::sense_walls()};
+    const std::array<std::pair<maze::Heading, bool>, 3> seen{
+        {{heading, walls.front},
+         {maze::turned_left(heading), walls.left},
+         {maze::turned_right(heading), walls.right}}};
+
+    const auto start{clock::now()};
+    bool changed{false};
+    for (const auto &[side, wall] : seen) {
+      if (known.set_wall(cell, side, wall)) {
+        changed = true;
+        if (incremental) {
+          field.update(cell, side);
+        }
+      }
+    }
+    if (changed && !incremental) {
+      field.recompute();
+    }
+    const maze::Heading next{field.best_side(cell, heading)};
+    planning += clock::now() - start;
+
+    if (next == maze::turned_left(heading)) {
+      MazeControlAPI::turn_left();
+    } else if (next == maze::turned_right(heading)) {
+      MazeControlAPI::turn_right();
+    } else if (next != heading) {
+      MazeControlAPI::turn_right();
+      MazeControlAPI::turn_right();
+    }
+    heading = next;
+    MazeControlAPI::move_forward();
+    x += maze::dx(heading);
+    y += maze::dy(heading);
+    ++result.moves;
+  }
+
+  result.cells_updated = field.cells_updated();
+  result.planner_seconds = std::chrono::duration<double>(planning).count();
+  result.distances = field.distances();
+  return result;
+}
+
+} // namespace
+
+int main() {
+  struct Workload {
+    int size;
+    int mazes;
+  };
+  constexpr std::array<Workload, 3> kWorkloads{{{16, 50}, {32, 20}, {256, 1}}};
+
+  std::cout << std::left << std::setw(10) << "size" << std::setw(14) << "planner"
+            << std::right << std::setw(10) << "moves" << std::setw(18)
+            << "cells updated" << std::setw(16) << "planner (ms)"
+            << std::setw(12) << "identical" << '\n';
+
+  for (const auto &[size, mazes] : kWorkloads) {
+    Result totals[2];
+    bool identical{true};
+    for (int i = 0; i < mazes; ++i) {
+      const maze::MazeMap truth{
+          maze::generate_backtracker_maze(size, size, static_cast<unsigned>(i + 1))};
+      const Result full{explore(truth, false)};
+      const Result incremental{explore(truth, true)};
+      identical = identical && full.distances == incremental.distances;
+      for (const auto &[total, result] :
+           {std::pair<Result &, const Result &>{totals[0], full},
+            std::pair<Result &, const Result &>{totals[1], incremental}}) {
+        total.moves += result.moves;
+        total.cells_updated += result.cells_updated;
+        total.planner_seconds += result.planner_seconds;
+      }
+    }
+    for (int mode = 0; mode < 2; ++mode) {
+      // Averages per explored maze
+      std::cout << std::left << std::setw(10)
+                << (std::to_string(size) + "x" + std::to_string(size))
+                << std::setw(14) << (mode == 0 ? "full BFS" : "incremental")
+                << std::right << std::setw(10) << totals[mode].moves / mazes
+                << std::setw(18) << totals[mode].cells_updated / mazes
+                << std::setw(16) << std::fixed << std::setprecision(3)
+                << totals[mode].planner_seconds * 1e3 / mazes << std::setw(12)
+                << (identical ? "yes" : "NO") << '\n';
+    }
+  }
+}
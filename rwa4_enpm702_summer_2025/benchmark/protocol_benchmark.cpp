@@ -0,0 +1,198 @@
+/**
+ * @file protocol_benchmark.cpp
+ * @brief Commands per second of the maze protocol layer, before and after
+ * the ProtocolWriter/ProtocolReader rewrite
+ *
+ * The "before" path is a copy of the original implementation: one
+ * std::endl flush per command and one std::string per reply. Commands go to
+ * /dev/null, so every flush is a real write() syscall, and replies come from
+ * a prepared in-memory stream.
+ *
+ * @version 1.0
+ * @date 2025-08-10
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/maze_api.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+
+namespace {
+long allocations{0};
+} // namespace
+
+void *operator new(std::size_t size) {
+  ++allocations;
+  if (void *p = std::malloc(size == 0 ? 1 : size)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace legacy {
+
+bool has_wall_front() {
+  std::cout << "wallFront\n";
+  std::string response;
+  std::cin >> response;
+  return response == "true";
+}
+
+bool has_wall_left() {
+  std::cout << "wallLeft\n";
+  std::string response;
+  std::cin >> response;
+  return response == "true";
+}
+
+bool has_wall_right() {
+  std::cout << "wallRight\n";
+  std::string response;
+  std::cin >> response;
+  return response == "true";
+}
+
+void move_forward() {
+  std::cout << "moveForward ";
+  std::cout << std::endl;
+  std::string response;
+  std::cin >> response;
+  if (response != "ack") {
+    std::cerr << response << std::endl;
+    std::abort();
+  }
+}
+
+void set_wall(int x, int y, char direction) {
+  std::cout << "setWall " << x << " " << y << " " << direction << std::endl;
+}
+
+void set_color(int x, int y, char color) {
+  std::cout << "setColor " << x << " " << y << " " << color << std::endl;
+}
+
+void set_text(int x, int y, const std::string &text) {
+  std::cout << "setText " << x << " " << y << " " << text << std::endl;
+}
+
+} // namespace legacy
+
+namespace {
+
+constexpr int kSteps{100000};
+// Three wall queries, three annotations and one move per step
+constexpr int kCommandsPerStep{7};
+
+/**
+ * @brief Forwards output to another buffer and counts the flushes
+ */
+class FlushCounter : public std::streambuf {
+public:
+  explicit FlushCounter(std::streambuf *target) : target_{target} {}
+  long flushes() const { return flushes_; }
+
+protected:
+  int_type overflow(int_type ch) override {
+    return target_->sputc(traits_type::to_char_type(ch));
+  }
+  std::streamsize xsputn(const char *s, std::streamsize n) override {
+    return target_->sputn(s, n);
+  }
+  int sync() override {
+    ++flushes_;
+    return target_->pubsync();
+  }
+
+private:
+  std::streambuf *target_;
+  long flushes_{0};
+};
+
+struct Result {
+  double commands_per_second;
+  double flushes_per_command;
+  double allocations_per_command;
+};
+
+// Replies of the simulator for kSteps steps
+std::string make_replies() {
+  std::string replies;
+  for (int i = 0; i < kSteps; ++i) {
+    replies += (i % 2 ? "true\nfalse\ntrue\nack\n" : "false\ntrue\ntrue\nack\n");
+  }
+  return replies;
+}
+
+template <typename Step> Result measure(Step step) {
+  std::ofstream sink{"/dev/null"};
+  FlushCounter counter{sink.rdbuf()};
+  std::istringstream replies{make_replies()};
+  std::streambuf *saved_out{std::cout.rdbuf(&counter)};
+  std::streambuf *saved_in{std::cin.rdbuf(replies.rdbuf())};
+  const std::string label{"12"};
+
+  const long allocations_before{allocations};
+  const auto start{std::chrono::steady_clock::now()};
+  for (int i = 0; i < kSteps; ++i) {
+    step(i % 16, i / 16 % 16, label);
+  }
+  maze::MazeControlAPI::flush();
+  const auto stop{std::chrono::steady_clock::now()};
+  const long allocated{allocations - allocations_before};
+
+  std::cout.rdbuf(saved_out);
+  std::cin.rdbuf(saved_in);
+  const double seconds{std::chrono::duration<double>(stop - start).count()};
+  const double commands{static_cast<double>(kSteps) * kCommandsPerStep};
+  return {commands / seconds, static_cast<double>(counter.flushes()) / commands,
+          static_cast<double>(allocated) / commands};
+}
+
+void report(const char *label, const Result &result) {
+  std::cout << std::left << std::setw(10) << label << std::right
+            << std::setw(16) << std::fixed << std::setprecision(0)
+            << result.commands_per_second << std::setw(14)
+            << std::setprecision(3) << result.flushes_per_command
+            << std::setw(20) << result.allocations_per_command << '\n';
+}
+
+} // namespace
+
+int main() {
+  const Result before{measure([](int x, int y, const std::string &label) {
+    bool walls{legacy::has_wall_front()};
+    walls = legacy::has_wall_left() || walls;
+    walls = legacy::has_wall_right() || walls;
+    legacy::set_wall(x, y, walls ? 'n' : 's');
+    legacy::set_color(x, y, 'G');
+    legacy::set_text(x, y, label);
+    legacy::move_forward();
+  })};
+
+  const Result after{measure([](int x, int y, const std::string &label) {
+    bool walls{maze::MazeControlAPI::has_wall_front()};
+    walls = maze::MazeControlAPI::has_wall_left() || walls;
+    walls = maze::MazeControlAPI::has_wall_right() || walls;
+    maze::MazeControlAPI::set_wall(x, y, walls ? 'n' : 's');
+    maze::MazeControlAPI::set_color(x, y, 'G');
+    maze::MazeControlAPI::set_text(x, y, label);
+    maze::MazeControlAPI::move_forward();
+  })};
+
+  std::cout << std::left << std::setw(10) << "version" << std::right
+            << std::setw(16) << "commands/s" << std::setw(14) << "flushes/cmd"
+            << std::setw(20) << "allocations/cmd" << '\n';
+  report("before", before);
+  report("after", after);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file replay_benchmark.cpp
+ * @brief Size of replay logs and speed of replaying them
+ *
+ * Each strategy of StrategyEngine explores mazes with loops in the
+ * in-process simulator through a RecordingBackend, then the same solver
+ * re-runs every log on a ReplayBackend. Reported per strategy: records and
+ * bytes of a log, time of the recorded and of the replayed runs (the log
+ * decoded once, then replayed repeatedly), and whether every replay
+ * reproduced the recorded statistics and consumed the whole log.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/exploration_strategy.hpp"
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/recording_backend.hpp"
+#include "maze_solver/replay_backend.hpp"
+#include "maze_solver/replay_log.hpp"
+#include "maze_solver/simulator_backend.hpp"
+#include "maze_solver/strategy_engine.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+bool same_run(const maze::ExplorationStats &a, const maze::ExplorationStats &b) {
+  return a.reached_goal == b.reached_goal && a.explored_cells == b.explored_cells &&
+         a.steps == b.steps && a.turns == b.turns && a.wall_queries == b.wall_queries;
+}
+
+} // namespace
+
+int main() {
+  using maze::MazeControlAPI;
+  constexpr int kMazes{50};
+  constexpr int kSize{32};
+  constexpr int kReplays{20};
+  const std::string path{
+      (std::filesystem::temp_directory_path() / "rwa4_replay_benchmark.log").string()};
+
+  std::cout << kMazes << " mazes of " << kSize << "x" << kSize << " with loops, "
+            << kReplays << " replays of each log\n"
+            << std::left << std::setw(15) << "strategy" << std::right << std::setw(10)
+            << "records" << std::setw(10) << "bytes" << std::setw(12) << "B/record"
+            << std::setw(14) << "record (us)" << std::setw(14) << "replay (us)"
+            << std::setw(12) << "identical" << '\n';
+  for (maze::StrategyKind kind : maze::ALL_STRATEGIES) {
+    long records{0};
+    long bytes{0};
+    double record_seconds{0.0};
+    double replay_seconds{0.0};
+    bool identical{true};
+    for (int i = 0; i < kMazes; ++i) {
+      const unsigned seed{static_cast<unsigned>(i + 1)};
+      maze::MazeMap truth{maze::generate_backtracker_maze(kSize, kSize, seed)};
+      maze::remove_random_walls(truth, 0.1, seed);
+
+      // Record; the log is complete once the recording backend is destroyed
+      auto owned{std::make_unique<maze::RecordingBackend>(
+          std::make_unique<maze::SimulatorBackend>(std::move(truth)), path)};
+      const maze::RecordingBackend &recorder{*owned};
+      MazeControlAPI::set_backend(std::move(owned));
+      auto start{clock_type::now()};
+      const maze::ExplorationStats recorded{maze::StrategyEngine{kind}.run()};
+      record_seconds += std::chrono::duration<double>(clock_type::now() - start).count();
+      MazeControlAPI::flush();
+      records += recorder.records();
+      bytes += recorder.bytes();
+      MazeControlAPI::set_backend(nullptr);
+
+      const std::vector<maze::ReplayRecord> log{maze::ReplayLog::load(path)};
+      for (int replay = 0; replay < kReplays; ++replay) {
+        auto replayer{std::make_unique<maze::ReplayBackend>(log)};
+        const maze::ReplayBackend &state{*replayer};
+        MazeControlAPI::set_backend(std::move(replayer));
+        start = clock_type::now();
+        const maze::ExplorationStats replayed{maze::StrategyEngine{kind}.run()};
+        replay_seconds += std::chrono::duration<double>(clock_type::now() - start).count();
+        identical = identical && same_run(recorded, replayed) && state.finished();
+        MazeControlAPI::set_backend(nullptr);
+      }
+    }
+    std::cout << std::left << std::setw(15) << maze::to_string(kind) << std::right
+              << std::setw(10) << records / kMazes << std::setw(10) << bytes / kMazes
+              << std::setw(12) << std::fixed << std::setprecision(2)
+              << static_cast<double>(bytes) / static_cast<double>(records) << std::setw(14)
+              << std::setprecision(1) << record_seconds * 1e6 / kMazes << std::setw(14)
+              << replay_seconds * 1e6 / (kMazes * kReplays) << std::setw(12)
+              << (identical ? "yes" : "NO") << '\n';
+  }
+  std::remove(path.c_str());
+}
@@ -0,0 +1,153 @@
+/**
+ * @file restart_benchmark.cpp
+ * @brief Second run after a reset, from scratch against from a solver
+ * snapshot
+ *
+ * A flood-fill solver explores generated mazes with loops (a tenth of the
+ * inner walls of a backtracker maze removed) in the in-process simulator
+ * until it reaches the centre, then the simulator is reset. The solver sees
+ * the reset through was_reset()/ack_reset() and runs again, either with an
+ * empty map or with the map and distance field restored from the snapshot
+ * saved to disk at the end of the first run.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/flood_fill.hpp"
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/simulator_backend.hpp"
+#include "maze_solver/solver_snapshot.hpp"
+
+#include <array>
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace {
+
+/**
+ * @brief Drive the robot from the start cell to the goal, exploring
+ * @return Number of cells moved
+ */
+long run_to_goal(maze::MazeMap &known, maze::FloodFill &field) {
+  using maze::MazeControlAPI;
+  int x{0};
+  int y{0};
+  maze::Heading heading{maze::Heading::NORTH};
+  long moves{0};
+  while (true) {
+    const int cell{known.index(x, y)};
+    if (!known.is_explored(cell)) {
+      const maze::WallReadings walls{MazeControlAPI::sense_walls()};
+      const std::array<std::pair<maze::Heading, bool>, 3> seen{
+          {{heading, walls.front},
+           {maze::turned_left(heading), walls.left},
+           {maze::turned_right(heading), walls.right}}};
+      for (const auto &[side, wall] : seen) {
+        if (known.set_wall(cell, side, wall)) {
+          field.update(cell, side);
+        }
+      }
+    }
+    if (field.distance(cell) == 0) {
+      return moves;
+    }
+    const maze::Heading next{field.best_side(cell, heading)};
+    if (next == maze::turned_left(heading)) {
+      MazeControlAPI::turn_left();
+    } else if (next == maze::turned_right(heading)) {
+      MazeControlAPI::turn_right();
+    } else if (next != heading) {
+      MazeControlAPI::turn_right();
+      MazeControlAPI::turn_right();
+    }
+    heading = next;
+    MazeControlAPI::move_forward();
+    x += maze::dx(heading);
+    y += maze::dy(heading);
+    ++moves;
+  }
+}
+
+struct Result {
+  long first_run{0};
+  long second_run{0};
+  long second_commands{0};
+  std::size_t snapshot_bytes{0};
+};
+
+Result run(int size, unsigned seed, bool restore, const std::string &path) {
+  using maze::MazeControlAPI;
+  maze::MazeMap truth{maze::generate_backtracker_maze(size, size, seed)};
+  maze::remove_random_walls(truth, 0.1, seed);
+  auto owned{std::make_unique<maze::SimulatorBackend>(std::move(truth))};
+  maze::SimulatorBackend &simulator{*owned};
+  MazeControlAPI::set_backend(std::move(owned));
+
+  Result result;
+  {
+    maze::MazeMap known{maze::MazeMap::from_api()};
+    maze::FloodFill field{known, known.centre_cells()};
+    result.first_run = run_to_goal(known, field);
+    maze::SolverSnapshot::capture(known, field).save(path);
+    result.snapshot_bytes = std::filesystem::file_size(path);
+  }
+
+  // The reset button is pressed; a new solver state starts the next run
+  simulator.reset();
+  if (MazeControlAPI::was_reset()) {
+    MazeControlAPI::ack_reset();
+  }
+  maze::MazeMap known{maze::MazeMap::from_api()};
+  maze::FloodFill field{known, known.centre_cells()};
+  if (restore) {
+    maze::SolverSnapshot::load(path).restore(known, field);
+  }
+  const long commands_before{simulator.commands()};
+  result.second_run = run_to_goal(known, field);
+  result.second_commands = simulator.commands() - commands_before;
+  MazeControlAPI::set_backend(nullptr);
+  return result;
+}
+
+} // namespace
+
+int main() {
+  constexpr int kMazes{50};
+  const std::string path{
+      (std::filesystem::temp_directory_path() / "rwa4_restart_benchmark.snap").string()};
+  std::cout << std::left << std::setw(8) << "size" << std::setw(14) << "second run"
+            << std::right << std::setw(12) << "first run" << std::setw(13)
+            << "second run" << std::setw(12) << "commands" << std::setw(16)
+            << "snapshot (B)" << '\n';
+  for (int size : {16, 32, 64}) {
+    for (bool restore : {false, true}) {
+      Result total;
+      for (int i = 0; i < kMazes; ++i) {
+        const Result result{run(size, static_cast<unsigned>(i + 1), restore, path)};
+        total.first_run += result.first_run;
+        total.second_run += result.second_run;
+        total.second_commands += result.second_commands;
+        total.snapshot_bytes += result.snapshot_bytes;
+      }
+      // Cells moved per maze, and commands of the second run
+      std::cout << std::left << std::setw(8)
+                << (std::to_string(size) + "x" + std::to_string(size))
+                << std::setw(14) << (restore ? "restored" : "from scratch")
+                << std::right << std::setw(12) << total.first_run / kMazes
+                << std::setw(13) << total.second_run / kMazes << std::setw(12)
+                << total.second_commands / kMazes << std::setw(16)
+                << total.snapshot_bytes / kMazes << '\n';
+    }
+  }
+  std::remove(path.c_str());
+}
@@ -0,0 +1,107 @@
+/**
+ * @file sensing_benchmark.cpp
+ * @brief Wall queries of the demo's left wall follower, straight through
+ * MazeControlAPI against through a SensingCache
+ *
+ * The follower runs in generated mazes in the in-process simulator until
+ * it reaches the centre. Both variants take exactly the same path.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/sensing_cache.hpp"
+#include "maze_solver/simulator_backend.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+struct Result {
+  long commands{0};
+  long queries{0};
+  long cells_moved{0};
+};
+
+/**
+ * @brief Run the left wall follower of the demo until the goal
+ * @param robot Either MazeControlAPI or a SensingCache
+ */
+template <typename Robot>
+void follow_left_wall(Robot &robot, const maze::SimulatorBackend &simulator) {
+  while (!simulator.at_goal()) {
+    if (!robot.has_wall_left()) {
+      robot.turn_left();
+    }
+    while (robot.has_wall_front()) {
+      robot.turn_right();
+    }
+    robot.move_forward();
+  }
+}
+
+/**
+ * @brief MazeControlAPI behind the interface of SensingCache
+ */
+struct DirectApi {
+  bool has_wall_left() { return maze::MazeControlAPI::has_wall_left(); }
+  bool has_wall_front() { return maze::MazeControlAPI::has_wall_front(); }
+  void turn_left() { maze::MazeControlAPI::turn_left(); }
+  void turn_right() { maze::MazeControlAPI::turn_right(); }
+  void move_forward() { maze::MazeControlAPI::move_forward(); }
+};
+
+Result run(int size, unsigned seed, bool cached) {
+  auto owned{std::make_unique<maze::SimulatorBackend>(
+      maze::generate_backtracker_maze(size, size, seed))};
+  const maze::SimulatorBackend &simulator{*owned};
+  maze::MazeControlAPI::set_backend(std::move(owned));
+  if (cached) {
+    maze::SensingCache cache{size, size};
+    follow_left_wall(cache, simulator);
+  } else {
+    DirectApi api;
+    follow_left_wall(api, simulator);
+  }
+  Result result;
+  result.commands = simulator.commands();
+  result.cells_moved = simulator.cells_moved();
+  // Every movement is one command; the rest are wall queries
+  result.queries = simulator.commands() - simulator.cells_moved() - simulator.turns();
+  maze::MazeControlAPI::set_backend(nullptr);
+  return result;
+}
+
+} // namespace
+
+int main() {
+  constexpr int kMazes{50};
+  std::cout << std::left << std::setw(8) << "size" << std::setw(12) << "sensing"
+            << std::right << std::setw(10) << "moves" << std::setw(14)
+            << "wall queries" << std::setw(12) << "commands" << '\n';
+  for (int size : {16, 32, 64}) {
+    for (bool cached : {false, true}) {
+      Result total;
+      for (int i = 0; i < kMazes; ++i) {
+        const Result result{run(size, static_cast<unsigned>(i + 1), cached)};
+        total.commands += result.commands;
+        total.queries += result.queries;
+        total.cells_moved += result.cells_moved;
+      }
+      // Averages per maze
+      std::cout << std::left << std::setw(8)
+                << (std::to_string(size) + "x" + std::to_string(size))
+                << std::setw(12) << (cached ? "cached" : "direct") << std::right
+                << std::setw(10) << total.cells_moved / kMazes << std::setw(14)
+                << total.queries / kMazes << std::setw(12)
+                << total.commands / kMazes << '\n';
+    }
+  }
+}
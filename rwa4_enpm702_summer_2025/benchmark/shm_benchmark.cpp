@@ -0,0 +1,290 @@
+/**
+ * @file shm_benchmark.cpp
+ * @brief Command latency over pipes with the mms text protocol against the
+ * shared-memory channel
+ *
+ * A simulator process is forked for every run and drives a SimulatorBackend,
+ * either behind the text protocol on a pair of pipes, as mms does, or behind
+ * a SharedMemoryServer. The solver process measures the round trip of a
+ * single wall query, then explores a generated maze with the flood-fill
+ * strategy, against the same maze driven in-process as the baseline.
+ *
+ * With a single CPU both processes share it and every round trip is two
+ * context switches whatever the transport; the spin phase of the channel is
+ * disabled then, and the difference left is the formatting, parsing and
+ * system calls of the text protocol.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/exploration_strategy.hpp"
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/shm_backend.hpp"
+#include "maze_solver/simulator_backend.hpp"
+#include "maze_solver/stdio_backend.hpp"
+#include "maze_solver/strategy_engine.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <thread>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+/**
+ * @brief Stream buffer over a pipe end, flushed on demand
+ */
+class FdBuffer : public std::streambuf {
+public:
+  explicit FdBuffer(int fd) : fd_{fd} {
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+  }
+
+protected:
+  int_type overflow(int_type ch) override {
+    if (sync() != 0) {
+      return traits_type::eof();
+    }
+    if (ch != traits_type::eof()) {
+      *pptr() = traits_type::to_char_type(ch);
+      pbump(1);
+    }
+    return traits_type::not_eof(ch);
+  }
+
+  int sync() override {
+    const char *data{pbase()};
+    while (data < pptr()) {
+      const ssize_t written{::write(fd_, data, static_cast<std::size_t>(pptr() - data))};
+      if (written <= 0) {
+        return -1;
+      }
+      data += written;
+    }
+    setp(buffer_.data(), buffer_.data() + buffer_.size());
+    return 0;
+  }
+
+  int_type underflow() override {
+    const ssize_t got{::read(fd_, buffer_.data(), buffer_.size())};
+    if (got <= 0) {
+      return traits_type::eof();
+    }
+    setg(buffer_.data(), buffer_.data(), buffer_.data() + got);
+    return traits_type::to_int_type(buffer_[0]);
+  }
+
+private:
+  int fd_;
+  std::array<char, 4096> buffer_{};
+};
+
+/**
+ * @brief Answer the mms text protocol on a SimulatorBackend until EOF
+ */
+void serve_text(int in, int out, maze::SimulatorBackend &simulator) {
+  FdBuffer in_buffer{in};
+  FdBuffer out_buffer{out};
+  std::istream commands{&in_buffer};
+  std::ostream replies{&out_buffer};
+  std::string line;
+  while (std::getline(commands, line)) {
+    std::istringstream words{line};
+    std::string command;
+    words >> command;
+    if (command == "mazeWidth") {
+      replies << simulator.get_maze_width() << '\n';
+    } else if (command == "mazeHeight") {
+      replies << simulator.get_maze_height() << '\n';
+    } else if (command == "wallFront") {
+      replies << (simulator.has_wall_front() ? "true" : "false") << '\n';
+    } else if (command == "wallRight") {
+      replies << (simulator.has_wall_right() ? "true" : "false") << '\n';
+    } else if (command == "wallLeft") {
+      replies << (simulator.has_wall_left() ? "true" : "false") << '\n';
+    } else if (command == "moveForward") {
+      int distance{1};
+      words >> distance;
+      simulator.move_forward(distance);
+      replies << "ack\n";
+    } else if (command == "turnRight") {
+      simulator.turn_right();
+      replies << "ack\n";
+    } else if (command == "turnLeft") {
+      simulator.turn_left();
+      replies << "ack\n";
+    } else if (command == "wasReset") {
+      replies << (simulator.was_reset() ? "true" : "false") << '\n';
+    } else if (command == "ackReset") {
+      simulator.ack_reset();
+      replies << "ack\n";
+    }
+    // Display commands have no reply; flush when the solver waits on one
+    if (commands.rdbuf()->in_avail() == 0) {
+      replies.flush();
+    }
+  }
+}
+
+enum class Transport { IN_PROCESS, PIPE, SHARED_MEMORY };
+
+/**
+ * @brief A simulator process for one run
+ */
+class SimulatorProcess {
+public:
+  SimulatorProcess(Transport transport, const maze::MazeMap &truth) : transport_{transport} {
+    if (transport_ == Transport::IN_PROCESS) {
+      maze::MazeControlAPI::set_backend(std::make_unique<maze::SimulatorBackend>(truth));
+      return;
+    }
+    std::array<int, 2> to_simulator{};
+    std::array<int, 2> from_simulator{};
+    if (pipe(to_simulator.data()) != 0 || pipe(from_simulator.data()) != 0) {
+      throw std::runtime_error("Cannot create pipes");
+    }
+    const std::string name{"rwa4_shm_benchmark_" + std::to_string(getpid())};
+    pid_ = fork();
+    if (pid_ < 0) {
+      throw std::runtime_error("Cannot fork");
+    }
+    if (pid_ == 0) {
+      ::close(to_simulator[1]);
+      ::close(from_simulator[0]);
+      maze::SimulatorBackend simulator{truth};
+      if (transport_ == Transport::PIPE) {
+        serve_text(to_simulator[0], from_simulator[1], simulator);
+      } else {
+        maze::SharedMemoryServer server{name};
+        // The pipe only tells the solver the channel exists
+        const char ready{'r'};
+        if (::write(from_simulator[1], &ready, 1) != 1) {
+          std::_Exit(1);
+        }
+        server.serve(simulator);
+      }
+      std::_Exit(0);
+    }
+    ::close(to_simulator[0]);
+    ::close(from_simulator[1]);
+    to_fd_ = to_simulator[1];
+    from_fd_ = from_simulator[0];
+    if (transport_ == Transport::PIPE) {
+      out_buffer_ = std::make_unique<FdBuffer>(to_fd_);
+      in_buffer_ = std::make_unique<FdBuffer>(from_fd_);
+      out_ = std::make_unique<std::ostream>(out_buffer_.get());
+      in_ = std::make_unique<std::istream>(in_buffer_.get());
+      maze::MazeControlAPI::set_backend(std::make_unique<maze::StdioBackend>(*out_, *in_));
+    } else {
+      char ready{0};
+      if (::read(from_fd_, &ready, 1) != 1) {
+        throw std::runtime_error("Simulator did not start");
+      }
+      maze::MazeControlAPI::set_backend(std::make_unique<maze::SharedMemoryBackend>(name));
+    }
+  }
+
+  SimulatorProcess(const SimulatorProcess &) = delete;
+  SimulatorProcess &operator=(const SimulatorProcess &) = delete;
+
+  ~SimulatorProcess() {
+    // Detaching the backend closes the channel or flushes the pipe
+    maze::MazeControlAPI::set_backend(nullptr);
+    if (pid_ > 0) {
+      ::close(to_fd_);
+      ::close(from_fd_);
+      waitpid(pid_, nullptr, 0);
+    }
+  }
+
+private:
+  Transport transport_;
+  pid_t pid_{-1};
+  int to_fd_{-1};
+  int from_fd_{-1};
+  std::unique_ptr<FdBuffer> out_buffer_;
+  std::unique_ptr<FdBuffer> in_buffer_;
+  std::unique_ptr<std::ostream> out_;
+  std::unique_ptr<std::istream> in_;
+};
+
+/// Mean round trip of a wall query, in nanoseconds
+double query_latency(Transport transport, const maze::MazeMap &truth, int queries) {
+  SimulatorProcess simulator{transport, truth};
+  // Warm up both processes before timing
+  for (int i = 0; i < 1000; ++i) {
+    maze::MazeControlAPI::has_wall_front();
+  }
+  const auto start{std::chrono::steady_clock::now()};
+  for (int i = 0; i < queries; ++i) {
+    maze::MazeControlAPI::has_wall_front();
+  }
+  const std::chrono::duration<double, std::nano> elapsed{std::chrono::steady_clock::now() - start};
+  return elapsed.count() / queries;
+}
+
+/// Seconds taken to explore the maze to its centre, and its round trips
+double exploration_time(Transport transport, const maze::MazeMap &truth, long &trips) {
+  SimulatorProcess simulator{transport, truth};
+  maze::StrategyEngine engine{maze::StrategyKind::FLOOD_FILL};
+  const maze::ExplorationStats stats{engine.run()};
+  if (!stats.reached_goal) {
+    throw std::runtime_error("Exploration did not reach the goal");
+  }
+  trips = stats.wall_queries + stats.steps + stats.turns;
+  return stats.seconds;
+}
+
+const char *to_string(Transport transport) {
+  switch (transport) {
+  case Transport::IN_PROCESS:
+    return "in-process";
+  case Transport::PIPE:
+    return "pipe (text)";
+  case Transport::SHARED_MEMORY:
+  default:
+    return "shared memory";
+  }
+}
+
+} // namespace
+
+int main() {
+  constexpr int kQueries{20000};
+  constexpr int kSize{32};
+  maze::MazeMap truth{maze::generate_backtracker_maze(kSize, kSize, 1)};
+  maze::remove_random_walls(truth, 0.1, 1);
+
+  std::cout << "CPUs: " << std::thread::hardware_concurrency() << "\n"
+            << std::left << std::setw(16) << "transport" << std::right << std::setw(16)
+            << "query (ns)" << std::setw(16) << "explore (ms)" << std::setw(16)
+            << "per trip (ns)" << '\n';
+  for (Transport transport :
+       {Transport::IN_PROCESS, Transport::PIPE, Transport::SHARED_MEMORY}) {
+    const double latency{query_latency(transport, truth, kQueries)};
+    long trips{0};
+    const double seconds{exploration_time(transport, truth, trips)};
+    std::cout << std::left << std::setw(16) << to_string(transport) << std::right
+              << std::fixed << std::setprecision(1) << std::setw(16) << latency
+              << std::setw(16) << seconds * 1e3 << std::setw(16)
+              << seconds * 1e9 / static_cast<double>(trips) << '\n';
+  }
+}
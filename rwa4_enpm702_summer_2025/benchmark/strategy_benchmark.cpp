@@ -0,0 +1,68 @@
+/**
+ * @file strategy_benchmark.cpp
+ * @brief Exploration strategies compared on generated mazes
+ *
+ * Every strategy of StrategyEngine explores the same perfect (backtracker)
+ * mazes and mazes with loops (a tenth of the inner walls removed) in the
+ * in-process simulator. Averages per maze are reported: cells visited,
+ * cells moved, quarter turns and solve time, and the number of mazes whose
+ * goal was reached.
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/exploration_strategy.hpp"
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/simulator_backend.hpp"
+#include "maze_solver/strategy_engine.hpp"
+
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+int main() {
+  constexpr int kMazes{100};
+  std::cout << std::left << std::setw(8) << "size" << std::setw(10) << "maze"
+            << std::setw(15) << "strategy" << std::right << std::setw(8) << "solved"
+            << std::setw(10) << "explored" << std::setw(8) << "steps" << std::setw(8)
+            << "turns" << std::setw(10) << "ms" << '\n';
+  for (int size : {16, 32}) {
+    for (bool loops : {false, true}) {
+      for (maze::StrategyKind kind : maze::ALL_STRATEGIES) {
+        int solved{0};
+        maze::ExplorationStats total;
+        for (int i = 0; i < kMazes; ++i) {
+          const unsigned seed{static_cast<unsigned>(i + 1)};
+          maze::MazeMap truth{maze::generate_backtracker_maze(size, size, seed)};
+          if (loops) {
+            maze::remove_random_walls(truth, 0.1, seed);
+          }
+          maze::MazeControlAPI::set_backend(
+              std::make_unique<maze::SimulatorBackend>(std::move(truth)));
+          maze::StrategyEngine engine{kind};
+          const maze::ExplorationStats stats{engine.run()};
+          solved += stats.reached_goal ? 1 : 0;
+          total.explored_cells += stats.explored_cells;
+          total.steps += stats.steps;
+          total.turns += stats.turns;
+          total.seconds += stats.seconds;
+        }
+        maze::MazeControlAPI::set_backend(nullptr);
+        std::cout << std::left << std::setw(8)
+                  << (std::to_string(size) + "x" + std::to_string(size)) << std::setw(10)
+                  << (loops ? "loops" : "perfect") << std::setw(15)
+                  << maze::to_string(kind) << std::right << std::setw(8) << solved
+                  << std::setw(10) << total.explored_cells / kMazes << std::setw(8)
+                  << total.steps / kMazes << std::setw(8) << total.turns / kMazes
+                  << std::setw(10) << std::fixed << std::setprecision(3)
+                  << total.seconds * 1e3 / kMazes << '\n';
+      }
+    }
+  }
+}
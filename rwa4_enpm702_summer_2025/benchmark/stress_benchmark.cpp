@@ -0,0 +1,213 @@
+/**
+ * @file stress_benchmark.cpp
+ * @brief Scaling of the solver with the maze size, from 64x64 up to
+ * 1024x1024
+ *
+ * For each generation algorithm and size, a generated maze is explored by
+ * the flood-fill StrategyEngine in the in-process simulator, then
+ * PathPlanner plans the speed run on the explored map. Reported per run:
+ * cells moved, exploration and planning time per cell, and the peak heap
+ * memory of the solver, measured by counting allocations.
+ *
+ * The growth exponent k of time ~ cells^k is fitted over the sizes of each
+ * algorithm. The planner is a Dijkstra over a constant number of states
+ * per cell: n log n, plus cache misses once its states outgrow the cache,
+ * fits an exponent of 1.1 to 1.3, while a quadratic regression fits 2. An
+ * exponent above --max-exponent (1.5 by default) is flagged as a
+ * super-linear regression and makes the program exit with status 2. Exploration is reported but
+ * not flagged: the number of moves depends on the maze, and on perfect
+ * mazes a new wall can send the incremental repair through a large part
+ * of the optimistic map, so it grows faster than linearly by nature.
+ *
+ * Sizes double from 64x64 up to --max-size, 256 by default: exploring a
+ * single 1024x1024 perfect maze takes tens of minutes.
+ *
+ * Usage:
+ * @code
+ * rwa4_stress_benchmark [--max-size N] [--max-exponent K] [--seed S]
+ * @endcode
+ *
+ * @version 1.0
+ * @date 2025-08-12
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+#include "maze_solver/exploration_strategy.hpp"
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_generator.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/path_planner.hpp"
+#include "maze_solver/simulator_backend.hpp"
+#include "maze_solver/strategy_engine.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Heap accounting: every block carries its size in a header
+constexpr std::size_t kHeader{alignof(std::max_align_t)};
+std::size_t g_live_bytes{0};
+std::size_t g_peak_bytes{0};
+
+/**
+ * @brief Peak heap growth over a scope
+ */
+class HeapWatermark {
+public:
+  HeapWatermark() : base_{g_live_bytes} { g_peak_bytes = g_live_bytes; }
+  [[nodiscard]] std::size_t peak() const { return g_peak_bytes - base_; }
+
+private:
+  std::size_t base_;
+};
+
+/**
+ * @brief Least-squares slope of log(y) against log(x)
+ */
+double growth_exponent(const std::vector<double> &x, const std::vector<double> &y) {
+  double mean_x{0.0};
+  double mean_y{0.0};
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    mean_x += std::log(x[i]) / static_cast<double>(x.size());
+    mean_y += std::log(y[i]) / static_cast<double>(y.size());
+  }
+  double covariance{0.0};
+  double variance{0.0};
+  for (std::size_t i = 0; i < x.size(); ++i) {
+    covariance += (std::log(x[i]) - mean_x) * (std::log(y[i]) - mean_y);
+    variance += (std::log(x[i]) - mean_x) * (std::log(x[i]) - mean_x);
+  }
+  return covariance / variance;
+}
+
+int usage(const char *program) {
+  std::cerr << "Usage: " << program << " [--max-size N] [--max-exponent K] [--seed S]\n";
+  return 1;
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+  auto *block{static_cast<char *>(std::malloc(size + kHeader))};
+  if (block == nullptr) {
+    throw std::bad_alloc{};
+  }
+  *reinterpret_cast<std::size_t *>(block) = size;
+  g_live_bytes += size;
+  if (g_live_bytes > g_peak_bytes) {
+    g_peak_bytes = g_live_bytes;
+  }
+  return block + kHeader;
+}
+
+void operator delete(void *pointer) noexcept {
+  if (pointer == nullptr) {
+    return;
+  }
+  char *block{static_cast<char *>(pointer) - kHeader};
+  g_live_bytes -= *reinterpret_cast<std::size_t *>(block);
+  std::free(block);
+}
+
+void operator delete(void *pointer, std::size_t /*size*/) noexcept { operator delete(pointer); }
+
+int main(int argc, char *argv[]) {
+  using clock = std::chrono::steady_clock;
+  using maze::MazeControlAPI;
+  int max_size{256};
+  double max_exponent{1.5};
+  unsigned seed{1};
+  try {
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg{argv[i]};
+      if (arg == "--max-size" && i + 1 < argc) {
+        max_size = std::stoi(argv[++i]);
+      } else if (arg == "--max-exponent" && i + 1 < argc) {
+        max_exponent = std::stod(argv[++i]);
+      } else if (arg == "--seed" && i + 1 < argc) {
+        seed = static_cast<unsigned>(std::stoul(argv[++i]));
+      } else {
+        return usage(argv[0]);
+      }
+    }
+  } catch (const std::exception &) {
+    return usage(argv[0]);
+  }
+
+  constexpr int kPlanRepeats{3};
+  bool regression{false};
+  std::cout << std::left << std::setw(13) << "generator" << std::setw(11) << "size"
+            << std::right << std::setw(10) << "moves" << std::setw(16)
+            << "explore ns/cell" << std::setw(14) << "plan ns/cell" << std::setw(12)
+            << "heap B/cell" << '\n';
+  for (maze::MazeAlgorithm algorithm : maze::ALL_MAZE_ALGORITHMS) {
+    std::vector<double> cells;
+    std::vector<double> explore_seconds;
+    std::vector<double> plan_seconds;
+    for (int size = 64; size <= max_size; size *= 2) {
+      MazeControlAPI::set_backend(std::make_unique<maze::SimulatorBackend>(
+          maze::generate_maze(algorithm, size, size, seed)));
+      const double count{static_cast<double>(size) * size};
+
+      const HeapWatermark heap;
+      maze::StrategyEngine engine{maze::StrategyKind::FLOOD_FILL};
+      auto start{clock::now()};
+      const maze::ExplorationStats stats{engine.run()};
+      const double explore{std::chrono::duration<double>(clock::now() - start).count()};
+      // Best of a few plans, the planner being fast enough to be noisy
+      maze::Plan plan;
+      double planning{0.0};
+      for (int repeat = 0; repeat < kPlanRepeats; ++repeat) {
+        start = clock::now();
+        plan = maze::PathPlanner{}.plan(engine.map(), 0, maze::Heading::NORTH,
+                                        engine.map().centre_cells(), false);
+        const double seconds{std::chrono::duration<double>(clock::now() - start).count()};
+        planning = repeat == 0 ? seconds : std::min(planning, seconds);
+      }
+      const std::size_t peak{heap.peak()};
+      MazeControlAPI::set_backend(nullptr);
+      if (!stats.reached_goal || !plan.found) {
+        std::cerr << maze::to_string(algorithm) << ' ' << size << 'x' << size
+                  << ": goal not reached\n";
+        return 1;
+      }
+
+      cells.push_back(count);
+      explore_seconds.push_back(explore);
+      plan_seconds.push_back(planning);
+      std::cout << std::left << std::setw(13) << maze::to_string(algorithm) << std::setw(11)
+                << (std::to_string(size) + "x" + std::to_string(size)) << std::right
+                << std::setw(10) << stats.steps << std::fixed << std::setprecision(1)
+                << std::setw(16) << explore * 1e9 / count << std::setw(14)
+                << planning * 1e9 / count << std::setw(12)
+                << static_cast<double>(peak) / count << std::endl;
+    }
+    if (cells.size() < 2) {
+      continue;
+    }
+    const double explore_exponent{growth_exponent(cells, explore_seconds)};
+    const double plan_exponent{growth_exponent(cells, plan_seconds)};
+    std::cout << std::left << std::setw(13) << maze::to_string(algorithm) << std::setw(11)
+              << "exponent" << std::right << std::setw(10) << "" << std::setprecision(2)
+              << std::setw(16) << explore_exponent << std::setw(14) << plan_exponent;
+    if (plan_exponent > max_exponent) {
+      std::cout << "  SUPER-LINEAR planner";
+      regression = true;
+    }
+    std::cout << "\n\n";
+  }
+  return regression ? 2 : 0;
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "maze_solver/maze_map.hpp"
+
+namespace maze {
+
+/**
+ * @brief Bit-parallel BFS over a MazeMap
+ *
+ * Each row of the maze is a bitboard of 64-bit words, one bit per cell. For
+ * every side, a bitboard marks the cells that can be left through that side.
+ * One BFS level expands the whole frontier at once: the frontier is masked
+ * with the "open" bitboard of a side and shifted by one bit (east/west) or
+ * one row (north/south), and the union of the four results minus the
+ * visited cells is the next frontier. Only the rows next to a row holding
+ * part of the frontier are touched at each level.
+ *
+ * Both engines give identical distance fields, but this one is not faster:
+ * flooding from the centre, the frontier is a thin ring holding only a few
+ * bits of each word it touches, so every level still walks most of the
+ * rows between the lowest and highest frontier row. rwa4_bfs_benchmark
+ * measures it at 0.05x to 0.8x the scalar BFS, 2.2e7 against 4.5e7 cells/s
+ * on a 1024x1024 open maze; the scalar engine stays the default.
+ */
+class BitboardBfs {
+public:
+  /**
+   * @brief Compute the distance of every cell to the nearest goal
+   *
+   * Unknown walls are treated as openings, as in FloodFill.
+   * @param map Map to flood
+   * @param goals Indices of the goal cells
+   * @param[out] distances Distance of each cell, resized to the map;
+   * unreachable cells get @p unreachable
+   * @param unreachable Value written for cells no goal can be reached from
+   */
+  void compute(const MazeMap &map, const std::vector<int> &goals,
+               std::vector<int> &distances, int unreachable);
+
+private:
+  /**
+   * @brief Rebuild the "open" bitboards from the wall bits of the map,
+   * eight cells per 64-bit load
+   */
+  void load_walls(const MazeMap &map);
+
+  int width_{0};          ///< Width of the maze in cells
+  int height_{0};         ///< Height of the maze in cells
+  int words_per_row_{0};  ///< 64-bit words per bitboard row
+  /// Cells that can be left through each side, in wall_bit() order
+  std::array<std::vector<std::uint64_t>, 4> open_;
+  std::vector<std::uint64_t> visited_;  ///< Cells already reached
+  std::vector<std::uint64_t> frontier_; ///< Cells reached at the last level
+  std::vector<std::uint64_t> next_;     ///< Cells reached at this level
+  std::vector<std::uint8_t> active_rows_; ///< Rows holding frontier cells
+  std::vector<std::uint8_t> next_active_; ///< Rows holding next cells
+}; // class BitboardBfs
+
+} // namespace maze
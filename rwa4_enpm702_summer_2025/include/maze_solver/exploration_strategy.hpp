@@ -0,0 +1,108 @@
+#pragma once
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_types.hpp"
+
+namespace maze {
+
+class FloodFill;
+
+/**
+ * @brief Exploration strategies available to StrategyEngine
+ */
+enum class StrategyKind {
+  WALL_FOLLOWER, ///< Keep the left hand on the wall
+  FLOOD_FILL,    ///< Move to the neighbour closest to the goal (FloodFill)
+  A_STAR,        ///< Follow an A* path to the goal, replanned when blocked
+  FRONTIER       ///< Visit unexplored cells closest to the shortest path
+};
+
+/// Every strategy, in declaration order
+inline constexpr StrategyKind ALL_STRATEGIES[]{StrategyKind::WALL_FOLLOWER,
+                                               StrategyKind::FLOOD_FILL,
+                                               StrategyKind::A_STAR,
+                                               StrategyKind::FRONTIER};
+
+/**
+ * @brief Command-line name of a strategy
+ * @param kind The strategy
+ * @return "wall-follower", "flood-fill", "a-star" or "frontier"
+ */
+std::string_view to_string(StrategyKind kind);
+
+/**
+ * @brief Strategy of a command-line name
+ * @param name Name as returned by to_string()
+ * @return The strategy
+ * @throws std::invalid_argument if no strategy has that name
+ */
+StrategyKind strategy_from_string(std::string_view name);
+
+/**
+ * @brief Decides where the robot goes next while exploring a maze
+ *
+ * A strategy reads the walls seen so far from the map it was created on,
+ * which its StrategyEngine keeps up to date, treating unknown walls as
+ * openings. The engine reports every side that changed in that map, so
+ * strategies keeping derived state, e.g. a distance field, can repair it
+ * instead of recomputing it.
+ */
+class ExplorationStrategy {
+public:
+  virtual ~ExplorationStrategy() = default;
+
+  /**
+   * @brief Take into account a side of a cell that changed in the map
+   * @param index Index of the cell
+   * @param side Side of the cell that changed
+   */
+  virtual void on_wall_changed(int /*index*/, Heading /*side*/) {}
+
+  /**
+   * @brief Choose the side to leave the robot's cell through
+   *
+   * Called once the walls around the cell have been sensed into the map.
+   * @param index Index of the robot's cell
+   * @param heading Heading of the robot
+   * @return The side to move through, or nothing if no goal can be reached
+   */
+  virtual std::optional<Heading> next_side(int index, Heading heading) = 0;
+
+  /**
+   * @brief Distance field to the goal cells the strategy keeps up to date
+   * @return The field, or nullptr if the strategy keeps none
+   */
+  [[nodiscard]] virtual const FloodFill *field() const { return nullptr; }
+};
+
+/**
+ * @brief Create a strategy
+ * @param kind Strategy to create
+ * @param map Walls seen so far; must outlive the strategy
+ * @param goals Indices of the goal cells
+ * @return The strategy
+ */
+std::unique_ptr<ExplorationStrategy> make_strategy(StrategyKind kind, const MazeMap &map,
+                                                   const std::vector<int> &goals);
+
+/**
+ * @brief Create a strategy on a restored map and distance field
+ *
+ * Strategies keeping a distance field to the goal start from a copy of
+ * @p field instead of computing their own; the others ignore it.
+ * @param kind Strategy to create
+ * @param map Walls seen so far; must outlive the strategy
+ * @param goals Indices of the goal cells
+ * @param field Distances to @p goals on walls identical to @p map, e.g.
+ * restored from a SolverSnapshot
+ * @return The strategy
+ */
+std::unique_ptr<ExplorationStrategy> make_strategy(StrategyKind kind, const MazeMap &map,
+                                                   const std::vector<int> &goals,
+                                                   const FloodFill &field);
+
+} // namespace maze
@@ -0,0 +1,176 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "maze_solver/bitboard_bfs.hpp"
+#include "maze_solver/frontier_queue.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_types.hpp"
+
+namespace maze {
+
+/**
+ * @brief BFS implementation used by FloodFill::recompute()
+ */
+enum class BfsEngine {
+  SCALAR,  ///< Queue of cell indices, one cell at a time
+  BITBOARD ///< Whole frontier at once on 64-bit row bitboards
+};
+
+/**
+ * @brief Distance field to the goal cells over a MazeMap
+ *
+ * Each cell holds the number of moves to the nearest goal, treating unknown
+ * walls as openings. recompute() rebuilds the whole field with a BFS from the
+ * goals. update() repairs the field after a single side of a cell changed in
+ * the map, touching only the cells whose distance actually depends on it:
+ *
+ * - A new wall can only lengthen paths. The cells that lost every neighbour
+ *   one step closer to the goal are invalidated, transitively, and then
+ *   re-flooded from the valid cells around them.
+ * - A new opening can only shorten paths. The shorter distance is
+ *   propagated outwards from the two cells it connects.
+ *
+ * Both produce exactly the field a full recompute() would.
+ *
+ * recompute() runs on either BFS engine, selected at runtime with
+ * set_engine(); both give identical fields.
+ */
+class FloodFill {
+public:
+  /// Distance of a cell from which no goal can be reached
+  static constexpr int UNREACHABLE{std::numeric_limits<int>::max()};
+
+  /**
+   * @brief Construct the distance field and compute it
+   * @param map Map the distances are computed on; must outlive the field
+   * @param goals Indices of the goal cells
+   */
+  FloodFill(const MazeMap &map, std::vector<int> goals);
+
+  /**
+   * @brief Construct the distance field from saved distances, without
+   * computing it
+   * @param map Map the distances were computed on; must outlive the field
+   * @param goals Indices of the goal cells
+   * @param distances Distance of each cell, row-major, as restore() takes
+   * @throws std::invalid_argument if the number of distances is wrong
+   */
+  FloodFill(const MazeMap &map, std::vector<int> goals, const std::vector<int> &distances);
+
+  /**
+   * @brief Rebuild the whole field with a BFS from the goal cells
+   */
+  void recompute();
+
+  /**
+   * @brief Replace the field with saved distances, without recomputing
+   *
+   * The distances must have been computed for the same goals on a map
+   * identical to the current one, e.g. restored from the same snapshot.
+   * @param distances Distance of each cell, row-major
+   * @throws std::invalid_argument if the number of distances is wrong
+   * @see SolverSnapshot
+   */
+  void restore(const std::vector<int> &distances);
+
+  /**
+   * @brief Select the BFS engine used by recompute()
+   * @param engine Engine to use from now on
+   */
+  void set_engine(BfsEngine engine) { engine_ = engine; }
+
+  /// @brief BFS engine used by recompute()
+  [[nodiscard]] BfsEngine engine() const { return engine_; }
+
+  /**
+   * @brief Repair the field after a side of a cell changed in the map
+   * @param index Index of the cell
+   * @param side Side of the cell that changed
+   */
+  void update(int index, Heading side);
+
+  /**
+   * @brief Distance of a cell to the nearest goal
+   * @param index Index of the cell
+   * @return Number of moves, or UNREACHABLE
+   */
+  [[nodiscard]] int distance(int index) const {
+    return distances_[static_cast<std::size_t>(index)];
+  }
+
+  /// @brief Distances of all cells, row-major
+  [[nodiscard]] const std::vector<int> &distances() const { return distances_; }
+
+  /// @brief Indices of the goal cells
+  [[nodiscard]] const std::vector<int> &goals() const { return goals_; }
+
+  /**
+   * @brief Open side of a cell leading to the neighbour closest to the goal
+   *
+   * Ties are broken in favour of @p preferred, then clockwise from north.
+   * @param index Index of the cell
+   * @param preferred Side to pick on a tie, usually the current heading
+   * @return The side to move through
+   */
+  [[nodiscard]] Heading best_side(int index, Heading preferred) const;
+
+  /**
+   * @brief Number of cell distances written since construction
+   *
+   * Measures the work of recompute() and update().
+   * @return The number of writes to the field
+   */
+  [[nodiscard]] long cells_updated() const { return cells_updated_; }
+
+private:
+  /**
+   * @brief Check whether the side of a cell is open in the map
+   */
+  [[nodiscard]] bool is_open(int index, Heading side) const {
+    return !map_.has_wall(index, side);
+  }
+
+  /**
+   * @brief Check whether a cell still has a valid open neighbour one step
+   * closer to the goal
+   */
+  [[nodiscard]] bool is_supported(int index) const;
+
+  /**
+   * @brief Invalidate the cells that depended on a cell whose distance can
+   * no longer be justified, then re-flood them
+   * @param index Cell that lost its support
+   */
+  void raise(int index);
+
+  /**
+   * @brief Propagate a shortened distance outwards from a cell
+   * @param index Cell whose distance decreased
+   */
+  void lower(int index);
+
+  void write(int index, int distance) {
+    distances_[static_cast<std::size_t>(index)] = distance;
+    ++cells_updated_;
+  }
+
+  const MazeMap &map_;                     ///< Map the distances are computed on
+  std::vector<int> goals_;                 ///< Indices of the goal cells
+  std::vector<int> distances_;             ///< Distance of each cell
+  std::vector<std::uint8_t> is_goal_;      ///< Goal flag of each cell
+  long cells_updated_{0};                  ///< Writes to the field
+  BfsEngine engine_{BfsEngine::SCALAR};    ///< Engine of recompute()
+  BitboardBfs bitboard_;                   ///< State of the bitboard engine
+
+  // Scratch storage, kept across calls so that repairs do not allocate
+  std::vector<std::uint8_t> invalid_;      ///< Cells being re-flooded
+  std::vector<int> invalidated_;           ///< Cells invalidated by raise()
+  std::vector<int> pending_;               ///< Cells left to check in raise()
+  std::vector<std::pair<int, int>> seeds_; ///< (distance, cell) to re-flood from
+  FrontierQueue frontier_;                 ///< BFS frontier
+}; // class FloodFill
+
+} // namespace maze
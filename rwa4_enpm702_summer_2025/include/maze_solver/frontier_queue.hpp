@@ -0,0 +1,100 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace maze {
+
+/**
+ * @brief Fixed-capacity FIFO of cell indices for BFS frontiers
+ *
+ * A ring buffer allocated once, when the maze is created, with a capacity
+ * of the number of cells rounded up to a power of two so that wrapping is a
+ * mask. Cell indices are packed in 16 bits on mazes of up to 65536 cells,
+ * which covers every competition size, and stored in 32 bits on larger
+ * ones. Unlike std::queue on a std::deque, pushing and popping never
+ * allocate and consecutive cells share cache lines.
+ *
+ * A BFS that queues each cell at most once never fills it.
+ */
+class FrontierQueue {
+public:
+  /// Number of cells whose indices are packed in 16 bits
+  static constexpr int NARROW_CELLS{1 << 16};
+
+  /**
+   * @brief Construct an empty queue that can hold no cell
+   */
+  FrontierQueue() = default;
+
+  /**
+   * @brief Construct an empty queue for the cells of a maze
+   * @param cells Number of cells of the maze
+   */
+  explicit FrontierQueue(int cells) {
+    std::size_t capacity{1};
+    while (capacity < static_cast<std::size_t>(cells)) {
+      capacity *= 2;
+    }
+    mask_ = capacity - 1;
+    narrow_ = cells <= NARROW_CELLS;
+    if (narrow_) {
+      narrow_cells_.resize(capacity);
+    } else {
+      wide_cells_.resize(capacity);
+    }
+  }
+
+  /**
+   * @brief Add a cell at the back
+   * @param cell Index of the cell
+   * @throws std::length_error if the queue is full
+   */
+  void push(int cell) {
+    if (size_ == capacity()) {
+      throw std::length_error("Frontier queue is full");
+    }
+    const std::size_t slot{(head_ + size_) & mask_};
+    if (narrow_) {
+      narrow_cells_[slot] = static_cast<std::uint16_t>(cell);
+    } else {
+      wide_cells_[slot] = static_cast<std::uint32_t>(cell);
+    }
+    ++size_;
+  }
+
+  /// @brief Cell at the front; the queue must not be empty
+  [[nodiscard]] int front() const {
+    return narrow_ ? narrow_cells_[head_] : static_cast<int>(wide_cells_[head_]);
+  }
+
+  /// @brief Remove the cell at the front; the queue must not be empty
+  void pop() {
+    head_ = (head_ + 1) & mask_;
+    --size_;
+  }
+
+  /// @brief Remove every cell
+  void clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] std::size_t size() const { return size_; }
+  /// @brief Number of cells the queue can hold
+  [[nodiscard]] std::size_t capacity() const {
+    return narrow_ ? narrow_cells_.size() : wide_cells_.size();
+  }
+
+private:
+  std::vector<std::uint16_t> narrow_cells_; ///< Ring of 16-bit indices
+  std::vector<std::uint32_t> wide_cells_;   ///< Ring of 32-bit indices
+  std::size_t mask_{0};                     ///< Capacity minus one
+  std::size_t head_{0};                     ///< Slot of the front cell
+  std::size_t size_{0};                     ///< Number of queued cells
+  bool narrow_{true};                       ///< Whether 16-bit slots are used
+}; // class FrontierQueue
+
+} // namespace maze
@@ -0,0 +1,176 @@
+#pragma once
+/**
+ * @file instrumentation.hpp
+ * @brief Optional counters and latency histograms of MazeControlAPI calls
+ *
+ * Compiled in only when MAZE_API_INSTRUMENTATION is defined (CMake option
+ * RWA4_MAZE_API_INSTRUMENTATION). Otherwise the probe macros below expand to
+ * nothing and the instrumentation costs nothing.
+ *
+ * When enabled, every MazeControlAPI call is counted and timed, and the
+ * bytes written to and read from the simulator are counted. The report is
+ * written to stderr at exit, and on SIGUSR1 at the next API call.
+ */
+
+#ifdef MAZE_API_INSTRUMENTATION
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+namespace maze {
+
+/**
+ * @brief MazeControlAPI methods that are counted separately
+ */
+enum class ApiCommand : std::uint8_t {
+  GET_MAZE_WIDTH,
+  GET_MAZE_HEIGHT,
+  HAS_WALL_FRONT,
+  HAS_WALL_RIGHT,
+  HAS_WALL_LEFT,
+  SENSE_WALLS,
+  QUERY_WALL, ///< Any of the has_wall_*_async() methods
+  MOVE_FORWARD,
+  TURN_RIGHT,
+  TURN_LEFT,
+  SET_WALL,
+  CLEAR_WALL,
+  SET_COLOR,
+  CLEAR_COLOR,
+  CLEAR_ALL_COLOR,
+  SET_TEXT,
+  CLEAR_TEXT,
+  CLEAR_ALL_TEXT,
+  WAS_RESET,
+  ACK_RESET,
+  FLUSH,
+  COUNT ///< Number of commands, not a command
+};
+
+/**
+ * @brief Latency histogram with HDR-style buckets
+ *
+ * Buckets are logarithmic with 8 linear sub-buckets per power of two, so
+ * every recorded value is known to within 12.5% whatever its magnitude,
+ * from nanoseconds to seconds, in a fixed 4 KiB table.
+ */
+class LatencyHistogram {
+public:
+  /**
+   * @brief Record one latency
+   * @param nanoseconds Latency to record
+   */
+  void record(std::uint64_t nanoseconds);
+
+  /// @brief Number of recorded latencies
+  [[nodiscard]] std::uint64_t count() const;
+
+  /**
+   * @brief Latency below which a fraction of the recorded ones lie
+   * @param quantile Fraction in [0, 1], e.g. 0.99
+   * @return Upper bound of the bucket holding the quantile, in nanoseconds
+   */
+  [[nodiscard]] std::uint64_t percentile(double quantile) const;
+
+  /// @brief Largest recorded latency, in nanoseconds
+  [[nodiscard]] std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+
+  /// @brief Sum of the recorded latencies, in nanoseconds
+  [[nodiscard]] std::uint64_t total() const { return total_.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr int SUB_BUCKET_BITS{3};
+  static constexpr std::size_t BUCKETS{(64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS};
+
+  static std::size_t bucket_of(std::uint64_t value);
+  static std::uint64_t upper_bound_of(std::size_t bucket);
+
+  std::array<std::atomic<std::uint64_t>, BUCKETS> buckets_{};
+  std::atomic<std::uint64_t> max_{0};
+  std::atomic<std::uint64_t> total_{0};
+}; // class LatencyHistogram
+
+/**
+ * @brief Process-wide instrumentation counters
+ *
+ * Counters are atomic so that solvers on several threads can share them.
+ */
+class Instrumentation {
+public:
+  /// @brief The process-wide instance; installs the SIGUSR1 handler
+  static Instrumentation &instance();
+
+  /**
+   * @brief Record a completed API call
+   * @param command Method that was called
+   * @param nanoseconds Time spent in the call
+   */
+  void record(ApiCommand command, std::uint64_t nanoseconds);
+
+  /// @brief Count bytes written to the simulator
+  void add_bytes_written(std::size_t bytes) {
+    bytes_written_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  /// @brief Count bytes read from the simulator
+  void add_bytes_read(std::size_t bytes) {
+    bytes_read_.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  /// @brief Histogram of the calls to a method
+  [[nodiscard]] const LatencyHistogram &histogram(ApiCommand command) const {
+    return histograms_[static_cast<std::size_t>(command)];
+  }
+
+  /**
+   * @brief Write the report
+   * @param out Stream to write to
+   */
+  void dump(std::ostream &out) const;
+
+  /// @brief Write the report to stderr; called at exit
+  ~Instrumentation();
+
+private:
+  Instrumentation();
+
+  std::array<LatencyHistogram, static_cast<std::size_t>(ApiCommand::COUNT)> histograms_;
+  std::atomic<std::uint64_t> bytes_written_{0};
+  std::atomic<std::uint64_t> bytes_read_{0};
+}; // class Instrumentation
+
+/**
+ * @brief Times the enclosing scope and records it as one API call
+ */
+class ApiProbe {
+public:
+  explicit ApiProbe(ApiCommand command)
+      : command_{command}, start_{std::chrono::steady_clock::now()} {}
+  ~ApiProbe();
+  ApiProbe(const ApiProbe &) = delete;
+  ApiProbe &operator=(const ApiProbe &) = delete;
+
+private:
+  ApiCommand command_;
+  std::chrono::steady_clock::time_point start_;
+}; // class ApiProbe
+
+} // namespace maze
+
+#define MAZE_API_PROBE(command) \
+  const maze::ApiProbe maze_api_probe_ { maze::ApiCommand::command }
+#define MAZE_API_COUNT_BYTES_WRITTEN(bytes) \
+  maze::Instrumentation::instance().add_bytes_written(bytes)
+#define MAZE_API_COUNT_BYTES_READ(bytes) \
+  maze::Instrumentation::instance().add_bytes_read(bytes)
+
+#else
+
+#define MAZE_API_PROBE(command) static_cast<void>(0)
+#define MAZE_API_COUNT_BYTES_WRITTEN(bytes) static_cast<void>(0)
+#define MAZE_API_COUNT_BYTES_READ(bytes) static_cast<void>(0)
+
+#endif
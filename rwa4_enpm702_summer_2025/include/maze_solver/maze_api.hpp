@@ -1,13 +1,32 @@
 #pragma once
+#include <memory>
 #include <string>
+#include <string_view>
+
+#include "maze_solver/wall_future.hpp"
 
 namespace maze {
 
+class MazeBackend;
+
+/**
+ * @brief Wall readings around the current position, as seen by the robot
+ */
+struct WallReadings {
+  bool front{false}; ///< Wall in front of the robot
+  bool left{false};  ///< Wall to the left of the robot
+  bool right{false}; ///< Wall to the right of the robot
+};
+
 /**
  * @brief API for controlling and interacting with a maze environment
  *
  * This class provides methods to navigate through a maze, query maze
  * properties, manipulate walls, set colors and text, and handle reset events.
+ * Every method dispatches to the active MazeBackend, which is the external
+ * simulator over stdin/stdout unless another backend is installed.
+ *
+ * @see set_backend()
  */
 class MazeControlAPI {
 public:
@@ -133,6 +152,84 @@ public:
    */
   static void log(std::string_view text);
 
+  /**
+   * @brief Enable or disable batching of commands sent to the simulator
+   *
+   * Commands that do not need a reply (set_wall, set_color, set_text,
+   * clear_*) are always buffered until the next flush point: a query that
+   * needs a reply, flush() or program exit. When batching is enabled, the
+   * acknowledgements of move_forward, turn_left and turn_right are not
+   * waited for either: these commands are buffered as well and their replies
+   * are consumed in FIFO order before the reply to the next query.
+   *
+   * @note With batching enabled, a failed move_forward is reported by the
+   * next query instead of by move_forward itself.
+   * @param enabled true to defer acknowledgements, false to wait for them
+   */
+  static void set_batching(bool enabled);
+
+  /**
+   * @brief Check whether commands are currently batched
+   * @return true if batching is enabled, false otherwise
+   */
+  static bool is_batching();
+
+  /**
+   * @brief Write all buffered commands to the simulator in a single flush
+   */
+  static void flush();
+
+  /**
+   * @brief Query the front, left and right walls in a single round trip
+   *
+   * The three queries are pipelined: they are written together and their
+   * replies are read back in order.
+   * @return Wall readings around the current position
+   */
+  static WallReadings sense_walls();
+
+  /**
+   * @brief Ask whether there is a wall in front, without waiting for the
+   * reply
+   *
+   * Several queries issued back to back are answered by one round trip when
+   * the first of them is waited on.
+   * @return The future reply, about the position at the time of the call
+   */
+  static WallFuture has_wall_front_async();
+
+  /**
+   * @brief Ask whether there is a wall to the right, without waiting for
+   * the reply
+   * @return The future reply, about the position at the time of the call
+   */
+  static WallFuture has_wall_right_async();
+
+  /**
+   * @brief Ask whether there is a wall to the left, without waiting for the
+   * reply
+   * @return The future reply, about the position at the time of the call
+   */
+  static WallFuture has_wall_left_async();
+
+  /**
+   * @brief Install the backend all methods dispatch to
+   *
+   * The previous backend is destroyed, which flushes any command it still
+   * buffers. Each thread has its own active backend, so solvers running on
+   * different threads do not interfere.
+   * @param backend New backend; nullptr restores the stdin/stdout backend
+   * @see StdioBackend
+   * @see SimulatorBackend
+   */
+  static void set_backend(std::unique_ptr<MazeBackend> backend);
+
+  /**
+   * @brief Get the active backend
+   * @return The backend all methods dispatch to
+   */
+  static MazeBackend &backend();
+
 }; // class MazeControlAPI
 
 } // namespace maze
\ No newline at end of file
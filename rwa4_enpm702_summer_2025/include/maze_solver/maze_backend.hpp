@@ -0,0 +1,218 @@
+#pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/wall_future.hpp"
+
+namespace maze {
+
+/**
+ * @brief Interface of the maze environments MazeControlAPI can drive
+ *
+ * Every static method of MazeControlAPI dispatches to the active backend.
+ * StdioBackend talks to the external mms simulator, SimulatorBackend runs a
+ * maze loaded from a file in the solver's own process.
+ *
+ * @see MazeControlAPI::set_backend()
+ */
+class MazeBackend {
+public:
+  virtual ~MazeBackend() = default;
+
+  /**
+   * @brief Get the width of the maze
+   * @return The width of the maze in cells
+   */
+  virtual int get_maze_width() = 0;
+
+  /**
+   * @brief Get the height of the maze
+   * @return The height of the maze in cells
+   */
+  virtual int get_maze_height() = 0;
+
+  /**
+   * @brief Check if there is a wall in front of the robot
+   * @return true if there is a wall in front, false otherwise
+   */
+  virtual bool has_wall_front() = 0;
+
+  /**
+   * @brief Check if there is a wall to the right of the robot
+   * @return true if there is a wall to the right, false otherwise
+   */
+  virtual bool has_wall_right() = 0;
+
+  /**
+   * @brief Check if there is a wall to the left of the robot
+   * @return true if there is a wall to the left, false otherwise
+   */
+  virtual bool has_wall_left() = 0;
+
+  /**
+   * @brief Move the robot forward
+   * @param distance Number of cells to move forward
+   */
+  virtual void move_forward(int distance) = 0;
+
+  /**
+   * @brief Turn the robot clockwise
+   */
+  virtual void turn_right() = 0;
+
+  /**
+   * @brief Turn the robot counter-clockwise
+   */
+  virtual void turn_left() = 0;
+
+  /**
+   * @brief Set a wall at the specified position and direction
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @param direction Direction of the wall ('n', 's', 'e', 'w')
+   */
+  virtual void set_wall(int x, int y, char direction) = 0;
+
+  /**
+   * @brief Clear a wall at the specified position and direction
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @param direction Direction of the wall ('n', 's', 'e', 'w')
+   */
+  virtual void clear_wall(int x, int y, char direction) = 0;
+
+  /**
+   * @brief Set the color of a cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @param color Color character identifier
+   */
+  virtual void set_color(int x, int y, char color) = 0;
+
+  /**
+   * @brief Clear the color of a cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   */
+  virtual void clear_color(int x, int y) = 0;
+
+  /**
+   * @brief Clear all colors from the maze
+   */
+  virtual void clear_all_color() = 0;
+
+  /**
+   * @brief Set text at the specified cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @param text Text to display at the cell
+   */
+  virtual void set_text(int x, int y, const std::string &text) = 0;
+
+  /**
+   * @brief Clear text from the specified cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   */
+  virtual void clear_text(int x, int y) = 0;
+
+  /**
+   * @brief Clear all text from the maze
+   */
+  virtual void clear_all_text() = 0;
+
+  /**
+   * @brief Check if the maze was reset
+   * @return true if the maze was reset, false otherwise
+   */
+  virtual bool was_reset() = 0;
+
+  /**
+   * @brief Acknowledge that the reset has been handled
+   */
+  virtual void ack_reset() = 0;
+
+  /**
+   * @brief Query the front, left and right walls
+   *
+   * The default implementation issues the three queries one after the other.
+   * @return Wall readings around the robot
+   */
+  virtual WallReadings sense_walls() {
+    WallReadings walls;
+    walls.front = has_wall_front();
+    walls.left = has_wall_left();
+    walls.right = has_wall_right();
+    return walls;
+  }
+
+  /**
+   * @brief Query a wall without waiting for the reply
+   *
+   * The default implementation answers right away with the blocking query,
+   * which is what backends without a command channel need.
+   * @param side Side of the robot to query
+   * @return The future reply
+   */
+  virtual WallFuture query_wall(WallSide side) {
+    switch (side) {
+    case WallSide::LEFT:
+      return WallFuture::ready(has_wall_left());
+    case WallSide::RIGHT:
+      return WallFuture::ready(has_wall_right());
+    case WallSide::FRONT:
+    default:
+      return WallFuture::ready(has_wall_front());
+    }
+  }
+
+  /**
+   * @brief Check whether the reply to a pending query has been read
+   *
+   * Only called by WallFuture, for futures issued by this backend.
+   * @param ticket Ticket of the query
+   * @return true if await_wall_query() will not block
+   */
+  virtual bool is_wall_query_ready(std::uint64_t /*ticket*/) const { return true; }
+
+  /**
+   * @brief Wait for the reply to a pending query
+   *
+   * Only called by WallFuture, once per pending future.
+   * @param ticket Ticket of the query
+   * @return true if there is a wall on the queried side
+   */
+  virtual bool await_wall_query(std::uint64_t /*ticket*/) {
+    throw std::logic_error("Backend has no pending wall queries");
+  }
+
+  /**
+   * @brief Forget a pending query whose future was dropped unread
+   * @param ticket Ticket of the query
+   */
+  virtual void release_wall_query(std::uint64_t /*ticket*/) {}
+
+  /**
+   * @brief Enable or disable deferred acknowledgements
+   *
+   * Backends without a command channel ignore this setting.
+   * @param enabled true to defer acknowledgements, false to wait for them
+   */
+  virtual void set_batching(bool /*enabled*/) {}
+
+  /**
+   * @brief Check whether acknowledgements are deferred
+   * @return true if batching is enabled, false otherwise
+   */
+  virtual bool is_batching() const { return false; }
+
+  /**
+   * @brief Send all buffered commands
+   */
+  virtual void flush() {}
+}; // class MazeBackend
+
+} // namespace maze
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_view.hpp"
+
+namespace maze {
+
+/**
+ * @brief Read-only collection of mazes in one memory-mapped file
+ *
+ * A corpus file (.mzc) holds many complete mazes in the layout MazeMap
+ * uses in memory, so opening it maps the file and checks its index, and
+ * each maze is then a MazeView into the mapping: no parsing, no copy and
+ * no allocation per maze. Pages are only read from disk when a maze is
+ * first used.
+ *
+ * File layout, native byte order, every record 8-byte aligned:
+ * - header: magic "MAZECORP", version (uint32), maze count (uint32),
+ *   offset of the index (uint64)
+ * - per maze: width and height (uint16 each), goal count (uint8),
+ *   3 reserved bytes, 4 goal cell indices (uint32 each), then the cell
+ *   bytes as in MazeMap::data(), padded to a multiple of 8
+ * - index: file offset of each maze record (uint64 each)
+ */
+class MazeCorpus {
+public:
+  /**
+   * @brief Map a corpus file
+   * @param path Path to the corpus file
+   * @return The mapped corpus
+   * @throws std::runtime_error if the file cannot be mapped or is malformed
+   */
+  static MazeCorpus open(const std::string &path);
+
+  /**
+   * @brief Write mazes to a corpus file
+   *
+   * The goal of each maze is its centre.
+   * @param path Path of the file to create or overwrite
+   * @param mazes Mazes to store, in order
+   * @throws std::runtime_error if the file cannot be written
+   */
+  static void write(const std::string &path, const std::vector<MazeMap> &mazes);
+
+  MazeCorpus(MazeCorpus &&other) noexcept;
+  MazeCorpus &operator=(MazeCorpus &&other) noexcept;
+  MazeCorpus(const MazeCorpus &) = delete;
+  MazeCorpus &operator=(const MazeCorpus &) = delete;
+
+  /// @brief Unmap the file; views into it become invalid
+  ~MazeCorpus();
+
+  /// @brief Number of mazes
+  [[nodiscard]] std::size_t size() const { return count_; }
+
+  /**
+   * @brief View of a maze
+   * @param i Position of the maze in the corpus
+   * @return A view valid as long as the corpus is
+   */
+  [[nodiscard]] MazeView operator[](std::size_t i) const;
+
+private:
+  MazeCorpus(const std::uint8_t *data, std::size_t size);
+
+  const std::uint8_t *data_{nullptr}; ///< Start of the mapping
+  std::size_t size_{0};               ///< Length of the mapping
+  std::size_t count_{0};              ///< Number of mazes
+  const std::uint64_t *offsets_{nullptr}; ///< Offset of each maze record
+}; // class MazeCorpus
+
+} // namespace maze
@@ -0,0 +1,111 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace maze {
+
+/**
+ * @brief Shadow framebuffer of the simulator's cell colors and texts
+ *
+ * Annotations are staged into the next frame instead of being sent right
+ * away. present() compares the staged frame with what the simulator
+ * already shows and sends only the cells that differ, all together, through
+ * MazeControlAPI. Writing the same value again, or overwriting a value
+ * within the same frame, costs no protocol traffic.
+ *
+ * Only cells touched since the last present() are compared, so presenting a
+ * frame costs nothing for the untouched part of the maze.
+ */
+class MazeDisplay {
+public:
+  /// Color of a cell without color
+  static constexpr char NO_COLOR{'\0'};
+
+  /**
+   * @brief Construct a display of a blank maze
+   * @param width Width of the maze in cells
+   * @param height Height of the maze in cells
+   */
+  MazeDisplay(int width, int height);
+
+  /**
+   * @brief Stage the color of a cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @param color Color character identifier
+   */
+  void set_color(int x, int y, char color);
+
+  /**
+   * @brief Stage the removal of the color of a cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   */
+  void clear_color(int x, int y) { set_color(x, y, NO_COLOR); }
+
+  /**
+   * @brief Stage the text of a cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @param text Text to display; empty to clear it
+   */
+  void set_text(int x, int y, std::string_view text);
+
+  /**
+   * @brief Stage a number as the text of a cell, e.g. a distance
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @param value Number to display
+   */
+  void set_text(int x, int y, int value);
+
+  /**
+   * @brief Stage the removal of the text of a cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   */
+  void clear_text(int x, int y) { set_text(x, y, std::string_view{}); }
+
+  /**
+   * @brief Send the cells whose staged state differs from the shown state
+   * and flush them in one write
+   * @return Number of protocol commands sent
+   */
+  int present();
+
+  /// @brief Number of color and text writes staged since construction
+  [[nodiscard]] long requested_writes() const { return requested_; }
+  /// @brief Number of protocol commands actually sent since construction
+  [[nodiscard]] long emitted_writes() const { return emitted_; }
+  /// @brief Number of staged writes that needed no protocol command
+  [[nodiscard]] long suppressed_writes() const { return requested_ - emitted_; }
+
+private:
+  /**
+   * @brief Visual state of one cell
+   */
+  struct Cell {
+    char color{NO_COLOR}; ///< Color, or NO_COLOR
+    std::string text;     ///< Text, empty if none
+  };
+
+  /**
+   * @brief Remember that a cell must be compared at the next present()
+   */
+  void touch(std::size_t index);
+
+  [[nodiscard]] std::size_t index(int x, int y) const {
+    return static_cast<std::size_t>(y * width_ + x);
+  }
+
+  int width_;                  ///< Width of the maze in cells
+  std::vector<Cell> shown_;    ///< State the simulator displays
+  std::vector<Cell> staged_;   ///< State of the next frame
+  std::vector<bool> dirty_;    ///< Cell touched since the last present()
+  std::vector<std::size_t> dirty_cells_; ///< Indices of the touched cells
+  long requested_{0};          ///< Writes staged
+  long emitted_{0};            ///< Commands sent
+}; // class MazeDisplay
+
+} // namespace maze
@@ -0,0 +1,102 @@
+#pragma once
+#include <string_view>
+
+#include "maze_solver/maze_map.hpp"
+
+namespace maze {
+
+/**
+ * @brief Maze generation algorithms
+ */
+enum class MazeAlgorithm {
+  BACKTRACKER, ///< generate_backtracker_maze()
+  KRUSKAL,     ///< generate_kruskal_maze()
+  BRAIDED      ///< generate_braided_maze()
+};
+
+/// Every generation algorithm, in declaration order
+inline constexpr MazeAlgorithm ALL_MAZE_ALGORITHMS[]{
+    MazeAlgorithm::BACKTRACKER, MazeAlgorithm::KRUSKAL, MazeAlgorithm::BRAIDED};
+
+/**
+ * @brief Command-line name of a generation algorithm
+ * @param algorithm The algorithm
+ * @return "backtracker", "kruskal" or "braided"
+ */
+std::string_view to_string(MazeAlgorithm algorithm);
+
+/**
+ * @brief Generation algorithm of a command-line name
+ * @param name Name as returned by to_string()
+ * @return The algorithm
+ * @throws std::invalid_argument if no algorithm has that name
+ */
+MazeAlgorithm maze_algorithm_from_string(std::string_view name);
+
+/**
+ * @brief Generate a maze with any of the algorithms
+ * @param algorithm Algorithm to use, with its default parameters
+ * @param width Width of the maze in cells
+ * @param height Height of the maze in cells
+ * @param seed Seed of the random generator; the same seed gives the same maze
+ * @return The maze, with every wall known
+ */
+MazeMap generate_maze(MazeAlgorithm algorithm, int width, int height, unsigned seed);
+
+/**
+ * @brief Generate a perfect maze with a recursive backtracker
+ *
+ * Passages are carved by a randomized depth-first search from cell (0, 0),
+ * which gives long winding corridors and exactly one path between any two
+ * cells. The search uses an explicit stack, so very large mazes are fine.
+ *
+ * @param width Width of the maze in cells
+ * @param height Height of the maze in cells
+ * @param seed Seed of the random generator; the same seed gives the same maze
+ * @return The maze, with every wall known
+ */
+MazeMap generate_backtracker_maze(int width, int height, unsigned seed);
+
+/**
+ * @brief Generate a perfect maze with randomized Kruskal's algorithm
+ *
+ * Inner walls are visited in random order and removed when the cells on
+ * either side are not connected yet, tracked with a union-find. This gives
+ * many short dead ends and branches everywhere, unlike the long corridors
+ * of the backtracker.
+ *
+ * @param width Width of the maze in cells
+ * @param height Height of the maze in cells
+ * @param seed Seed of the random generator; the same seed gives the same maze
+ * @return The maze, with every wall known
+ */
+MazeMap generate_kruskal_maze(int width, int height, unsigned seed);
+
+/**
+ * @brief Generate a braided maze: a backtracker maze with its dead ends
+ * opened into loops
+ *
+ * Each dead end is, with probability @p braid, opened through one of its
+ * walls, preferably into a neighbouring dead end so that both go at once.
+ * With @p braid at 1 the maze has no dead end left and many paths between
+ * any two cells, the hard case for solvers that assume a single path.
+ *
+ * @param width Width of the maze in cells
+ * @param height Height of the maze in cells
+ * @param seed Seed of the random generator; the same seed gives the same maze
+ * @param braid Fraction of the dead ends to remove, in [0, 1]
+ * @return The maze, with every wall known
+ */
+MazeMap generate_braided_maze(int width, int height, unsigned seed, double braid = 1.0);
+
+/**
+ * @brief Knock down a random fraction of the inner walls of a maze
+ *
+ * Turns a perfect maze into one with loops and open areas.
+ * @param map Maze to modify
+ * @param fraction Probability of removing each inner wall, in [0, 1]
+ * @param seed Seed of the random generator
+ */
+void remove_random_walls(MazeMap &map, double fraction, unsigned seed);
+
+} // namespace maze
@@ -0,0 +1,203 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "maze_solver/maze_types.hpp"
+
+namespace maze {
+
+/**
+ * @brief Compact map of the maze, one byte per cell
+ *
+ * Cells are stored contiguously in row-major order (index y * width + x).
+ * The low nibble of a cell holds its wall bits and the high nibble the
+ * matching "known" bits, both in wall_bit() order (north, east, south,
+ * west). A 16x16 map is 256 bytes and a 32x32 map 1 KiB, so a solver
+ * working on it stays in L1 cache.
+ *
+ * Walls are shared by two cells: setting one side also updates the
+ * neighbour's opposite side, so both cells always agree.
+ */
+class MazeMap {
+public:
+  /// Mask of the wall bits of a cell
+  static constexpr std::uint8_t WALL_MASK{0x0F};
+  /// Mask of the known bits of a cell
+  static constexpr std::uint8_t KNOWN_MASK{0xF0};
+
+  /**
+   * @brief Construct a map with every inner wall unknown
+   *
+   * The outer boundary is marked as known walls.
+   * @param width Width of the maze in cells
+   * @param height Height of the maze in cells
+   * @throws std::invalid_argument if a dimension is not positive
+   */
+  MazeMap(int width, int height);
+
+  /**
+   * @brief Construct a map sized from MazeControlAPI::get_maze_width() and
+   * MazeControlAPI::get_maze_height()
+   * @return An empty map of the current maze
+   */
+  static MazeMap from_api();
+
+  /// @brief Width of the maze in cells
+  [[nodiscard]] int width() const { return width_; }
+  /// @brief Height of the maze in cells
+  [[nodiscard]] int height() const { return height_; }
+  /// @brief Number of cells
+  [[nodiscard]] int cell_count() const { return width_ * height_; }
+
+  /**
+   * @brief Index of a cell
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @return y * width + x
+   */
+  [[nodiscard]] int index(int x, int y) const { return y * width_ + x; }
+  /// @brief X coordinate of the cell at @p index
+  [[nodiscard]] int x_of(int index) const { return index % width_; }
+  /// @brief Y coordinate of the cell at @p index
+  [[nodiscard]] int y_of(int index) const { return index / width_; }
+
+  /**
+   * @brief Indices of the centre cells, the goal of a micromouse maze
+   * @return The 1, 2 or 4 cells at the centre of the maze
+   */
+  [[nodiscard]] std::vector<int> centre_cells() const;
+
+  /**
+   * @brief Check whether a position lies inside the maze
+   * @param x X coordinate
+   * @param y Y coordinate
+   * @return true if (x, y) is a cell of the maze, false otherwise
+   */
+  [[nodiscard]] bool contains(int x, int y) const {
+    return x >= 0 && y >= 0 && x < width_ && y < height_;
+  }
+
+  /**
+   * @brief Index of the neighbouring cell
+   * @pre @p side of the cell is not on the outer boundary
+   * @param index Index of the cell
+   * @param side Side of the cell to step through
+   * @return Index of the neighbour
+   */
+  [[nodiscard]] int neighbour(int index, Heading side) const {
+    return index + step_[static_cast<std::size_t>(side)];
+  }
+
+  /**
+   * @brief Raw byte of a cell: wall bits in the low nibble, known bits in
+   * the high nibble
+   * @param index Index of the cell
+   * @return The cell byte
+   */
+  [[nodiscard]] std::uint8_t cell(int index) const {
+    return cells_[static_cast<std::size_t>(index)];
+  }
+
+  /**
+   * @brief Check whether a side of a cell is a wall known so far
+   * @param index Index of the cell
+   * @param side Side of the cell
+   * @return true if a wall has been recorded on that side
+   */
+  [[nodiscard]] bool has_wall(int index, Heading side) const {
+    return cell(index) & wall_bit(side);
+  }
+
+  /**
+   * @brief Check whether a side of a cell has been observed
+   * @param index Index of the cell
+   * @param side Side of the cell
+   * @return true if that side is known to be a wall or an opening
+   */
+  [[nodiscard]] bool is_known(int index, Heading side) const {
+    return cell(index) & (wall_bit(side) << 4);
+  }
+
+  /**
+   * @brief Check whether the four sides of a cell have been observed
+   * @param index Index of the cell
+   * @return true if every side of the cell is known
+   */
+  [[nodiscard]] bool is_explored(int index) const {
+    return (cell(index) & KNOWN_MASK) == KNOWN_MASK;
+  }
+
+  /**
+   * @brief Record a side of a cell as a wall or an opening
+   *
+   * The neighbour sharing that side is updated as well.
+   * @param index Index of the cell
+   * @param side Side of the cell
+   * @param wall true for a wall, false for an opening
+   * @return true if the recorded state changed, false otherwise
+   */
+  bool set_wall(int index, Heading side, bool wall);
+
+  /**
+   * @brief Overwrite the walls of a cell with a mask, marking all four sides
+   * known, without touching the neighbours
+   *
+   * Meant for loading complete mazes, where both sides of each wall are
+   * given.
+   * @param index Index of the cell
+   * @param walls Wall bits of the cell
+   */
+  void set_cell_walls(int index, std::uint8_t walls) {
+    cells_[static_cast<std::size_t>(index)] =
+        static_cast<std::uint8_t>(KNOWN_MASK | (walls & WALL_MASK));
+  }
+
+  /**
+   * @brief Overwrite every cell with saved cell bytes
+   * @param cells cell_count() bytes, as returned by data()
+   */
+  void assign_cells(const std::uint8_t *cells);
+
+  /**
+   * @brief Forget every wall, then mark the outer boundary
+   */
+  void clear();
+
+  /**
+   * @brief Mark the outer boundary as known walls
+   *
+   * The north and south rows are updated a 64-bit word at a time.
+   */
+  void mark_boundary();
+
+  /**
+   * @brief Number of cells whose four sides are known
+   *
+   * Counted eight cells at a time on 64-bit words.
+   * @return The number of explored cells
+   */
+  [[nodiscard]] int explored_cell_count() const;
+
+  /// @brief Contiguous cell bytes, row-major
+  [[nodiscard]] const std::uint8_t *data() const { return cells_.data(); }
+
+private:
+  /**
+   * @brief OR a byte pattern into a contiguous run of cells, one 64-bit word
+   * at a time
+   * @param first Index of the first cell
+   * @param count Number of cells
+   * @param pattern Byte OR-ed into each cell
+   */
+  void or_run(int first, int count, std::uint8_t pattern);
+
+  int width_;                          ///< Width of the maze in cells
+  int height_;                         ///< Height of the maze in cells
+  std::array<int, 4> step_;            ///< Index offset of each neighbour
+  /// Cell bytes, padded to a whole number of 64-bit words
+  std::vector<std::uint8_t> cells_;
+}; // class MazeMap
+
+} // namespace maze
@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+
+namespace maze {
+
+/**
+ * @brief Absolute heading of the robot, or side of a cell
+ *
+ * North is towards increasing y and east towards increasing x, as in the
+ * simulator. The values are ordered clockwise, so turning right adds one
+ * and turning left adds three (modulo 4).
+ */
+enum class Heading : std::uint8_t {
+  NORTH, ///< Towards increasing y
+  EAST,  ///< Towards increasing x
+  SOUTH, ///< Towards decreasing y
+  WEST   ///< Towards decreasing x
+};
+
+/**
+ * @brief Heading after a clockwise quarter turn
+ * @param heading Current heading
+ * @return The heading to the right of @p heading
+ */
+constexpr Heading turned_right(Heading heading) {
+  return static_cast<Heading>((static_cast<int>(heading) + 1) % 4);
+}
+
+/**
+ * @brief Heading after a counter-clockwise quarter turn
+ * @param heading Current heading
+ * @return The heading to the left of @p heading
+ */
+constexpr Heading turned_left(Heading heading) {
+  return static_cast<Heading>((static_cast<int>(heading) + 3) % 4);
+}
+
+/**
+ * @brief Opposite heading
+ * @param heading Current heading
+ * @return The heading behind @p heading
+ */
+constexpr Heading reversed(Heading heading) {
+  return static_cast<Heading>((static_cast<int>(heading) + 2) % 4);
+}
+
+/**
+ * @brief Wall bit of a side of a cell (north: 1, east: 2, south: 4, west: 8)
+ * @param heading Side of the cell
+ * @return The bit of that side in a wall mask
+ */
+constexpr std::uint8_t wall_bit(Heading heading) {
+  return static_cast<std::uint8_t>(1U << static_cast<unsigned>(heading));
+}
+
+/**
+ * @brief X offset of one step in a direction
+ * @param heading Direction of the step
+ * @return -1, 0 or 1
+ */
+constexpr int dx(Heading heading) {
+  return heading == Heading::EAST ? 1 : heading == Heading::WEST ? -1 : 0;
+}
+
+/**
+ * @brief Y offset of one step in a direction
+ * @param heading Direction of the step
+ * @return -1, 0 or 1
+ */
+constexpr int dy(Heading heading) {
+  return heading == Heading::NORTH ? 1 : heading == Heading::SOUTH ? -1 : 0;
+}
+
+/**
+ * @brief Direction character used by the simulator protocol
+ * @param heading Side of a cell
+ * @return 'n', 'e', 's' or 'w'
+ */
+constexpr char to_char(Heading heading) {
+  constexpr char names[]{'n', 'e', 's', 'w'};
+  return names[static_cast<int>(heading)];
+}
+
+} // namespace maze
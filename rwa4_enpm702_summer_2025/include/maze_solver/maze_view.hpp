@@ -0,0 +1,110 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_types.hpp"
+
+namespace maze {
+
+/**
+ * @brief Read-only, non-owning view of a complete maze
+ *
+ * Points at cell bytes laid out like MazeMap::data() (row-major, wall bits
+ * in the low nibble) that live elsewhere: in a MazeMap, or in a memory-mapped
+ * MazeCorpus. Copying a view copies neither the cells nor allocates, so a
+ * simulator can run a maze straight out of a corpus file.
+ *
+ * The cells must outlive the view.
+ */
+class MazeView {
+public:
+  /// Maximum number of goal cells a view carries
+  static constexpr std::size_t MAX_GOALS{4};
+
+  /**
+   * @brief Construct a view of cells stored elsewhere
+   * @param width Width of the maze in cells
+   * @param height Height of the maze in cells
+   * @param cells Cell bytes, row-major, width * height of them
+   * @param goals Indices of the goal cells
+   * @param goal_count Number of goal cells, at most MAX_GOALS
+   */
+  MazeView(int width, int height, const std::uint8_t *cells,
+           const std::array<int, MAX_GOALS> &goals, std::size_t goal_count)
+      : width_{width}, height_{height}, cells_{cells}, goals_{goals},
+        goal_count_{goal_count} {}
+
+  /**
+   * @brief Construct a view of a map, with its centre cells as goals
+   * @param map The map; must outlive the view
+   */
+  explicit MazeView(const MazeMap &map)
+      : width_{map.width()}, height_{map.height()}, cells_{map.data()} {
+    for (int goal : map.centre_cells()) {
+      goals_[goal_count_++] = goal;
+    }
+  }
+
+  /// @brief Width of the maze in cells
+  [[nodiscard]] int width() const { return width_; }
+  /// @brief Height of the maze in cells
+  [[nodiscard]] int height() const { return height_; }
+  /// @brief Number of cells
+  [[nodiscard]] int cell_count() const { return width_ * height_; }
+  /// @brief Index of a cell
+  [[nodiscard]] int index(int x, int y) const { return y * width_ + x; }
+
+  /// @brief Check whether a position lies inside the maze
+  [[nodiscard]] bool contains(int x, int y) const {
+    return x >= 0 && y >= 0 && x < width_ && y < height_;
+  }
+
+  /// @brief Raw byte of a cell, as in MazeMap::cell()
+  [[nodiscard]] std::uint8_t cell(int index) const {
+    return cells_[static_cast<std::size_t>(index)];
+  }
+
+  /// @brief Check whether a side of a cell has a wall
+  [[nodiscard]] bool has_wall(int index, Heading side) const {
+    return cell(index) & wall_bit(side);
+  }
+
+  /// @brief Number of goal cells
+  [[nodiscard]] std::size_t goal_count() const { return goal_count_; }
+  /// @brief Index of the @p i th goal cell
+  [[nodiscard]] int goal(std::size_t i) const { return goals_[i]; }
+
+  /**
+   * @brief Check whether a cell is one of the goal cells
+   * @param index Index of the cell
+   * @return true if the cell is a goal cell
+   */
+  [[nodiscard]] bool is_goal(int index) const {
+    for (std::size_t i = 0; i < goal_count_; ++i) {
+      if (goals_[i] == index) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief Indices of the goal cells
+  [[nodiscard]] std::vector<int> goals() const {
+    return {goals_.begin(), goals_.begin() + static_cast<std::ptrdiff_t>(goal_count_)};
+  }
+
+  /// @brief Contiguous cell bytes, row-major
+  [[nodiscard]] const std::uint8_t *data() const { return cells_; }
+
+private:
+  int width_;                         ///< Width of the maze in cells
+  int height_;                        ///< Height of the maze in cells
+  const std::uint8_t *cells_;         ///< Cell bytes, not owned
+  std::array<int, MAX_GOALS> goals_{}; ///< Indices of the goal cells
+  std::size_t goal_count_{0};         ///< Number of goal cells
+}; // class MazeView
+
+} // namespace maze
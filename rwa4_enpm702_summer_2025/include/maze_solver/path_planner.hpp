@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_types.hpp"
+
+namespace maze {
+
+/**
+ * @brief Time model of a run, in arbitrary units
+ *
+ * A straightaway is cheaper per cell than a sequence of single moves: the
+ * robot only accelerates once. Every quarter turn costs extra.
+ */
+struct CostModel {
+  double first_cell{1.0};      ///< First cell of a straightaway
+  double straight_cell{0.5};   ///< Each further cell of the same straightaway
+  double quarter_turn{1.5};    ///< turn_left() or turn_right()
+};
+
+/**
+ * @brief One command of a planned run
+ */
+struct Motion {
+  /**
+   * @brief Kind of command
+   */
+  enum class Kind {
+    FORWARD,    ///< move_forward(cells)
+    TURN_LEFT,  ///< turn_left()
+    TURN_RIGHT  ///< turn_right()
+  };
+  Kind kind;     ///< Command to issue
+  int cells{0};  ///< Number of cells for FORWARD, 0 otherwise
+};
+
+/**
+ * @brief Result of PathPlanner::plan()
+ */
+struct Plan {
+  bool found{false};             ///< A goal can be reached
+  double cost{0.0};              ///< Time of the run under the cost model
+  int goal{-1};                  ///< Index of the goal cell reached
+  Heading final_heading{Heading::NORTH}; ///< Heading on arrival
+  std::vector<Motion> motions;   ///< Commands, straightaways merged
+};
+
+/**
+ * @brief Turn-aware shortest-time path search over a MazeMap
+ *
+ * Dijkstra over (cell, heading, moving straight) states. Moving forward
+ * costs CostModel::first_cell, or CostModel::straight_cell when the robot
+ * has not turned since its last move; turning costs
+ * CostModel::quarter_turn. The path reaches the cheapest of several goal
+ * cells, and consecutive forward moves are merged into one multi-cell
+ * move_forward(n), which also saves protocol round trips.
+ */
+class PathPlanner {
+public:
+  /**
+   * @brief Construct a planner
+   * @param cost Time model of the run
+   */
+  explicit PathPlanner(CostModel cost = {}) : cost_{cost} {}
+
+  /**
+   * @brief Plan the fastest run from a pose to the nearest goal
+   * @param map Discovered map
+   * @param start Index of the start cell
+   * @param heading Heading of the robot at the start
+   * @param goals Indices of the goal cells
+   * @param known_only Only go through sides known to be open (speed run);
+   * otherwise unknown sides are treated as openings (exploration)
+   * @return The plan; Plan::found is false if no goal can be reached
+   */
+  [[nodiscard]] Plan plan(const MazeMap &map, int start, Heading heading,
+                          const std::vector<int> &goals,
+                          bool known_only = true) const;
+
+  /**
+   * @brief Issue the commands of a plan through MazeControlAPI
+   * @param plan Plan to run
+   */
+  static void execute(const Plan &plan);
+
+private:
+  CostModel cost_; ///< Time model of the run
+}; // class PathPlanner
+
+} // namespace maze
@@ -0,0 +1,133 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+namespace maze {
+
+/**
+ * @brief Writes commands of the simulator text protocol into a reusable buffer
+ *
+ * Commands are appended to an internal buffer whose capacity is kept across
+ * flushes, so formatting a command does not allocate once the buffer has
+ * grown to its working size. Nothing reaches the output stream until flush()
+ * is called.
+ */
+class ProtocolWriter {
+public:
+  /**
+   * @brief Construct a writer sending its commands to a stream
+   * @param out Stream connected to the simulator
+   */
+  explicit ProtocolWriter(std::ostream &out);
+
+  /**
+   * @brief Start a new command
+   * @param name Name of the command (e.g. "setWall")
+   * @return The writer, to chain the arguments
+   */
+  ProtocolWriter &command(std::string_view name);
+
+  /**
+   * @brief Append an integer argument to the current command
+   * @param value Argument to append
+   * @return The writer, to chain more arguments
+   */
+  ProtocolWriter &arg(int value);
+
+  /**
+   * @brief Append a single character argument to the current command
+   * @param value Argument to append
+   * @return The writer, to chain more arguments
+   */
+  ProtocolWriter &arg(char value);
+
+  /**
+   * @brief Append a text argument to the current command
+   * @param value Argument to append
+   * @return The writer, to chain more arguments
+   */
+  ProtocolWriter &arg(std::string_view value);
+
+  /**
+   * @brief Terminate the current command
+   */
+  void end();
+
+  /**
+   * @brief Write the buffered commands to the stream in a single write and
+   * flush it
+   */
+  void flush();
+
+  /**
+   * @brief Check whether commands are waiting to be flushed
+   * @return true if nothing is buffered, false otherwise
+   */
+  [[nodiscard]] bool empty() const { return buffer_.empty(); }
+
+  /**
+   * @brief Change the stream the commands are written to
+   * @param out New output stream; buffered commands are kept
+   */
+  void set_stream(std::ostream &out) { out_ = &out; }
+
+private:
+  std::ostream *out_; ///< Stream connected to the simulator
+  std::string buffer_; ///< Commands not flushed yet
+}; // class ProtocolWriter
+
+/**
+ * @brief Parses replies of the simulator text protocol without allocating
+ *
+ * Each reply is a whitespace-delimited token read straight from the stream
+ * buffer into a fixed-size array. The stream is not flushed before reading:
+ * callers are expected to flush their ProtocolWriter first.
+ */
+class ProtocolReader {
+public:
+  /**
+   * @brief Construct a reader taking its replies from a stream
+   * @param in Stream connected to the simulator
+   */
+  explicit ProtocolReader(std::istream &in);
+
+  /**
+   * @brief Read the next reply token
+   * @return View of the token, valid until the next read; empty at end of
+   * input
+   */
+  std::string_view read_token();
+
+  /**
+   * @brief Read a "true"/"false" reply
+   * @return true if the reply is "true", false otherwise
+   */
+  bool read_bool();
+
+  /**
+   * @brief Read an "ack" reply
+   * @return true if the reply is "ack", false otherwise (e.g. "crash")
+   */
+  bool read_ack();
+
+  /**
+   * @brief Read an integer reply
+   * @return The value of the reply, 0 if it is not a number
+   */
+  int read_int();
+
+  /**
+   * @brief Change the stream the replies are read from
+   * @param in New input stream
+   */
+  void set_stream(std::istream &in) { in_ = &in; }
+
+private:
+  std::istream *in_; ///< Stream connected to the simulator
+  std::array<char, 64> token_{}; ///< Last token read; longer ones are cut
+}; // class ProtocolReader
+
+} // namespace maze
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "maze_solver/maze_backend.hpp"
+#include "maze_solver/replay_log.hpp"
+#include "maze_solver/wall_future.hpp"
+
+namespace maze {
+
+/**
+ * @brief Backend recording every command and its reply to a replay log
+ *
+ * Wraps another backend, usually the StdioBackend talking to the mms
+ * simulator, and forwards every call to it unchanged; batching and
+ * asynchronous wall queries keep working. Each command is logged in the
+ * order the solver issued it, with the reply or the exception it got, so a
+ * ReplayBackend can later run the same solver through exactly the same run
+ * without the simulator.
+ *
+ * The reply of an asynchronous wall query is only known once it is read,
+ * so records wait in memory behind the oldest unanswered query.
+ *
+ * @see ReplayLogWriter for the file format
+ */
+class RecordingBackend : public MazeBackend {
+public:
+  /**
+   * @brief Construct a backend recording the commands sent to another one
+   * @param inner Backend the commands are forwarded to
+   * @param path Path of the replay log to create or overwrite
+   * @throws std::runtime_error if the log cannot be created
+   */
+  RecordingBackend(std::unique_ptr<MazeBackend> inner, const std::string &path);
+
+  /**
+   * @brief Write every record to the log, queries still unanswered marked
+   * unread
+   */
+  ~RecordingBackend() override;
+
+  int get_maze_width() override;
+  int get_maze_height() override;
+  bool has_wall_front() override;
+  bool has_wall_right() override;
+  bool has_wall_left() override;
+  void move_forward(int distance) override;
+  void turn_right() override;
+  void turn_left() override;
+  void set_wall(int x, int y, char direction) override;
+  void clear_wall(int x, int y, char direction) override;
+  void set_color(int x, int y, char color) override;
+  void clear_color(int x, int y) override;
+  void clear_all_color() override;
+  void set_text(int x, int y, const std::string &text) override;
+  void clear_text(int x, int y) override;
+  void clear_all_text() override;
+  bool was_reset() override;
+  void ack_reset() override;
+  WallReadings sense_walls() override;
+  WallFuture query_wall(WallSide side) override;
+  bool is_wall_query_ready(std::uint64_t ticket) const override;
+  bool await_wall_query(std::uint64_t ticket) override;
+  void release_wall_query(std::uint64_t ticket) override;
+  void set_batching(bool enabled) override { inner_->set_batching(enabled); }
+  bool is_batching() const override { return inner_->is_batching(); }
+
+  /**
+   * @brief Flush the wrapped backend and the records written so far
+   */
+  void flush() override;
+
+  /// @brief Number of records written to the log
+  [[nodiscard]] long records() const { return writer_.records(); }
+  /// @brief Size of the log in bytes
+  [[nodiscard]] long bytes() const { return writer_.bytes(); }
+
+private:
+  /**
+   * @brief A record, possibly waiting for the reply of its query
+   */
+  struct Entry {
+    ReplayRecord record; ///< The command and its reply
+    bool pending{false}; ///< The reply has not been read yet
+  };
+
+  /**
+   * @brief An asynchronous query forwarded to the wrapped backend
+   */
+  struct Query {
+    std::uint64_t entry; ///< Number of the record of the query
+    WallFuture future;   ///< Reply of the wrapped backend
+  };
+
+  /**
+   * @brief Run a call of the wrapped backend, logging the record with the
+   * error if it throws
+   */
+  template <typename Call>
+  void forward(ReplayRecord &record, Call &&call);
+
+  /**
+   * @brief Log a complete record
+   */
+  void append(ReplayRecord record);
+
+  /**
+   * @brief Write the records that no unanswered query holds back, and flush
+   * the log to its file when one of them carried a reply
+   */
+  void commit();
+
+  /// @brief Entry of a record by number
+  Entry &entry(std::uint64_t number) {
+    return entries_[static_cast<std::size_t>(number - first_entry_)];
+  }
+
+  std::unique_ptr<MazeBackend> inner_;     ///< Backend doing the work
+  ReplayLogWriter writer_;                 ///< The replay log
+  std::deque<Entry> entries_;              ///< Records not written yet
+  std::uint64_t first_entry_{0};           ///< Number of entries_.front()
+  std::map<std::uint64_t, Query> queries_; ///< Unread queries by ticket
+  std::uint64_t next_ticket_{0};           ///< Ticket of the next query
+}; // class RecordingBackend
+
+} // namespace maze
@@ -0,0 +1,85 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "maze_solver/maze_backend.hpp"
+#include "maze_solver/replay_log.hpp"
+
+namespace maze {
+
+/**
+ * @brief Backend answering from a replay log instead of a simulator
+ *
+ * Every command of the solver must be the next one of the log, with the
+ * same arguments; it gets the recorded reply, or throws the recorded
+ * error. The whole log is decoded up front, so a deterministic solver
+ * re-runs a recorded run at full CPU speed, e.g. under a profiler or at
+ * each step of a bisection, without the simulator. A solver that issues
+ * anything else has diverged from the recorded run, and the replay stops.
+ *
+ * Batching settings and flushes are not recorded and are accepted as is.
+ *
+ * @see RecordingBackend
+ */
+class ReplayBackend : public MazeBackend {
+public:
+  /**
+   * @brief Construct a backend replaying a log file
+   * @param path Path of the replay log
+   * @throws std::runtime_error if the log cannot be read
+   */
+  explicit ReplayBackend(const std::string &path);
+
+  /**
+   * @brief Construct a backend replaying records
+   * @param records The records, in the order the commands were issued
+   */
+  explicit ReplayBackend(std::vector<ReplayRecord> records);
+
+  int get_maze_width() override;
+  int get_maze_height() override;
+  bool has_wall_front() override;
+  bool has_wall_right() override;
+  bool has_wall_left() override;
+  void move_forward(int distance) override;
+  void turn_right() override;
+  void turn_left() override;
+  void set_wall(int x, int y, char direction) override;
+  void clear_wall(int x, int y, char direction) override;
+  void set_color(int x, int y, char color) override;
+  void clear_color(int x, int y) override;
+  void clear_all_color() override;
+  void set_text(int x, int y, const std::string &text) override;
+  void clear_text(int x, int y) override;
+  void clear_all_text() override;
+  bool was_reset() override;
+  void ack_reset() override;
+  WallReadings sense_walls() override;
+  WallFuture query_wall(WallSide side) override;
+  bool await_wall_query(std::uint64_t ticket) override;
+
+  /// @brief Number of records replayed so far
+  [[nodiscard]] std::size_t position() const { return position_; }
+  /// @brief Number of records of the log
+  [[nodiscard]] std::size_t size() const { return records_.size(); }
+  /// @brief Check whether every record has been replayed
+  [[nodiscard]] bool finished() const { return position_ == records_.size(); }
+
+private:
+  /**
+   * @brief Take the next record, checking that it is the expected command
+   * @param expected The command the solver issued
+   * @param raise Whether to throw the recorded error of the command
+   * @return The recorded command and reply
+   * @throws std::runtime_error if the solver diverged from the log, or with
+   * the recorded error if the command threw
+   */
+  const ReplayRecord &next(const ReplayRecord &expected, bool raise = true);
+
+  std::vector<ReplayRecord> records_; ///< The log
+  std::size_t position_{0};           ///< Index of the next record
+}; // class ReplayBackend
+
+} // namespace maze
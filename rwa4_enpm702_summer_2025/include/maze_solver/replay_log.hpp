@@ -0,0 +1,148 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace maze {
+
+/**
+ * @brief Command of a MazeBackend, as stored in a replay log
+ */
+enum class ReplayOp : std::uint8_t {
+  MAZE_WIDTH,      ///< get_maze_width()
+  MAZE_HEIGHT,     ///< get_maze_height()
+  WALL_FRONT,      ///< has_wall_front() or query_wall(WallSide::FRONT)
+  WALL_RIGHT,      ///< has_wall_right() or query_wall(WallSide::RIGHT)
+  WALL_LEFT,       ///< has_wall_left() or query_wall(WallSide::LEFT)
+  SENSE_WALLS,     ///< sense_walls()
+  MOVE_FORWARD,    ///< move_forward()
+  TURN_RIGHT,      ///< turn_right()
+  TURN_LEFT,       ///< turn_left()
+  SET_WALL,        ///< set_wall()
+  CLEAR_WALL,      ///< clear_wall()
+  SET_COLOR,       ///< set_color()
+  CLEAR_COLOR,     ///< clear_color()
+  CLEAR_ALL_COLOR, ///< clear_all_color()
+  SET_TEXT,        ///< set_text()
+  CLEAR_TEXT,      ///< clear_text()
+  CLEAR_ALL_TEXT,  ///< clear_all_text()
+  WAS_RESET,       ///< was_reset()
+  ACK_RESET,       ///< ack_reset()
+  COUNT            ///< Number of commands
+};
+
+/**
+ * @brief One command sent to a backend and what came back
+ */
+struct ReplayRecord {
+  ReplayOp op{ReplayOp::MAZE_WIDTH}; ///< Command
+  int x{0};                          ///< Cell x of wall, color and text commands
+  int y{0};                          ///< Cell y of wall, color and text commands
+  /// Distance of MOVE_FORWARD, otherwise the reply: maze dimension, 1 for a
+  /// wall or a reset, or the WallReadings bits of SENSE_WALLS (front 1,
+  /// left 2, right 4)
+  int value{0};
+  char symbol{0};     ///< Direction of wall commands, color of SET_COLOR
+  std::string text;   ///< Text of SET_TEXT
+  bool unread{false}; ///< Asynchronous wall query whose reply was never read
+  bool threw{false};  ///< The command threw an exception
+  std::string error;  ///< What the exception said
+};
+
+/**
+ * @brief Check whether two records are the same command with the same
+ * arguments, whatever their replies
+ */
+bool same_command(const ReplayRecord &a, const ReplayRecord &b);
+
+/**
+ * @brief Describe the command of a record in the words of the mms protocol
+ * @return E.g. "moveForward 2" or "setColor 0 0 B"
+ */
+std::string describe(const ReplayRecord &record);
+
+/**
+ * @brief Appends records to a replay log file
+ *
+ * Replay log layout: magic "MAZEREPL", version (uint32, native byte order),
+ * then the records back to back. A record starts with one byte holding the
+ * command (low 5 bits), a boolean reply (0x20), the unread flag (0x40) and
+ * the threw flag (0x80). The arguments and non-boolean replies follow as
+ * unsigned LEB128 varints, symbols as single bytes, and text as a varint
+ * length and the bytes; a record that threw ends with its error text. A
+ * wall query or a turn takes one byte, a one-cell move two.
+ *
+ * Records are buffered and written when flush() is called or a 64 KiB
+ * block is full. RecordingBackend flushes after every record carrying a
+ * reply, so a run killed from the simulator loses at most the display
+ * commands sent since its last round trip, and the log only ends with a
+ * partial record if the program was killed while writing it;
+ * ReplayLog::load() then ignores that record.
+ */
+class ReplayLogWriter {
+public:
+  /**
+   * @brief Create or overwrite a log file and write its header
+   * @param path Path of the log file
+   * @throws std::runtime_error if the file cannot be created
+   */
+  explicit ReplayLogWriter(const std::string &path);
+
+  /**
+   * @brief Write the records still buffered
+   */
+  ~ReplayLogWriter();
+
+  ReplayLogWriter(const ReplayLogWriter &) = delete;
+  ReplayLogWriter &operator=(const ReplayLogWriter &) = delete;
+
+  /**
+   * @brief Append a record
+   * @param record The record
+   * @throws std::runtime_error if a full buffer cannot be written
+   */
+  void append(const ReplayRecord &record);
+
+  /**
+   * @brief Write the buffered records to the file
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void flush();
+
+  /// @brief Number of records appended
+  [[nodiscard]] long records() const { return records_; }
+  /// @brief Number of bytes of the log, header included
+  [[nodiscard]] long bytes() const { return bytes_; }
+
+private:
+  std::string path_;   ///< Path of the log file
+  std::ofstream out_;  ///< The log file
+  std::string buffer_; ///< Encoded records not written yet
+  long records_{0};    ///< Records appended
+  long bytes_{0};      ///< Bytes of the log
+}; // class ReplayLogWriter
+
+/**
+ * @brief Reading of replay logs
+ */
+class ReplayLog {
+public:
+  /**
+   * @brief Decode a whole replay log
+   * @param path Path of the log file
+   * @return The records, in the order the commands were issued
+   * @throws std::runtime_error if the file cannot be read or is not a
+   * replay log
+   */
+  static std::vector<ReplayRecord> load(const std::string &path);
+
+  /**
+   * @brief Encode a record in the log format
+   * @param[out] out Bytes the record is appended to
+   * @param record The record
+   */
+  static void encode(std::string &out, const ReplayRecord &record);
+}; // class ReplayLog
+
+} // namespace maze
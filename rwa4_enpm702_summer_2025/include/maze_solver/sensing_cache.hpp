@@ -0,0 +1,129 @@
+#pragma once
+#include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_types.hpp"
+
+namespace maze {
+
+/**
+ * @brief Wall sensing through a cache of the walls seen so far
+ *
+ * Tracks the pose of the robot, which MazeControlAPI does not know, and
+ * records every wall reading in a MazeMap under the cell and absolute side
+ * it belongs to. A query about a side that is already known is answered
+ * locally, so re-checking a wall in a loop, looking again after a turn, or
+ * coming back to a visited cell costs no protocol round trip. Moving also
+ * teaches the cache: the sides the robot passed through are open.
+ *
+ * Walls never move, so readings stay valid across resets of the robot.
+ * Movements must go through the cache for the pose to stay right.
+ */
+class SensingCache {
+public:
+  /**
+   * @brief Construct a cache for the current maze, sized from
+   * MazeControlAPI::get_maze_width() and MazeControlAPI::get_maze_height()
+   */
+  SensingCache();
+
+  /**
+   * @brief Construct a cache for a maze of known size
+   * @param width Width of the maze in cells
+   * @param height Height of the maze in cells
+   */
+  SensingCache(int width, int height);
+
+  /// @brief Check for a wall in front of the robot
+  bool has_wall_front() { return has_wall(heading_); }
+  /// @brief Check for a wall to the left of the robot
+  bool has_wall_left() { return has_wall(turned_left(heading_)); }
+  /// @brief Check for a wall to the right of the robot
+  bool has_wall_right() { return has_wall(turned_right(heading_)); }
+
+  /**
+   * @brief Read the front, left and right walls
+   *
+   * The sides that are not known yet are queried together, in a single
+   * round trip.
+   * @return Wall readings around the robot
+   */
+  WallReadings sense();
+
+  /**
+   * @brief Move forward, then read the walls of the new cell
+   *
+   * The movement and the wall queries are sent together, so the whole step
+   * costs a single round trip. The caller's batching mode is restored and
+   * the pose only advances once the move was acknowledged, also when a
+   * reply throws.
+   * @param distance Number of cells to move forward
+   * @return Wall readings around the robot after the move
+   */
+  WallReadings move_forward_and_sense(int distance = 1);
+
+  /**
+   * @brief Move the robot forward
+   * @param distance Number of cells to move forward
+   */
+  void move_forward(int distance = 1);
+
+  /// @brief Turn the robot clockwise
+  void turn_right();
+  /// @brief Turn the robot counter-clockwise
+  void turn_left();
+
+  /**
+   * @brief Put the pose back on the start cell after the simulator was
+   * reset; the walls seen so far are kept
+   */
+  void reset();
+
+  /**
+   * @brief Replace the walls seen so far, e.g. with the map of a
+   * SolverSnapshot; the pose is kept
+   * @param map Walls to start from
+   * @throws std::invalid_argument if @p map does not have the cache's size
+   */
+  void load_map(const MazeMap &map);
+
+  /// @brief X coordinate of the robot
+  [[nodiscard]] int x() const { return x_; }
+  /// @brief Y coordinate of the robot
+  [[nodiscard]] int y() const { return y_; }
+  /// @brief Heading of the robot
+  [[nodiscard]] Heading heading() const { return heading_; }
+  /// @brief Walls seen so far
+  [[nodiscard]] const MazeMap &map() const { return map_; }
+
+  /// @brief Number of wall queries answered from the cache
+  [[nodiscard]] long hits() const { return hits_; }
+  /// @brief Number of wall queries sent to the simulator
+  [[nodiscard]] long misses() const { return misses_; }
+
+private:
+  /**
+   * @brief Check for a wall on an absolute side of the robot's cell
+   */
+  bool has_wall(Heading side);
+
+  /**
+   * @brief Update the pose after moving forward, recording the openings
+   * passed through
+   */
+  void advance(int distance);
+
+  /**
+   * @brief Read the walls of a cell the robot is in, facing heading_,
+   * querying only the sides not known yet
+   */
+  WallReadings sense_at(int x, int y);
+
+  MazeMap map_;                     ///< Walls seen so far
+  int x_{0};                        ///< Robot x coordinate
+  int y_{0};                        ///< Robot y coordinate
+  Heading heading_{Heading::NORTH}; ///< Robot heading
+  long hits_{0};                    ///< Queries answered locally
+  long misses_{0};                  ///< Queries sent to the simulator
+}; // class SensingCache
+
+} // namespace maze
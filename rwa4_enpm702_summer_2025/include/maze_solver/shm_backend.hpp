@@ -0,0 +1,97 @@
+#pragma once
+#include <string>
+
+#include "maze_solver/maze_backend.hpp"
+#include "maze_solver/shm_channel.hpp"
+
+namespace maze {
+
+/**
+ * @brief Backend talking to a simulator over a shared-memory channel
+ *
+ * Same commands as the mms text protocol, but each one is a fixed 64-byte
+ * binary slot in a ShmChannel: nothing is formatted or parsed, and a round
+ * trip needs no system call while both processes are running. Queries,
+ * moves and turns wait for their reply, which carries any error raised by
+ * the simulator; display commands are sent without waiting. sense_walls()
+ * is a single round trip.
+ *
+ * It is not faster than the pipes: rwa4_shm_benchmark measures a wall query
+ * at about the same latency and a whole exploration slower, as every round
+ * trip still costs two context switches on a single CPU.
+ *
+ * The simulator side is a SharedMemoryServer. main() falls back to the
+ * StdioBackend when no server is found.
+ */
+class SharedMemoryBackend : public MazeBackend {
+public:
+  /**
+   * @brief Attach to the channel of a running SharedMemoryServer
+   * @param name Name of the channel
+   * @throws std::runtime_error if there is no such server
+   */
+  explicit SharedMemoryBackend(const std::string &name);
+
+  int get_maze_width() override;
+  int get_maze_height() override;
+  bool has_wall_front() override;
+  bool has_wall_right() override;
+  bool has_wall_left() override;
+  void move_forward(int distance) override;
+  void turn_right() override;
+  void turn_left() override;
+  void set_wall(int x, int y, char direction) override;
+  void clear_wall(int x, int y, char direction) override;
+  void set_color(int x, int y, char color) override;
+  void clear_color(int x, int y) override;
+  void clear_all_color() override;
+  /// @throws std::invalid_argument if @p text is longer than ShmRequest::MAX_TEXT
+  void set_text(int x, int y, const std::string &text) override;
+  void clear_text(int x, int y) override;
+  void clear_all_text() override;
+  bool was_reset() override;
+  void ack_reset() override;
+
+  /**
+   * @brief Query the three walls in a single round trip
+   * @return Wall readings around the robot
+   */
+  WallReadings sense_walls() override;
+
+private:
+  /// Send a command and wait for its reply, rethrowing a simulator error
+  int call(const ShmRequest &request);
+  /// Send a command without waiting for anything
+  void post(const ShmRequest &request);
+
+  ShmChannel channel_; ///< Channel to the server
+}; // class SharedMemoryBackend
+
+/**
+ * @brief Simulator side of a shared-memory channel
+ *
+ * Creates the channel and answers the commands of one SharedMemoryBackend
+ * by calling another backend, e.g. a SimulatorBackend. Exceptions thrown by
+ * that backend are sent back to the client, which rethrows them.
+ */
+class SharedMemoryServer {
+public:
+  /**
+   * @brief Create the channel
+   * @param name Name of the channel
+   * @throws std::runtime_error if it exists already or cannot be created
+   */
+  explicit SharedMemoryServer(const std::string &name);
+
+  /**
+   * @brief Answer commands until the client leaves
+   * @param backend Backend executing the commands
+   * @return Number of commands served
+   */
+  long serve(MazeBackend &backend);
+
+private:
+  ShmChannel channel_; ///< Channel to the client
+}; // class SharedMemoryServer
+
+} // namespace maze
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "maze_solver/replay_log.hpp"
+
+namespace maze {
+
+/**
+ * @brief Command sent over a ShmChannel, one 64-byte slot
+ */
+struct ShmRequest {
+  /// Longest text a request carries
+  static constexpr std::size_t MAX_TEXT{51};
+
+  ReplayOp op{ReplayOp::MAZE_WIDTH}; ///< Command
+  char symbol{0};                    ///< Direction or color
+  std::uint8_t text_size{0};         ///< Bytes used in text
+  std::int32_t x{0};                 ///< Cell x, or distance of MOVE_FORWARD
+  std::int32_t y{0};                 ///< Cell y
+  char text[MAX_TEXT + 1]{};         ///< Text of SET_TEXT
+};
+
+/**
+ * @brief Reply sent back over a ShmChannel, one 64-byte slot
+ */
+struct ShmReply {
+  /// Longest error message a reply carries; longer ones are cut
+  static constexpr std::size_t MAX_ERROR{57};
+
+  /// Maze dimension, 1 for a wall or a reset, or the WallReadings bits of
+  /// SENSE_WALLS (front 1, left 2, right 4)
+  std::int32_t value{0};
+  bool threw{false};          ///< The command threw on the server
+  std::uint8_t error_size{0}; ///< Bytes used in error
+  char error[MAX_ERROR + 1]{}; ///< What the exception said
+};
+
+static_assert(sizeof(ShmRequest) == 64 && sizeof(ShmReply) == 64,
+              "Channel slots are one cache line");
+
+/**
+ * @brief Two-way channel between two processes over POSIX shared memory
+ *
+ * The shared region holds a ring of requests from the client to the server
+ * and a ring of replies back, each with its producer and consumer counters
+ * on their own cache lines. A side waiting for the other spins briefly and
+ * then sleeps on a futex, which the other side only wakes when it sees a
+ * sleeper, so a round trip between two busy cores costs no system call.
+ * Waits wake up every 100 ms to notice a peer that died without closing
+ * the channel.
+ *
+ * Only available on Linux; elsewhere create() and open() throw.
+ */
+class ShmChannel {
+public:
+  /// Slots in each ring
+  static constexpr std::uint32_t SLOTS{256};
+
+  /**
+   * @brief Create the shared region, as the server
+   * @param name Name of the region, without the leading '/'
+   * @return The channel, unlinked from the name on destruction
+   * @throws std::runtime_error if a live server owns the region, or it
+   * cannot be created
+   */
+  static ShmChannel create(const std::string &name);
+
+  /**
+   * @brief Attach to a region created by a server, as its only client
+   * @param name Name of the region, without the leading '/'
+   * @return The channel
+   * @throws std::runtime_error if there is no such region, it is of another
+   * version, or another client is attached
+   */
+  static ShmChannel open(const std::string &name);
+
+  ShmChannel(ShmChannel &&other) noexcept;
+  ShmChannel &operator=(ShmChannel &&other) noexcept;
+  ShmChannel(const ShmChannel &) = delete;
+  ShmChannel &operator=(const ShmChannel &) = delete;
+
+  /**
+   * @brief Close the channel, and unlink the region if this side created it
+   */
+  ~ShmChannel();
+
+  /**
+   * @brief Queue a request, waiting while the request ring is full
+   * @throws std::runtime_error if the server went away
+   */
+  void send_request(const ShmRequest &request);
+
+  /**
+   * @brief Wait for the next reply
+   * @throws std::runtime_error if the server went away
+   */
+  ShmReply receive_reply();
+
+  /**
+   * @brief Wait for the next request, as the server
+   * @return The request, or nothing once the client closed the channel or
+   * died
+   */
+  std::optional<ShmRequest> receive_request();
+
+  /**
+   * @brief Queue a reply, as the server
+   */
+  void send_reply(const ShmReply &reply);
+
+  /**
+   * @brief Tell the server that no more requests will come
+   */
+  void close();
+
+private:
+  struct Region;
+
+  ShmChannel(Region *region, std::string name, bool owner);
+
+  Region *region_{nullptr}; ///< Mapped region, null once moved from
+  std::string name_;        ///< Name of the region
+  bool owner_{false};       ///< This side created the region
+}; // class ShmChannel
+
+} // namespace maze
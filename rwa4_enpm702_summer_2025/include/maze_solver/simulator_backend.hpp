@@ -0,0 +1,147 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "maze_solver/maze_backend.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_types.hpp"
+#include "maze_solver/maze_view.hpp"
+
+namespace maze {
+
+/**
+ * @brief In-process maze simulator
+ *
+ * Runs a maze held in memory, so solvers can be benchmarked and tested
+ * without the external mms simulator. The robot starts in cell (0, 0)
+ * facing north and the goal is the centre of the maze, unless the maze
+ * names other goal cells. Visualization commands are accepted and ignored.
+ */
+class SimulatorBackend : public MazeBackend {
+public:
+  /**
+   * @brief Construct a simulator for a maze
+   * @param width Width of the maze in cells
+   * @param height Height of the maze in cells
+   * @param walls Wall mask of each cell, row-major (index y * width + x)
+   * @throws std::invalid_argument if the dimensions and walls do not match
+   * @see wall_bit()
+   */
+  SimulatorBackend(int width, int height, std::vector<std::uint8_t> walls);
+
+  /**
+   * @brief Construct a simulator for a fully known maze
+   *
+   * The outer boundary is closed even if the map leaves it open.
+   * @param maze The maze to simulate
+   * @see generate_backtracker_maze()
+   */
+  explicit SimulatorBackend(MazeMap maze);
+
+  /**
+   * @brief Construct a simulator running a maze it does not own
+   *
+   * Nothing is copied, e.g. for a maze of a memory-mapped MazeCorpus. The
+   * outside of the maze is treated as walls whatever the boundary cells say.
+   * @param maze The maze to simulate; its cells must outlive the simulator
+   * @see MazeCorpus
+   */
+  explicit SimulatorBackend(MazeView maze);
+
+  /**
+   * @brief Load a maze file
+   *
+   * Two formats are supported, selected by extension:
+   * - .maz: binary, one byte per cell of a square maze, column-major
+   *   (index x * size + y), bits 1/2/4/8 for north/east/south/west
+   * - .num: text, one "x y N E S W" line per cell, 1 for a wall; the size
+   *   is given by the largest coordinates, and every cell must be listed
+   *   exactly once
+   *
+   * @param path Path to the maze file
+   * @return The simulator running the maze
+   * @throws std::runtime_error if the file cannot be read or parsed, or a
+   * .num file lists no cells, a cell twice, or not every cell
+   */
+  static std::unique_ptr<SimulatorBackend> load(const std::string &path);
+
+  int get_maze_width() override { return maze_.width(); }
+  int get_maze_height() override { return maze_.height(); }
+  bool has_wall_front() override;
+  bool has_wall_right() override;
+  bool has_wall_left() override;
+
+  /**
+   * @brief Move the robot forward
+   * @param distance Number of cells to move forward
+   * @throws std::runtime_error if the robot runs into a wall
+   */
+  void move_forward(int distance) override;
+
+  void turn_right() override;
+  void turn_left() override;
+  void set_wall(int x, int y, char direction) override;
+  void clear_wall(int x, int y, char direction) override;
+  void set_color(int x, int y, char color) override;
+  void clear_color(int x, int y) override;
+  void clear_all_color() override;
+  void set_text(int x, int y, const std::string &text) override;
+  void clear_text(int x, int y) override;
+  void clear_all_text() override;
+  bool was_reset() override;
+  void ack_reset() override;
+
+  /**
+   * @brief Put the robot back on the start cell, as the reset button does
+   */
+  void reset();
+
+  /**
+   * @brief Check whether a side of a cell has a wall
+   * @param x X coordinate of the cell
+   * @param y Y coordinate of the cell
+   * @param side Side of the cell
+   * @return true for a wall or the outside of the maze, false otherwise
+   */
+  [[nodiscard]] bool has_wall(int x, int y, Heading side) const;
+
+  /**
+   * @brief The maze being simulated, with every wall known
+   * @return A view of the maze
+   */
+  [[nodiscard]] const MazeView &maze() const { return maze_; }
+
+  /**
+   * @brief Check whether the robot is on one of the goal cells
+   * @return true if the robot is on a goal cell, false otherwise
+   */
+  [[nodiscard]] bool at_goal() const;
+
+  /// @brief Robot x coordinate
+  [[nodiscard]] int x() const { return x_; }
+  /// @brief Robot y coordinate
+  [[nodiscard]] int y() const { return y_; }
+  /// @brief Robot heading
+  [[nodiscard]] Heading heading() const { return heading_; }
+  /// @brief Number of cells travelled since construction
+  [[nodiscard]] long cells_moved() const { return cells_moved_; }
+  /// @brief Number of quarter turns made since construction
+  [[nodiscard]] long turns() const { return turns_; }
+  /// @brief Number of commands received since construction
+  [[nodiscard]] long commands() const { return commands_; }
+
+private:
+  std::unique_ptr<MazeMap> owned_;  ///< The maze, if the simulator owns it
+  MazeView maze_;                   ///< The maze, fully known
+  int x_{0};                        ///< Robot x coordinate
+  int y_{0};                        ///< Robot y coordinate
+  Heading heading_{Heading::NORTH}; ///< Robot heading
+  bool reset_pending_{false};       ///< Reset not acknowledged yet
+  long cells_moved_{0};             ///< Cells travelled
+  long turns_{0};                   ///< Quarter turns made
+  long commands_{0};                ///< Commands received
+}; // class SimulatorBackend
+
+} // namespace maze
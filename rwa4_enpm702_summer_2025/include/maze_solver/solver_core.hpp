@@ -0,0 +1,254 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "maze_solver/flood_fill.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_types.hpp"
+
+namespace maze {
+
+/**
+ * @brief Flood-fill solver core for a maze size fixed at compile time
+ *
+ * Same map layout and distances as MazeMap and FloodFill, but every buffer
+ * is a std::array sized by the template arguments, the neighbour offsets
+ * are compile-time constants, and the BFS frontier is a fixed ring of
+ * 16-bit cell indices. Nothing is allocated and the compiler can unroll and
+ * strength-reduce the index arithmetic. Competition mazes are 16x16, or
+ * 32x32 for the half-size class.
+ *
+ * The goal is the centre of the maze.
+ * @tparam Width Width of the maze in cells
+ * @tparam Height Height of the maze in cells
+ * @see dispatch_solver_core()
+ */
+template <int Width, int Height>
+class FixedSolverCore {
+public:
+  static_assert(Width > 0 && Height > 0, "Maze dimensions must be positive");
+  static_assert(Width * Height < 0xFFFF, "Cell indices must fit in 16 bits");
+
+  /// Number of cells
+  static constexpr int CELLS{Width * Height};
+
+  /**
+   * @brief Construct a core with every inner wall unknown and the outer
+   * boundary marked
+   */
+  FixedSolverCore() {
+    for (int x = 0; x < Width; ++x) {
+      mark_known_wall(index(x, 0), Heading::SOUTH);
+      mark_known_wall(index(x, Height - 1), Heading::NORTH);
+    }
+    for (int y = 0; y < Height; ++y) {
+      mark_known_wall(index(0, y), Heading::WEST);
+      mark_known_wall(index(Width - 1, y), Heading::EAST);
+    }
+    for (int x : centre(Width)) {
+      for (int y : centre(Height)) {
+        if (x >= 0 && y >= 0) {
+          goals_[goal_count_++] = static_cast<std::uint16_t>(index(x, y));
+        }
+      }
+    }
+    recompute();
+  }
+
+  /// @brief Width of the maze in cells
+  static constexpr int width() { return Width; }
+  /// @brief Height of the maze in cells
+  static constexpr int height() { return Height; }
+  /// @brief Index of a cell
+  static constexpr int index(int x, int y) { return y * Width + x; }
+
+  /// @brief Check whether a side of a cell is a known wall
+  [[nodiscard]] bool has_wall(int index, Heading side) const {
+    return cells_[static_cast<std::size_t>(index)] & wall_bit(side);
+  }
+
+  /// @brief Check whether a side of a cell has been observed
+  [[nodiscard]] bool is_known(int index, Heading side) const {
+    return cells_[static_cast<std::size_t>(index)] & (wall_bit(side) << 4);
+  }
+
+  /**
+   * @brief Record a side of a cell as a wall or an opening, on both cells
+   * sharing it
+   * @return true if the recorded state changed
+   */
+  bool set_wall(int index, Heading side, bool wall) {
+    const std::uint8_t before{cells_[static_cast<std::size_t>(index)]};
+    record(index, side, wall);
+    const int x{index % Width + dx(side)};
+    const int y{index / Width + dy(side)};
+    if (x >= 0 && y >= 0 && x < Width && y < Height) {
+      record(index + kStep[static_cast<std::size_t>(side)], reversed(side), wall);
+    }
+    return cells_[static_cast<std::size_t>(index)] != before;
+  }
+
+  /**
+   * @brief Rebuild the distance field with a BFS from the goal cells
+   */
+  void recompute() {
+    distances_.fill(NONE);
+    std::size_t head{0};
+    std::size_t tail{0};
+    for (std::size_t i = 0; i < goal_count_; ++i) {
+      distances_[goals_[i]] = 0;
+      frontier_[tail++] = goals_[i];
+    }
+    // Every cell is queued at most once, so the ring never wraps. The sides
+    // are visited one by one with the side as a template argument: in a
+    // loop, the compiler keeps the side in a register and loads its step
+    while (head != tail) {
+      const std::uint16_t cell{frontier_[head++]};
+      const std::uint16_t next{static_cast<std::uint16_t>(distances_[cell] + 1)};
+      const std::uint8_t walls{cells_[cell]};
+      visit<0>(cell, walls, next, tail);
+      visit<1>(cell, walls, next, tail);
+      visit<2>(cell, walls, next, tail);
+      visit<3>(cell, walls, next, tail);
+    }
+  }
+
+  /**
+   * @brief Distance of a cell to the nearest goal
+   * @return Number of moves, or FloodFill::UNREACHABLE
+   */
+  [[nodiscard]] int distance(int index) const {
+    const std::uint16_t d{distances_[static_cast<std::size_t>(index)]};
+    return d == NONE ? FloodFill::UNREACHABLE : d;
+  }
+
+  /**
+   * @brief Open side of a cell leading to the neighbour closest to the goal,
+   * with the same tie-breaking as FloodFill::best_side()
+   */
+  [[nodiscard]] Heading best_side(int index, Heading preferred) const {
+    Heading best{preferred};
+    int best_distance{FloodFill::UNREACHABLE};
+    if (!has_wall(index, preferred)) {
+      best_distance = distance(index + kStep[static_cast<std::size_t>(preferred)]);
+    }
+    for (std::size_t side = 0; side < 4; ++side) {
+      const auto heading{static_cast<Heading>(side)};
+      if (has_wall(index, heading)) {
+        continue;
+      }
+      const int candidate{distance(index + kStep[side])};
+      if (candidate < best_distance) {
+        best = heading;
+        best_distance = candidate;
+      }
+    }
+    return best;
+  }
+
+private:
+  /// Distance of an unreachable cell in distances_
+  static constexpr std::uint16_t NONE{0xFFFF};
+  /// Index offset of each neighbour, in wall_bit() order
+  static constexpr std::array<int, 4> kStep{Width, 1, -Width, -1};
+
+  /// The 1 or 2 central coordinates along a dimension, -1 if unused
+  static constexpr std::array<int, 2> centre(int size) {
+    return {size / 2, size % 2 == 0 ? size / 2 - 1 : -1};
+  }
+
+  void record(int index, Heading side, bool wall) {
+    std::uint8_t &cell{cells_[static_cast<std::size_t>(index)]};
+    const std::uint8_t bit{wall_bit(side)};
+    cell = static_cast<std::uint8_t>((cell & ~bit) | (wall ? bit : 0) | bit << 4);
+  }
+
+  /**
+   * @brief Queue the neighbour behind side @p Side of a cell if it is open
+   * and not reached yet
+   */
+  template <std::size_t Side>
+  void visit(std::uint16_t cell, std::uint8_t walls, std::uint16_t next, std::size_t &tail) {
+    if (walls & (1u << Side)) {
+      return;
+    }
+    const auto neighbour{static_cast<std::uint16_t>(cell + kStep[Side])};
+    if (distances_[neighbour] == NONE) {
+      distances_[neighbour] = next;
+      frontier_[tail++] = neighbour;
+    }
+  }
+
+  void mark_known_wall(int index, Heading side) { record(index, side, true); }
+
+  std::array<std::uint8_t, CELLS> cells_{};       ///< Wall and known bits
+  std::array<std::uint16_t, CELLS> distances_{};  ///< Distance of each cell
+  std::array<std::uint16_t, CELLS> frontier_{};   ///< BFS ring of cells
+  std::array<std::uint16_t, 4> goals_{};          ///< Goal cells
+  std::size_t goal_count_{0};                     ///< Number of goal cells
+}; // class FixedSolverCore
+
+/**
+ * @brief Solver core for any maze size, on MazeMap and FloodFill
+ *
+ * Same interface as FixedSolverCore, for the sizes that have no
+ * specialization.
+ */
+class DynamicSolverCore {
+public:
+  /**
+   * @brief Construct a core with every inner wall unknown
+   * @param width Width of the maze in cells
+   * @param height Height of the maze in cells
+   */
+  DynamicSolverCore(int width, int height);
+
+  DynamicSolverCore(const DynamicSolverCore &) = delete;
+  DynamicSolverCore &operator=(const DynamicSolverCore &) = delete;
+
+  [[nodiscard]] int width() const { return map_.width(); }
+  [[nodiscard]] int height() const { return map_.height(); }
+  [[nodiscard]] int index(int x, int y) const { return map_.index(x, y); }
+  [[nodiscard]] bool has_wall(int index, Heading side) const { return map_.has_wall(index, side); }
+  [[nodiscard]] bool is_known(int index, Heading side) const { return map_.is_known(index, side); }
+  bool set_wall(int index, Heading side, bool wall) { return map_.set_wall(index, side, wall); }
+  void recompute() { field_.recompute(); }
+  [[nodiscard]] int distance(int index) const { return field_.distance(index); }
+  [[nodiscard]] Heading best_side(int index, Heading preferred) const {
+    return field_.best_side(index, preferred);
+  }
+
+private:
+  MazeMap map_;     ///< Walls seen so far
+  FloodFill field_; ///< Distances on map_
+}; // class DynamicSolverCore
+
+/**
+ * @brief Run code on the solver core best suited to a maze size
+ *
+ * Picks FixedSolverCore<16, 16> or FixedSolverCore<32, 32> when the size
+ * matches, and DynamicSolverCore otherwise. @p visit is instantiated for
+ * each core type, so the code it runs is compiled against the concrete
+ * core without any virtual call.
+ * @param width Width of the maze in cells
+ * @param height Height of the maze in cells
+ * @param visit Callable taking the core by reference
+ * @return What @p visit returns
+ */
+template <typename Visitor>
+decltype(auto) dispatch_solver_core(int width, int height, Visitor &&visit) {
+  if (width == 16 && height == 16) {
+    FixedSolverCore<16, 16> core;
+    return std::forward<Visitor>(visit)(core);
+  }
+  if (width == 32 && height == 32) {
+    FixedSolverCore<32, 32> core;
+    return std::forward<Visitor>(visit)(core);
+  }
+  DynamicSolverCore core{width, height};
+  return std::forward<Visitor>(visit)(core);
+}
+
+} // namespace maze
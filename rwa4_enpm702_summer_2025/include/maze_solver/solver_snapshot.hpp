@@ -0,0 +1,91 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "maze_solver/flood_fill.hpp"
+#include "maze_solver/maze_map.hpp"
+
+namespace maze {
+
+/**
+ * @brief Saved state of a flood-fill solver: its map and distance field
+ *
+ * A snapshot taken at the end of a run lets the next run, after the
+ * simulator was reset, start with everything explored so far instead of
+ * exploring the maze again. It can be kept in memory, or saved to a
+ * compact file to survive a restart of the solver.
+ *
+ * File layout, native byte order: magic "MAZESNAP", version (uint32),
+ * width, height and goal count (uint16 each), bytes per distance (uint8,
+ * 2 or 4), a reserved byte, the goal cell indices (uint32 each), the cell
+ * bytes as in MazeMap::data(), the distances (UNREACHABLE as all ones) and
+ * an FNV-1a checksum of everything before it (uint32). A 16x16 snapshot is
+ * under 800 bytes.
+ */
+class SolverSnapshot {
+public:
+  /**
+   * @brief Take a snapshot of a solver
+   * @param map The solver's map
+   * @param field The distance field computed on @p map
+   * @return The snapshot
+   */
+  static SolverSnapshot capture(const MazeMap &map, const FloodFill &field);
+
+  /**
+   * @brief Read a snapshot file
+   * @param path Path to the file
+   * @return The snapshot
+   * @throws std::runtime_error if the file cannot be read, is malformed or
+   * fails its checksum
+   */
+  static SolverSnapshot load(const std::string &path);
+
+  /**
+   * @brief Write the snapshot to a file
+   * @param path Path of the file to create or overwrite
+   * @throws std::runtime_error if the file cannot be written
+   */
+  void save(const std::string &path) const;
+
+  /**
+   * @brief Put a solver back in the saved state
+   * @param map Map to overwrite; must have the saved dimensions
+   * @param field Distance field of @p map; must have the saved goals
+   * @throws std::invalid_argument if the solver does not match the snapshot
+   */
+  void restore(MazeMap &map, FloodFill &field) const;
+
+  /// @brief Width of the saved maze in cells
+  [[nodiscard]] int width() const { return width_; }
+  /// @brief Height of the saved maze in cells
+  [[nodiscard]] int height() const { return height_; }
+  /// @brief Indices of the saved goal cells
+  [[nodiscard]] const std::vector<int> &goals() const { return goals_; }
+
+  /**
+   * @brief Encode the snapshot in the file format
+   * @return The encoded bytes
+   */
+  [[nodiscard]] std::string serialize() const;
+
+  /**
+   * @brief Decode a snapshot from the file format
+   * @param bytes The encoded bytes
+   * @return The snapshot
+   * @throws std::runtime_error if the bytes are malformed
+   */
+  static SolverSnapshot deserialize(const std::string &bytes);
+
+private:
+  SolverSnapshot() = default;
+
+  int width_{0};                    ///< Width of the maze in cells
+  int height_{0};                   ///< Height of the maze in cells
+  std::vector<int> goals_;          ///< Indices of the goal cells
+  std::vector<std::uint8_t> cells_; ///< Cell bytes of the map, row-major
+  std::vector<int> distances_;      ///< Distance of each cell
+}; // class SolverSnapshot
+
+} // namespace maze
@@ -0,0 +1,137 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+
+#include "maze_solver/maze_backend.hpp"
+#include "maze_solver/protocol.hpp"
+
+namespace maze {
+
+/**
+ * @brief Backend talking to the mms simulator over the text protocol
+ *
+ * Commands are written to std::cout and replies read from std::cin. Commands
+ * are buffered and only reach the simulator at explicit flush points: before
+ * reading any reply, on flush() and on destruction.
+ *
+ * @see https://github.com/mackorone/mms#communication
+ */
+class StdioBackend : public MazeBackend {
+public:
+  /**
+   * @brief Construct a backend using std::cout and std::cin
+   */
+  StdioBackend();
+
+  /**
+   * @brief Construct a backend using the given streams
+   * @param out Stream the commands are written to
+   * @param in Stream the replies are read from
+   */
+  StdioBackend(std::ostream &out, std::istream &in);
+
+  /**
+   * @brief Flush the commands still buffered
+   */
+  ~StdioBackend() override;
+
+  int get_maze_width() override;
+  int get_maze_height() override;
+  bool has_wall_front() override;
+  bool has_wall_right() override;
+  bool has_wall_left() override;
+  void move_forward(int distance) override;
+  void turn_right() override;
+  void turn_left() override;
+  void set_wall(int x, int y, char direction) override;
+  void clear_wall(int x, int y, char direction) override;
+  void set_color(int x, int y, char color) override;
+  void clear_color(int x, int y) override;
+  void clear_all_color() override;
+  void set_text(int x, int y, const std::string &text) override;
+  void clear_text(int x, int y) override;
+  void clear_all_text() override;
+  bool was_reset() override;
+  void ack_reset() override;
+
+  /**
+   * @brief Query the three walls in a single round trip
+   *
+   * The three queries are written together and their replies are read back
+   * in order.
+   * @return Wall readings around the robot
+   */
+  WallReadings sense_walls() override;
+
+  /**
+   * @brief Send a wall query without reading its reply
+   *
+   * The reply is read in order with the other deferred replies, at the
+   * next flush point or when the future is waited on.
+   * @param side Side of the robot to query
+   * @return The future reply
+   */
+  WallFuture query_wall(WallSide side) override;
+  bool is_wall_query_ready(std::uint64_t ticket) const override;
+  bool await_wall_query(std::uint64_t ticket) override;
+  void release_wall_query(std::uint64_t ticket) override;
+
+  void set_batching(bool enabled) override;
+  bool is_batching() const override { return batching_; }
+  void flush() override;
+
+private:
+  /**
+   * @brief Flush point: send everything written so far and consume the
+   * replies owed to deferred commands
+   * @return The reader, positioned on the reply to the last command
+   */
+  ProtocolReader &await_reply();
+
+  /**
+   * @brief Consume the replies owed to deferred commands, oldest first
+   */
+  void drain_deferred_replies();
+
+  /**
+   * @brief Consume the oldest deferred reply
+   */
+  void read_deferred_reply();
+
+  /// State of a pending wall query
+  enum class QueryState : std::uint8_t { PENDING, WALL, OPEN, DONE };
+
+  /**
+   * @brief State of the query with a ticket
+   * @pre The ticket is neither retrieved nor released
+   */
+  QueryState &query_state(std::uint64_t ticket) {
+    return query_states_[static_cast<std::size_t>(ticket - first_query_)];
+  }
+
+  /**
+   * @brief Forget the queries at the front that are done with
+   */
+  void retire_queries();
+
+  /**
+   * @brief Send a command whose reply is only an acknowledgement
+   * @param command Name of the command
+   */
+  void acknowledged_command(std::string_view command);
+
+  bool batching_{false};     ///< Defer acknowledgements of movements
+  ProtocolWriter writer_;    ///< Buffered commands
+  ProtocolReader reader_;    ///< Reply parser
+  /// Commands whose reply has not been read yet, oldest first
+  std::deque<std::string_view> deferred_replies_;
+  /// State of the wall queries from first_query_ on
+  std::deque<QueryState> query_states_;
+  std::uint64_t first_query_{0};    ///< Ticket of query_states_.front()
+  std::uint64_t answered_queries_{0}; ///< Wall queries whose reply was read
+}; // class StdioBackend
+
+} // namespace maze
@@ -0,0 +1,152 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "maze_solver/exploration_strategy.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/path_planner.hpp"
+#include "maze_solver/sensing_cache.hpp"
+#include "maze_solver/solver_snapshot.hpp"
+
+namespace maze {
+
+/**
+ * @brief Statistics of one exploration run
+ */
+struct ExplorationStats {
+  bool reached_goal{false}; ///< The robot stopped on a goal cell
+  bool interrupted{false};  ///< The run stopped because the simulator was reset
+  int explored_cells{0};    ///< Distinct cells the robot visited
+  long steps{0};            ///< Cells moved
+  long moves{0};            ///< move_forward() commands sent
+  long turns{0};            ///< Quarter turns made
+  long wall_queries{0};     ///< Cells whose walls needed the simulator
+  double seconds{0.0};      ///< Wall-clock time to the goal
+};
+
+/**
+ * @brief Drives the robot through MazeControlAPI with an exploration
+ * strategy until it reaches the goal
+ *
+ * The engine moves and senses through a SensingCache, which tracks the
+ * robot's pose and the walls seen so far: each step is one
+ * move_forward_and_sense() round trip that only queries the sides not
+ * known yet. Every change of the map is reported to the strategy, which
+ * only decides where to go next. Swapping strategies
+ * therefore changes nothing else in the run, and the statistics are
+ * comparable.
+ *
+ * The robot starts in cell (0, 0) facing north and the goal is the centre
+ * of the maze. With watch_resets() on, the engine checks
+ * MazeControlAPI::was_reset() before every move and stops the run when the
+ * simulator was reset; the caller acknowledges the reset and starts the
+ * next run with a new engine, which restore() gives the map and distance
+ * field learned so far.
+ */
+class StrategyEngine {
+public:
+  /// Moves allowed per cell of the maze before run() gives up
+  static constexpr long STEPS_PER_CELL{16};
+
+  /**
+   * @brief Construct an engine for the current maze, sized from
+   * MazeControlAPI::get_maze_width() and MazeControlAPI::get_maze_height()
+   * @param kind Strategy to explore with
+   */
+  explicit StrategyEngine(StrategyKind kind);
+
+  /**
+   * @brief Construct an engine for a maze of known size
+   * @param kind Strategy to explore with
+   * @param width Width of the maze in cells
+   * @param height Height of the maze in cells
+   */
+  StrategyEngine(StrategyKind kind, int width, int height);
+
+  StrategyEngine(const StrategyEngine &) = delete;
+  StrategyEngine &operator=(const StrategyEngine &) = delete;
+
+  /**
+   * @brief Explore until the robot reaches a goal cell, the strategy finds
+   * no way to it, or STEPS_PER_CELL moves per cell have been made
+   * @return Statistics of the run
+   */
+  ExplorationStats run();
+
+  /**
+   * @brief Drive back to the start cell, then run to the goal as fast as
+   * the walls known so far allow
+   *
+   * Both legs are planned by PathPlanner through sides known to be open,
+   * so they never hit a wall, and each straightaway is sent as a single
+   * multi-cell move_forward(). Meant for after run() reached the goal.
+   * @return Statistics of the leg from the start cell to the goal;
+   * reached_goal is false if no known path leads there
+   */
+  ExplorationStats speed_run();
+
+  /**
+   * @brief Check for a reset of the simulator before every move
+   *
+   * Each check is a protocol round trip, so it is off by default.
+   * @param enabled Whether run() stops when the simulator was reset
+   */
+  void watch_resets(bool enabled) { watch_resets_ = enabled; }
+
+  /**
+   * @brief Save the walls seen so far and their distance field
+   *
+   * The field is the one the strategy keeps up to date, or one computed
+   * from the walls for the strategies that keep none.
+   * @return The snapshot
+   */
+  [[nodiscard]] SolverSnapshot snapshot() const;
+
+  /**
+   * @brief Start from a saved map instead of an empty one
+   *
+   * Meant for a new engine, before run(): the strategy is rebuilt on the
+   * restored map and, if it keeps a distance field, starts from the
+   * restored one instead of computing it. The pose stays on the start cell.
+   * @param snapshot Snapshot of an engine for the same maze
+   * @throws std::invalid_argument if the snapshot is of another maze
+   */
+  void restore(const SolverSnapshot &snapshot);
+
+  /// @brief Strategy the engine explores with
+  [[nodiscard]] StrategyKind kind() const { return kind_; }
+  /// @brief Walls seen so far
+  [[nodiscard]] const MazeMap &map() const { return cache_.map(); }
+  /// @brief Sensing cache the engine moves the robot with
+  [[nodiscard]] const SensingCache &cache() const { return cache_; }
+
+private:
+  /**
+   * @brief Tell the strategy about the sides of a cell that changed since
+   * its raw byte was @p before
+   * @param index Index of the cell
+   * @param before MazeMap::cell() of the cell before the change
+   * @param skip Side already reported from the neighbouring cell, if any
+   */
+  void notify(int index, std::uint8_t before, std::optional<Heading> skip = std::nullopt);
+
+  /**
+   * @brief Send the motions of a plan through the sensing cache, so that
+   * the pose it tracks follows the robot
+   * @param plan Plan to run
+   * @param stats Statistics to count the moves and turns in
+   * @return false if the run stopped because the simulator was reset
+   */
+  bool follow(const Plan &plan, ExplorationStats &stats);
+
+  StrategyKind kind_;                              ///< Strategy in use
+  SensingCache cache_;                             ///< Pose and walls seen so far
+  std::vector<int> goals_;                         ///< Indices of the goal cells
+  std::unique_ptr<ExplorationStrategy> strategy_;  ///< Decides the moves
+  std::vector<std::uint8_t> visited_;              ///< Cells visited
+  bool watch_resets_{false};                       ///< run() checks was_reset()
+}; // class StrategyEngine
+
+} // namespace maze
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+
+namespace maze {
+
+class MazeBackend;
+
+/**
+ * @brief Side of the robot a wall query is about
+ */
+enum class WallSide : std::uint8_t { FRONT, LEFT, RIGHT };
+
+/**
+ * @brief Result of a wall query that may still be on its way
+ *
+ * Returned by the MazeControlAPI::has_wall_*_async() methods. The query is
+ * sent without waiting for the reply, so several queries can be in flight
+ * and be answered by a single round trip: get() sends whatever is still
+ * buffered and reads replies only until this query's reply has arrived.
+ *
+ * The reply reflects the robot's position when the query was issued. A
+ * future must not outlive the backend that issued it.
+ */
+class WallFuture {
+public:
+  /**
+   * @brief Construct a future whose result is already known
+   * @param wall The result
+   * @return The ready future
+   */
+  static WallFuture ready(bool wall) { return WallFuture{wall}; }
+
+  /**
+   * @brief Construct a future for a reply still owed by a backend
+   * @param backend Backend that issued the query
+   * @param ticket Ticket identifying the query in the backend
+   */
+  WallFuture(MazeBackend &backend, std::uint64_t ticket)
+      : backend_{&backend}, ticket_{ticket} {}
+
+  WallFuture(WallFuture &&other) noexcept;
+  WallFuture &operator=(WallFuture &&other) noexcept;
+  WallFuture(const WallFuture &) = delete;
+  WallFuture &operator=(const WallFuture &) = delete;
+
+  /**
+   * @brief Tell the backend the reply is no longer wanted, if it was not
+   * retrieved
+   */
+  ~WallFuture();
+
+  /**
+   * @brief Check whether the reply has already been read
+   * @return true if get() will not block
+   */
+  [[nodiscard]] bool is_ready() const;
+
+  /**
+   * @brief Wait for the reply
+   * @return true if there is a wall on the queried side
+   */
+  bool get();
+
+private:
+  explicit WallFuture(bool wall) : wall_{wall} {}
+
+  void release();
+
+  MazeBackend *backend_{nullptr}; ///< Backend owing the reply; null once known
+  std::uint64_t ticket_{0};       ///< Ticket of the query in the backend
+  bool wall_{false};              ///< The result, once known
+}; // class WallFuture
+
+} // namespace maze
@@ -11,25 +11,106 @@
  * @copyright Copyright (c) 2025
  * 
  */
+#include "maze_solver/exploration_strategy.hpp"
 #include "maze_solver/maze_api.hpp"
+#include "maze_solver/maze_display.hpp"
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/recording_backend.hpp"
+#include "maze_solver/replay_backend.hpp"
+#include "maze_solver/shm_backend.hpp"
+#include "maze_solver/solver_snapshot.hpp"
+#include "maze_solver/stdio_backend.hpp"
+#include "maze_solver/strategy_engine.hpp"
 
-int main() {
+#include <array>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+int main(int argc, char *argv[]) {
   maze::MazeControlAPI maze_control_api;
 
+  // The exploration strategy is picked with --strategy NAME. --record FILE
+  // logs the run with the simulator; --replay FILE re-runs a logged run
+  // without it. --shm NAME talks to a simulator serving a shared-memory
+  // channel, falling back to stdio if there is none
+  maze::StrategyKind strategy{maze::StrategyKind::WALL_FOLLOWER};
+  try {
+    std::string record_path;
+    std::string replay_path;
+    std::string channel_name;
+    for (int i = 1; i < argc; ++i) {
+      const std::string_view arg{argv[i]};
+      if (arg == "--strategy" && i + 1 < argc) {
+        strategy = maze::strategy_from_string(argv[++i]);
+      } else if (arg == "--record" && i + 1 < argc) {
+        record_path = argv[++i];
+      } else if (arg == "--replay" && i + 1 < argc) {
+        replay_path = argv[++i];
+      } else if (arg == "--shm" && i + 1 < argc) {
+        channel_name = argv[++i];
+      } else {
+        throw std::invalid_argument("Unknown argument: " + std::string{arg});
+      }
+    }
+    if (!record_path.empty() && !replay_path.empty()) {
+      throw std::invalid_argument("--record and --replay are exclusive");
+    }
+    if (!replay_path.empty() && !channel_name.empty()) {
+      throw std::invalid_argument("--replay and --shm are exclusive");
+    }
+    if (!replay_path.empty()) {
+      maze::MazeControlAPI::set_backend(std::make_unique<maze::ReplayBackend>(replay_path));
+    } else {
+      std::unique_ptr<maze::MazeBackend> simulator;
+      if (!channel_name.empty()) {
+        try {
+          simulator = std::make_unique<maze::SharedMemoryBackend>(channel_name);
+        } catch (const std::runtime_error &e) {
+          maze_control_api.log(std::string{e.what()} + ", falling back to stdio");
+        }
+      }
+      if (!simulator) {
+        simulator = std::make_unique<maze::StdioBackend>();
+      }
+      if (!record_path.empty()) {
+        simulator = std::make_unique<maze::RecordingBackend>(std::move(simulator), record_path);
+      }
+      maze::MazeControlAPI::set_backend(std::move(simulator));
+    }
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << "\nUsage: " << argv[0]
+              << " [--strategy wall-follower|flood-fill|a-star|frontier]"
+                 " [--record FILE | --replay FILE] [--shm NAME]\n";
+    return 1;
+  }
+
   maze_control_api.log("Running...");
+  // The goal cells are the centre of the maze, whatever its size
+  const maze::MazeMap map{maze::MazeMap::from_api()};
+  // Annotations are staged and sent in one go by present()
+  maze::MazeDisplay display{map.width(), map.height()};
+
   maze_control_api.log("Setting start color and text");
-  maze_control_api.set_color(0, 0, 'B');
-  maze_control_api.set_text(0, 0, "start");
+  display.set_color(0, 0, 'B');
+  display.set_text(0, 0, "start");
 
   maze_control_api.log("Setting goal colors and text");
-  maze_control_api.set_color(8, 7, 'R');
-  maze_control_api.set_text(8, 7, "(8,7)");
-  maze_control_api.set_color(7, 7, 'C');
-  maze_control_api.set_text(7, 7, "(7,7)");
-  maze_control_api.set_color(8, 8, 'G');
-  maze_control_api.set_text(8, 8, "(8,8)");
-  maze_control_api.set_color(7, 8, 'O');
-  maze_control_api.set_text(7, 8, "(7,8)");
+  const std::array<char, 4> goal_colors{'R', 'C', 'G', 'O'};
+  const std::vector<int> goals{map.centre_cells()};
+  for (std::size_t i = 0; i < goals.size(); ++i) {
+    const int x{map.x_of(goals[i])};
+    const int y{map.y_of(goals[i])};
+    display.set_color(x, y, goal_colors[i]);
+    display.set_text(
+        x, y, "(" + std::to_string(x) + "," + std::to_string(y) + ")");
+  }
+  display.present();
 
   // Example of how to set a left wall in the simulator
   maze_control_api.set_wall(0, 0, 'w');
@@ -37,21 +118,74 @@ int main() {
   maze_control_api.set_wall(0, 0, 's');
 
   // ==================
-  // Demonstration: Left wall follower
+  // Exploration
   // ==================
-  // The robot will always try to keep its left "hand" on the wall
-  // If it can turn left (no wall), it does so immediately - this ensures it
-  // follows the left wall closely If it can't move forward, it turns right
-  // until it finds an opening It then moves forward and repeats the process
-  // Note: Replace the code below with method calls for BFS
-  while (true) {
-    if (!maze_control_api.has_wall_left()) {
-      maze_control_api.turn_left();
+  // The engine senses the walls, tracks the robot and collects statistics;
+  // the strategy only decides where to go next. The default left wall
+  // follower keeps its left "hand" on the wall: it turns left whenever it
+  // can, else goes straight, else turns right, else turns back.
+  maze_control_api.log("Exploring with the " + std::string{maze::to_string(strategy)} +
+                       " strategy");
+  // Pressing reset in the simulator stops the run: the map learned so far
+  // is captured, the reset acknowledged, and the next run starts from the
+  // start cell with a new engine restored from the snapshot
+  auto engine{std::make_unique<maze::StrategyEngine>(strategy, map.width(), map.height())};
+  engine->watch_resets(true);
+  maze::ExplorationStats stats;
+  try {
+    stats = engine->run();
+    while (stats.interrupted) {
+      const maze::SolverSnapshot learned{engine->snapshot()};
+      maze::MazeControlAPI::ack_reset();
+      maze_control_api.log("Reset after " + std::to_string(stats.steps) +
+                           " steps, restarting with the map learned so far");
+      engine = std::make_unique<maze::StrategyEngine>(strategy, map.width(), map.height());
+      engine->restore(learned);
+      engine->watch_resets(true);
+      stats = engine->run();
     }
+  } catch (const std::exception &e) {
+    maze_control_api.log(e.what());
+    return 1;
+  }
+  maze_control_api.log(std::string{stats.reached_goal ? "Goal reached" : "Goal not reached"} +
+                       ": " + std::to_string(stats.explored_cells) + " cells explored, " +
+                       std::to_string(stats.steps) + " steps, " +
+                       std::to_string(stats.turns) + " turns, " +
+                       std::to_string(stats.seconds) + " s");
+  if (!stats.reached_goal) {
+    maze::MazeControlAPI::set_backend(nullptr);
+    return 2;
+  }
 
-    while (maze_control_api.has_wall_front()) {
-      maze_control_api.turn_right();
+  // ==================
+  // Speed run
+  // ==================
+  // Back to the start, then the fastest known path to the goal, planned by
+  // PathPlanner: each straightaway is a single move_forward(n)
+  maze_control_api.log("Speed run over the explored map");
+  maze::ExplorationStats speed;
+  try {
+    speed = engine->speed_run();
+    while (speed.interrupted) {
+      const maze::SolverSnapshot learned{engine->snapshot()};
+      maze::MazeControlAPI::ack_reset();
+      maze_control_api.log("Reset during the speed run, starting it again");
+      engine = std::make_unique<maze::StrategyEngine>(strategy, map.width(), map.height());
+      engine->restore(learned);
+      engine->watch_resets(true);
+      speed = engine->speed_run();
     }
-    maze_control_api.move_forward();
+  } catch (const std::exception &e) {
+    maze_control_api.log(e.what());
+    return 1;
   }
+  maze_control_api.log(std::string{speed.reached_goal ? "Speed run done" : "Speed run failed"} +
+                       ": " + std::to_string(speed.steps) + " cells in " +
+                       std::to_string(speed.moves) + " moves, " +
+                       std::to_string(speed.turns) + " turns, against " +
+                       std::to_string(stats.steps) + " cells exploring");
+  // Installing the default backend writes out the end of a recorded log
+  maze::MazeControlAPI::set_backend(nullptr);
+  return speed.reached_goal ? 0 : 2;
 }
\ No newline at end of file
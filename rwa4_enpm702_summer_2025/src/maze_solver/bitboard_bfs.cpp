@@ -0,0 +1,157 @@
+#include "maze_solver/bitboard_bfs.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr std::uint64_t kLowBits{0x0101010101010101ULL};
+// Gathers the lowest bit of each byte into the top byte
+constexpr std::uint64_t kGather{0x0102040810204080ULL};
+
+int count_trailing_zeros(std::uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int count{0};
+    while ((word & 1U) == 0) {
+        word >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+} // namespace
+
+void maze::BitboardBfs::load_walls(const MazeMap& map) {
+    width_ = map.width();
+    height_ = map.height();
+    words_per_row_ = (width_ + 63) / 64;
+    const std::size_t words{static_cast<std::size_t>(words_per_row_ * height_)};
+    for (auto& open : open_) {
+        open.assign(words, 0);
+    }
+    visited_.assign(words, 0);
+    frontier_.assign(words, 0);
+    next_.assign(words, 0);
+
+    const std::uint8_t* cells{map.data()};
+    for (int y = 0; y < height_; ++y) {
+        const std::uint8_t* row{cells + static_cast<std::ptrdiff_t>(y) * width_};
+        std::uint64_t* const rows[4]{&open_[0][static_cast<std::size_t>(y * words_per_row_)],
+                                     &open_[1][static_cast<std::size_t>(y * words_per_row_)],
+                                     &open_[2][static_cast<std::size_t>(y * words_per_row_)],
+                                     &open_[3][static_cast<std::size_t>(y * words_per_row_)]};
+        for (int x = 0; x < width_; x += 8) {
+            // Eight cells per load; a short tail is copied byte by byte
+            const int count{std::min(8, width_ - x)};
+            std::uint64_t bytes{0};
+            std::memcpy(&bytes, row + x, static_cast<std::size_t>(count));
+            for (int side = 0; side < 4; ++side) {
+                const std::uint64_t walls{((bytes >> side) & kLowBits) * kGather >> 56};
+                const std::uint64_t open{~walls & ((std::uint64_t{1} << count) - 1)};
+                rows[side][x / 64] |= open << (x % 64);
+            }
+        }
+    }
+}
+
+void maze::BitboardBfs::compute(const MazeMap& map, const std::vector<int>& goals,
+                                std::vector<int>& distances, int unreachable) {
+    load_walls(map);
+    distances.assign(static_cast<std::size_t>(map.cell_count()), unreachable);
+    const int words{words_per_row_};
+    const auto at = [words](int y, int w) { return static_cast<std::size_t>(y * words + w); };
+
+    // Rows holding part of the frontier; rows with no active neighbour row
+    // cannot reach anything new and are skipped
+    std::vector<std::uint8_t>& active{active_rows_};
+    active.assign(static_cast<std::size_t>(height_), 0);
+    next_active_.assign(static_cast<std::size_t>(height_), 0);
+    const auto is_near_frontier = [&active, this](int y) {
+        return active[static_cast<std::size_t>(y)] ||
+               (y > 0 && active[static_cast<std::size_t>(y - 1)]) ||
+               (y + 1 < height_ && active[static_cast<std::size_t>(y + 1)]);
+    };
+
+    int low{height_};
+    int high{-1};
+    for (int goal : goals) {
+        const int x{map.x_of(goal)};
+        const int y{map.y_of(goal)};
+        frontier_[at(y, x / 64)] |= std::uint64_t{1} << (x % 64);
+        visited_[at(y, x / 64)] |= std::uint64_t{1} << (x % 64);
+        distances[static_cast<std::size_t>(goal)] = 0;
+        active[static_cast<std::size_t>(y)] = 1;
+        low = std::min(low, y);
+        high = std::max(high, y);
+    }
+
+    const auto& north{open_[0]};
+    const auto& east{open_[1]};
+    const auto& south{open_[2]};
+    const auto& west{open_[3]};
+    for (int level = 1; low <= high; ++level) {
+        const int first{std::max(0, low - 1)};
+        const int last{std::min(height_ - 1, high + 1)};
+        for (int y = first; y <= last; ++y) {
+            if (!is_near_frontier(y)) {
+                continue;
+            }
+            for (int w = 0; w < words; ++w) {
+                const std::size_t i{at(y, w)};
+                // Moving east shifts bits up, carrying across words
+                std::uint64_t reached{(frontier_[i] & east[i]) << 1};
+                if (w > 0) {
+                    reached |= (frontier_[i - 1] & east[i - 1]) >> 63;
+                }
+                reached |= (frontier_[i] & west[i]) >> 1;
+                if (w + 1 < words) {
+                    reached |= (frontier_[i + 1] & west[i + 1]) << 63;
+                }
+                if (y > 0) {
+                    reached |= frontier_[at(y - 1, w)] & north[at(y - 1, w)];
+                }
+                if (y + 1 < height_) {
+                    reached |= frontier_[at(y + 1, w)] & south[at(y + 1, w)];
+                }
+                next_[i] = reached & ~visited_[i];
+            }
+        }
+
+        // Rows not near the old frontier have no next cells; mark them so
+        // the loop below clears their stale frontier words
+        for (int y = first; y <= last; ++y) {
+            if (!is_near_frontier(y)) {
+                std::fill_n(next_.begin() + static_cast<std::ptrdiff_t>(at(y, 0)), words, 0);
+            }
+        }
+
+        low = height_;
+        high = -1;
+        for (int y = first; y <= last; ++y) {
+            bool reached{false};
+            for (int w = 0; w < words; ++w) {
+                const std::size_t i{at(y, w)};
+                std::uint64_t bits{next_[i]};
+                frontier_[i] = bits;
+                if (bits == 0) {
+                    continue;
+                }
+                reached = true;
+                visited_[i] |= bits;
+                low = std::min(low, y);
+                high = std::max(high, y);
+                const int base{y * width_ + w * 64};
+                while (bits != 0) {
+                    distances[static_cast<std::size_t>(base + count_trailing_zeros(bits))] = level;
+                    bits &= bits - 1;
+                }
+            }
+            next_active_[static_cast<std::size_t>(y)] = reached ? 1 : 0;
+        }
+        for (int y = first; y <= last; ++y) {
+            active[static_cast<std::size_t>(y)] = next_active_[static_cast<std::size_t>(y)];
+        }
+    }
+}
@@ -0,0 +1,308 @@
+#include "maze_solver/exploration_strategy.hpp"
+#include "maze_solver/flood_fill.hpp"
+#include "maze_solver/frontier_queue.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+namespace {
+
+/**
+ * @brief Left-hand wall follower: left, else straight, else right, else back
+ */
+class WallFollower : public maze::ExplorationStrategy {
+public:
+    explicit WallFollower(const maze::MazeMap& map) : map_{map} {}
+
+    std::optional<maze::Heading> next_side(int index, maze::Heading heading) override {
+        for (maze::Heading side : {maze::turned_left(heading), heading,
+                                   maze::turned_right(heading), maze::reversed(heading)}) {
+            if (!map_.has_wall(index, side)) {
+                return side;
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    const maze::MazeMap& map_;
+};
+
+/**
+ * @brief Move to the open neighbour closest to the goal on an incrementally
+ * repaired distance field
+ */
+class FloodFillStrategy : public maze::ExplorationStrategy {
+public:
+    FloodFillStrategy(const maze::MazeMap& map, const std::vector<int>& goals)
+        : field_{map, goals} {}
+
+    FloodFillStrategy(const maze::MazeMap& map, const maze::FloodFill& field)
+        : field_{map, field.goals(), field.distances()} {}
+
+    const maze::FloodFill* field() const override { return &field_; }
+
+    void on_wall_changed(int index, maze::Heading side) override { field_.update(index, side); }
+
+    std::optional<maze::Heading> next_side(int index, maze::Heading heading) override {
+        if (field_.distance(index) == maze::FloodFill::UNREACHABLE) {
+            return std::nullopt;
+        }
+        return field_.best_side(index, heading);
+    }
+
+private:
+    maze::FloodFill field_;
+};
+
+/**
+ * @brief Follow an A* path to the nearest goal, with the Manhattan distance
+ * to the closest goal as heuristic
+ *
+ * The path is only replanned when its next step turns out to be a wall: a
+ * wall seen anywhere else cannot be on the rest of a shortest path, which
+ * never comes back through the robot's cell.
+ */
+class AStarStrategy : public maze::ExplorationStrategy {
+public:
+    AStarStrategy(const maze::MazeMap& map, const std::vector<int>& goals)
+        : map_{map},
+          goals_{goals},
+          cost_(static_cast<std::size_t>(map.cell_count())),
+          parent_(static_cast<std::size_t>(map.cell_count())) {}
+
+    std::optional<maze::Heading> next_side(int index, maze::Heading heading) override {
+        if (path_.empty() || map_.has_wall(index, path_.back())) {
+            plan(index, heading);
+        }
+        if (path_.empty()) {
+            return std::nullopt;
+        }
+        const maze::Heading side{path_.back()};
+        path_.pop_back();
+        return side;
+    }
+
+private:
+    int heuristic(int index) const {
+        int best{std::numeric_limits<int>::max()};
+        for (int goal : goals_) {
+            best = std::min(best, std::abs(map_.x_of(index) - map_.x_of(goal)) +
+                                      std::abs(map_.y_of(index) - map_.y_of(goal)));
+        }
+        return best;
+    }
+
+    /**
+     * @brief Replace the path with a shortest one from a cell to a goal
+     */
+    void plan(int start, maze::Heading heading) {
+        constexpr int kUnvisited{std::numeric_limits<int>::max()};
+        std::fill(cost_.begin(), cost_.end(), kUnvisited);
+        path_.clear();
+
+        // (f, h, cell): on equal f the deeper state, with the smaller h, first
+        using Entry = std::tuple<int, int, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+        cost_[static_cast<std::size_t>(start)] = 0;
+        open.emplace(heuristic(start), heuristic(start), start);
+        int reached{-1};
+        while (!open.empty()) {
+            const auto [f, h, cell] = open.top();
+            open.pop();
+            const int cost{f - h};
+            if (cost > cost_[static_cast<std::size_t>(cell)]) {
+                continue;
+            }
+            if (std::find(goals_.begin(), goals_.end(), cell) != goals_.end()) {
+                reached = cell;
+                break;
+            }
+            // Straight ahead first, so that equal paths avoid a turn
+            for (maze::Heading side : {heading, maze::turned_left(heading),
+                                       maze::turned_right(heading), maze::reversed(heading)}) {
+                if (map_.has_wall(cell, side)) {
+                    continue;
+                }
+                const int next{map_.neighbour(cell, side)};
+                if (cost + 1 < cost_[static_cast<std::size_t>(next)]) {
+                    cost_[static_cast<std::size_t>(next)] = cost + 1;
+                    parent_[static_cast<std::size_t>(next)] = side;
+                    const int next_h{heuristic(next)};
+                    open.emplace(cost + 1 + next_h, next_h, next);
+                }
+            }
+        }
+        // The path is stored goal first, so that the next step is at the back
+        for (int cell = reached; cell >= 0 && cell != start;) {
+            const maze::Heading side{parent_[static_cast<std::size_t>(cell)]};
+            path_.push_back(side);
+            cell = map_.neighbour(cell, maze::reversed(side));
+        }
+    }
+
+    const maze::MazeMap& map_;
+    std::vector<int> goals_;
+    std::vector<int> cost_;              ///< Path length from the start of the search
+    std::vector<maze::Heading> parent_;  ///< Side each cell was entered through
+    std::vector<maze::Heading> path_;    ///< Remaining steps, next one last
+};
+
+/**
+ * @brief Explore the unexplored cells closest to the shortest path first
+ *
+ * Two distance fields are kept up to date, from the start cell and to the
+ * goal; their sum at a cell is the length of the shortest start-to-goal
+ * path through it, assuming unknown walls are open. The robot heads for the
+ * reachable unexplored cell with the smallest sum, the nearest one on a
+ * tie, so it settles the walls that decide the shortest path before any
+ * other. The goal cells are unexplored until reached and lie on every such
+ * path, so the robot ends up there.
+ */
+class FrontierStrategy : public maze::ExplorationStrategy {
+public:
+    FrontierStrategy(const maze::MazeMap& map, const std::vector<int>& goals)
+        : FrontierStrategy{map, maze::FloodFill{map, goals}} {}
+
+    FrontierStrategy(const maze::MazeMap& map, const maze::FloodFill& to_goal)
+        : map_{map},
+          to_goal_{map, to_goal.goals(), to_goal.distances()},
+          from_start_{map, {map.index(0, 0)}},
+          reached_(static_cast<std::size_t>(map.cell_count())),
+          parent_(static_cast<std::size_t>(map.cell_count())),
+          frontier_{map.cell_count()} {}
+
+    const maze::FloodFill* field() const override { return &to_goal_; }
+
+    void on_wall_changed(int index, maze::Heading side) override {
+        to_goal_.update(index, side);
+        from_start_.update(index, side);
+    }
+
+    std::optional<maze::Heading> next_side(int index, maze::Heading heading) override {
+        if (to_goal_.distance(index) == maze::FloodFill::UNREACHABLE) {
+            return std::nullopt;
+        }
+        // BFS from the robot; the first unexplored cell reached at the
+        // smallest sum is the nearest of them
+        std::fill(reached_.begin(), reached_.end(), 0);
+        reached_[static_cast<std::size_t>(index)] = 1;
+        frontier_.clear();
+        frontier_.push(index);
+        int target{-1};
+        long target_sum{std::numeric_limits<long>::max()};
+        while (!frontier_.empty()) {
+            const int cell{frontier_.front()};
+            frontier_.pop();
+            if (!map_.is_explored(cell) && path_length(cell) < target_sum) {
+                target = cell;
+                target_sum = path_length(cell);
+            }
+            for (maze::Heading side : {heading, maze::turned_left(heading),
+                                       maze::turned_right(heading), maze::reversed(heading)}) {
+                if (map_.has_wall(cell, side)) {
+                    continue;
+                }
+                const int next{map_.neighbour(cell, side)};
+                if (!reached_[static_cast<std::size_t>(next)]) {
+                    reached_[static_cast<std::size_t>(next)] = 1;
+                    parent_[static_cast<std::size_t>(next)] = side;
+                    frontier_.push(next);
+                }
+            }
+        }
+        if (target < 0) {
+            // Everything reachable is explored: take the shortest path
+            return to_goal_.best_side(index, heading);
+        }
+        maze::Heading side{heading};
+        for (int cell = target; cell != index;) {
+            side = parent_[static_cast<std::size_t>(cell)];
+            cell = map_.neighbour(cell, maze::reversed(side));
+        }
+        return side;
+    }
+
+private:
+    /**
+     * @brief Length of the shortest start-to-goal path through a cell
+     */
+    long path_length(int index) const {
+        const int to_goal{to_goal_.distance(index)};
+        const int from_start{from_start_.distance(index)};
+        if (to_goal == maze::FloodFill::UNREACHABLE || from_start == maze::FloodFill::UNREACHABLE) {
+            return std::numeric_limits<long>::max();
+        }
+        return static_cast<long>(to_goal) + from_start;
+    }
+
+    const maze::MazeMap& map_;
+    maze::FloodFill to_goal_;             ///< Distance of each cell to the goal
+    maze::FloodFill from_start_;          ///< Distance of each cell from the start
+    std::vector<std::uint8_t> reached_;   ///< Cells reached by the BFS
+    std::vector<maze::Heading> parent_;   ///< Side each cell was entered through
+    maze::FrontierQueue frontier_;        ///< BFS frontier
+};
+
+} // namespace
+
+std::string_view maze::to_string(StrategyKind kind) {
+    switch (kind) {
+    case StrategyKind::WALL_FOLLOWER:
+        return "wall-follower";
+    case StrategyKind::FLOOD_FILL:
+        return "flood-fill";
+    case StrategyKind::A_STAR:
+        return "a-star";
+    case StrategyKind::FRONTIER:
+        return "frontier";
+    }
+    return "unknown";
+}
+
+maze::StrategyKind maze::strategy_from_string(std::string_view name) {
+    for (StrategyKind kind : ALL_STRATEGIES) {
+        if (to_string(kind) == name) {
+            return kind;
+        }
+    }
+    throw std::invalid_argument("Unknown strategy: " + std::string{name});
+}
+
+std::unique_ptr<maze::ExplorationStrategy> maze::make_strategy(StrategyKind kind,
+                                                               const MazeMap& map,
+                                                               const std::vector<int>& goals) {
+    switch (kind) {
+    case StrategyKind::WALL_FOLLOWER:
+        return std::make_unique<WallFollower>(map);
+    case StrategyKind::FLOOD_FILL:
+        return std::make_unique<FloodFillStrategy>(map, goals);
+    case StrategyKind::A_STAR:
+        return std::make_unique<AStarStrategy>(map, goals);
+    case StrategyKind::FRONTIER:
+        return std::make_unique<FrontierStrategy>(map, goals);
+    }
+    throw std::invalid_argument("Unknown strategy");
+}
+
+std::unique_ptr<maze::ExplorationStrategy> maze::make_strategy(StrategyKind kind,
+                                                               const MazeMap& map,
+                                                               const std::vector<int>& goals,
+                                                               const FloodFill& field) {
+    switch (kind) {
+    case StrategyKind::FLOOD_FILL:
+        return std::make_unique<FloodFillStrategy>(map, field);
+    case StrategyKind::FRONTIER:
+        return std::make_unique<FrontierStrategy>(map, field);
+    case StrategyKind::WALL_FOLLOWER:
+    case StrategyKind::A_STAR:
+        break;
+    }
+    return make_strategy(kind, map, goals);
+}
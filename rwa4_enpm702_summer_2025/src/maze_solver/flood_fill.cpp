@@ -0,0 +1,229 @@
+#include "maze_solver/flood_fill.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr maze::Heading kSides[]{maze::Heading::NORTH, maze::Heading::EAST,
+                                 maze::Heading::SOUTH, maze::Heading::WEST};
+
+} // namespace
+
+maze::FloodFill::FloodFill(const MazeMap& map, std::vector<int> goals)
+    : map_{map},
+      goals_{std::move(goals)},
+      distances_(static_cast<std::size_t>(map.cell_count()), UNREACHABLE),
+      is_goal_(static_cast<std::size_t>(map.cell_count()), 0),
+      invalid_(static_cast<std::size_t>(map.cell_count()), 0),
+      frontier_{map.cell_count()} {
+    for (int goal : goals_) {
+        is_goal_[static_cast<std::size_t>(goal)] = 1;
+    }
+    recompute();
+}
+
+maze::FloodFill::FloodFill(const MazeMap& map, std::vector<int> goals,
+                           const std::vector<int>& distances)
+    : map_{map},
+      goals_{std::move(goals)},
+      distances_(static_cast<std::size_t>(map.cell_count()), UNREACHABLE),
+      is_goal_(static_cast<std::size_t>(map.cell_count()), 0),
+      invalid_(static_cast<std::size_t>(map.cell_count()), 0),
+      frontier_{map.cell_count()} {
+    for (int goal : goals_) {
+        is_goal_[static_cast<std::size_t>(goal)] = 1;
+    }
+    restore(distances);
+}
+
+void maze::FloodFill::restore(const std::vector<int>& distances) {
+    if (distances.size() != distances_.size()) {
+        throw std::invalid_argument("Distances do not match the maze dimensions");
+    }
+    distances_ = distances;
+}
+
+void maze::FloodFill::recompute() {
+    if (engine_ == BfsEngine::BITBOARD) {
+        bitboard_.compute(map_, goals_, distances_, UNREACHABLE);
+        cells_updated_ += static_cast<long>(distances_.size());
+        return;
+    }
+    std::fill(distances_.begin(), distances_.end(), UNREACHABLE);
+    cells_updated_ += static_cast<long>(distances_.size());
+    for (int goal : goals_) {
+        write(goal, 0);
+        frontier_.push(goal);
+    }
+    while (!frontier_.empty()) {
+        const int cell{frontier_.front()};
+        frontier_.pop();
+        const int next{distance(cell) + 1};
+        for (Heading side : kSides) {
+            if (!is_open(cell, side)) {
+                continue;
+            }
+            const int neighbour{map_.neighbour(cell, side)};
+            if (distance(neighbour) == UNREACHABLE) {
+                write(neighbour, next);
+                frontier_.push(neighbour);
+            }
+        }
+    }
+}
+
+void maze::FloodFill::update(int index, Heading side) {
+    if (!map_.contains(map_.x_of(index) + dx(side), map_.y_of(index) + dy(side))) {
+        return;
+    }
+    const int other{map_.neighbour(index, side)};
+    if (is_open(index, side)) {
+        // An opening can only shorten the path of the farther cell
+        for (auto [from, to] : {std::pair{index, other}, std::pair{other, index}}) {
+            if (distance(from) != UNREACHABLE && distance(from) + 1 < distance(to)) {
+                write(to, distance(from) + 1);
+                lower(to);
+            }
+        }
+        return;
+    }
+    // A wall can only lengthen the path of a cell that relied on it
+    for (int cell : {index, other}) {
+        const std::size_t i{static_cast<std::size_t>(cell)};
+        if (!is_goal_[i] && distance(cell) != UNREACHABLE && !is_supported(cell)) {
+            raise(cell);
+        }
+    }
+}
+
+bool maze::FloodFill::is_supported(int index) const {
+    const int closer{distance(index) - 1};
+    for (Heading side : kSides) {
+        if (!is_open(index, side)) {
+            continue;
+        }
+        const int neighbour{map_.neighbour(index, side)};
+        if (!invalid_[static_cast<std::size_t>(neighbour)] && distance(neighbour) == closer) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void maze::FloodFill::lower(int index) {
+    frontier_.push(index);
+    while (!frontier_.empty()) {
+        const int cell{frontier_.front()};
+        frontier_.pop();
+        const int next{distance(cell) + 1};
+        for (Heading side : kSides) {
+            if (!is_open(cell, side)) {
+                continue;
+            }
+            const int neighbour{map_.neighbour(cell, side)};
+            if (next < distance(neighbour)) {
+                write(neighbour, next);
+                frontier_.push(neighbour);
+            }
+        }
+    }
+}
+
+void maze::FloodFill::raise(int index) {
+    // Phase 1: invalidate every cell left without a valid neighbour one step
+    // closer to the goal. Distances are kept until phase 2 so that the
+    // dependants of each invalidated cell can still be recognised.
+    invalidated_.clear();
+    pending_.assign(1, index);
+    invalid_[static_cast<std::size_t>(index)] = 1;
+    while (!pending_.empty()) {
+        const int cell{pending_.back()};
+        pending_.pop_back();
+        invalidated_.push_back(cell);
+        const int dependant_distance{distance(cell) + 1};
+        for (Heading side : kSides) {
+            if (!is_open(cell, side)) {
+                continue;
+            }
+            const int neighbour{map_.neighbour(cell, side)};
+            const std::size_t i{static_cast<std::size_t>(neighbour)};
+            if (!invalid_[i] && !is_goal_[i] && distance(neighbour) == dependant_distance &&
+                !is_supported(neighbour)) {
+                invalid_[i] = 1;
+                pending_.push_back(neighbour);
+            }
+        }
+    }
+
+    // Phase 2: seed each invalidated cell from its valid neighbours, then
+    // flood the invalidated region in order of increasing distance
+    seeds_.clear();
+    for (int cell : invalidated_) {
+        int best{UNREACHABLE};
+        for (Heading side : kSides) {
+            if (!is_open(cell, side)) {
+                continue;
+            }
+            const int neighbour{map_.neighbour(cell, side)};
+            if (!invalid_[static_cast<std::size_t>(neighbour)] &&
+                distance(neighbour) != UNREACHABLE) {
+                best = std::min(best, distance(neighbour) + 1);
+            }
+        }
+        write(cell, best);
+        if (best != UNREACHABLE) {
+            seeds_.emplace_back(best, cell);
+        }
+    }
+    std::sort(seeds_.begin(), seeds_.end());
+
+    std::size_t next_seed{0};
+    while (next_seed < seeds_.size() || !frontier_.empty()) {
+        int cell;
+        if (frontier_.empty() ||
+            (next_seed < seeds_.size() && seeds_[next_seed].first <= distance(frontier_.front()))) {
+            const auto [seed_distance, seed] = seeds_[next_seed++];
+            if (seed_distance != distance(seed)) {
+                continue; // Reached through a shorter path since seeding
+            }
+            cell = seed;
+        } else {
+            cell = frontier_.front();
+            frontier_.pop();
+        }
+        const int next{distance(cell) + 1};
+        for (Heading side : kSides) {
+            if (!is_open(cell, side)) {
+                continue;
+            }
+            const int neighbour{map_.neighbour(cell, side)};
+            if (invalid_[static_cast<std::size_t>(neighbour)] && next < distance(neighbour)) {
+                write(neighbour, next);
+                frontier_.push(neighbour);
+            }
+        }
+    }
+
+    for (int cell : invalidated_) {
+        invalid_[static_cast<std::size_t>(cell)] = 0;
+    }
+}
+
+maze::Heading maze::FloodFill::best_side(int index, Heading preferred) const {
+    Heading best{preferred};
+    int best_distance{UNREACHABLE};
+    if (is_open(index, preferred)) {
+        best_distance = distance(map_.neighbour(index, preferred));
+    }
+    for (Heading side : kSides) {
+        if (!is_open(index, side)) {
+            continue;
+        }
+        const int candidate{distance(map_.neighbour(index, side))};
+        if (candidate < best_distance) {
+            best = side;
+            best_distance = candidate;
+        }
+    }
+    return best;
+}
@@ -0,0 +1,142 @@
+#include "maze_solver/instrumentation.hpp"
+
+#ifdef MAZE_API_INSTRUMENTATION
+#include <algorithm>
+#include <csignal>
+#include <iomanip>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+// Set by the SIGUSR1 handler; the report is written by the next API call,
+// since writing to a stream is not allowed inside a signal handler
+volatile std::sig_atomic_t dump_requested{0};
+
+extern "C" void request_dump(int) { dump_requested = 1; }
+
+constexpr std::array<std::string_view, static_cast<std::size_t>(maze::ApiCommand::COUNT)>
+    kCommandNames{"get_maze_width", "get_maze_height", "has_wall_front",
+                  "has_wall_right", "has_wall_left",   "sense_walls",
+                  "query_wall",     "move_forward",    "turn_right",
+                  "turn_left",      "set_wall",        "clear_wall",
+                  "set_color",      "clear_color",     "clear_all_color",
+                  "set_text",       "clear_text",      "clear_all_text",
+                  "was_reset",      "ack_reset",       "flush"};
+
+int highest_bit(std::uint64_t value) { return 63 - __builtin_clzll(value); }
+
+} // namespace
+
+std::size_t maze::LatencyHistogram::bucket_of(std::uint64_t value) {
+    constexpr std::uint64_t sub_buckets{1u << SUB_BUCKET_BITS};
+    if (value < sub_buckets) {
+        return static_cast<std::size_t>(value);
+    }
+    // The top bit selects the power of two, the next SUB_BUCKET_BITS bits the
+    // linear sub-bucket within it
+    const int exponent{highest_bit(value)};
+    const std::uint64_t sub{(value >> (exponent - SUB_BUCKET_BITS)) & (sub_buckets - 1)};
+    return (static_cast<std::size_t>(exponent - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) +
+           static_cast<std::size_t>(sub);
+}
+
+std::uint64_t maze::LatencyHistogram::upper_bound_of(std::size_t bucket) {
+    constexpr std::uint64_t sub_buckets{1u << SUB_BUCKET_BITS};
+    if (bucket < sub_buckets) {
+        return bucket;
+    }
+    const int shift{static_cast<int>(bucket >> SUB_BUCKET_BITS) - 1};
+    const std::uint64_t lower{(sub_buckets + (bucket & (sub_buckets - 1))) << shift};
+    return lower + ((std::uint64_t{1} << shift) - 1);
+}
+
+void maze::LatencyHistogram::record(std::uint64_t nanoseconds) {
+    buckets_[bucket_of(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(nanoseconds, std::memory_order_relaxed);
+    std::uint64_t seen{max_.load(std::memory_order_relaxed)};
+    while (nanoseconds > seen &&
+           !max_.compare_exchange_weak(seen, nanoseconds, std::memory_order_relaxed)) {
+    }
+}
+
+std::uint64_t maze::LatencyHistogram::count() const {
+    std::uint64_t total{0};
+    for (const auto& bucket : buckets_) {
+        total += bucket.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+std::uint64_t maze::LatencyHistogram::percentile(double quantile) const {
+    const std::uint64_t recorded{count()};
+    if (recorded == 0) {
+        return 0;
+    }
+    // Rank of the quantile, counted from 1
+    const auto rank{static_cast<std::uint64_t>(quantile * static_cast<double>(recorded - 1)) + 1};
+    std::uint64_t seen{0};
+    for (std::size_t i = 0; i < BUCKETS; ++i) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            return std::min(upper_bound_of(i), max());
+        }
+    }
+    return max();
+}
+
+maze::Instrumentation::Instrumentation() { std::signal(SIGUSR1, request_dump); }
+
+maze::Instrumentation::~Instrumentation() { dump(std::cerr); }
+
+maze::Instrumentation& maze::Instrumentation::instance() {
+    static Instrumentation instrumentation;
+    return instrumentation;
+}
+
+void maze::Instrumentation::record(ApiCommand command, std::uint64_t nanoseconds) {
+    histograms_[static_cast<std::size_t>(command)].record(nanoseconds);
+    if (dump_requested) {
+        dump_requested = 0;
+        dump(std::cerr);
+    }
+}
+
+void maze::Instrumentation::dump(std::ostream& out) const {
+    out << "=== MazeControlAPI instrumentation ===\n"
+        << "bytes written: " << bytes_written_.load(std::memory_order_relaxed)
+        << ", bytes read: " << bytes_read_.load(std::memory_order_relaxed) << '\n'
+        << std::left << std::setw(18) << "command" << std::right << std::setw(10) << "calls"
+        << std::setw(12) << "mean (us)" << std::setw(12) << "p50 (us)" << std::setw(12)
+        << "p90 (us)" << std::setw(12) << "p99 (us)" << std::setw(12) << "max (us)" << '\n';
+    const auto micros{[](std::uint64_t nanoseconds) {
+        return static_cast<double>(nanoseconds) / 1e3;
+    }};
+    const auto flags{out.flags()};
+    const auto precision{out.precision()};
+    out << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < histograms_.size(); ++i) {
+        const LatencyHistogram& histogram{histograms_[i]};
+        const std::uint64_t calls{histogram.count()};
+        if (calls == 0) {
+            continue;
+        }
+        out << std::left << std::setw(18) << kCommandNames[i] << std::right << std::setw(10)
+            << calls << std::setw(12) << micros(histogram.total()) / static_cast<double>(calls)
+            << std::setw(12) << micros(histogram.percentile(0.50)) << std::setw(12)
+            << micros(histogram.percentile(0.90)) << std::setw(12)
+            << micros(histogram.percentile(0.99)) << std::setw(12) << micros(histogram.max())
+            << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
+
+maze::ApiProbe::~ApiProbe() {
+    const auto elapsed{std::chrono::steady_clock::now() - start_};
+    Instrumentation::instance().record(
+        command_, static_cast<std::uint64_t>(
+                      std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
+
+#endif
@@ -1,113 +1,145 @@
 #include "maze_solver/maze_api.hpp"
-#include <cstdlib>
+#include "maze_solver/instrumentation.hpp"
+#include "maze_solver/maze_backend.hpp"
+#include "maze_solver/stdio_backend.hpp"
 #include <iostream>
 
+namespace {
+
+// One backend per thread, so that several solvers can run side by side
+std::unique_ptr<maze::MazeBackend>& active_backend() {
+    thread_local std::unique_ptr<maze::MazeBackend> instance{std::make_unique<maze::StdioBackend>()};
+    return instance;
+}
+
+} // namespace
+
 int maze::MazeControlAPI::get_maze_width() {
-    std::cout << "mazeWidth\n";
-    std::string response;
-    std::cin >> response;
-    return atoi(response.c_str());
+    MAZE_API_PROBE(GET_MAZE_WIDTH);
+    return backend().get_maze_width();
 }
 
 int maze::MazeControlAPI::get_maze_height() {
-    std::cout << "mazeHeight\n";
-    std::string response;
-    std::cin >> response;
-    return atoi(response.c_str());
+    MAZE_API_PROBE(GET_MAZE_HEIGHT);
+    return backend().get_maze_height();
 }
 
 bool maze::MazeControlAPI::has_wall_front() {
-    std::cout << "wallFront\n";
-    std::string response;
-    std::cin >> response;
-    return response == "true";
+    MAZE_API_PROBE(HAS_WALL_FRONT);
+    return backend().has_wall_front();
 }
 
 bool maze::MazeControlAPI::has_wall_right() {
-    std::cout << "wallRight\n";
-    std::string response;
-    std::cin >> response;
-    return response == "true";
+    MAZE_API_PROBE(HAS_WALL_RIGHT);
+    return backend().has_wall_right();
 }
 
 bool maze::MazeControlAPI::has_wall_left() {
-    std::cout << "wallLeft\n";
-    std::string response;
-    std::cin >> response;
-    return response == "true";
+    MAZE_API_PROBE(HAS_WALL_LEFT);
+    return backend().has_wall_left();
 }
 
 void maze::MazeControlAPI::move_forward(int distance) {
-    std::cout << "moveForward ";
-    // Don't print distance argument unless explicitly specified, for
-    // backwards compatibility with older versions of the simulator
-    if (distance != 1) {
-        std::cout << distance;
-    }
-    std::cout << std::endl;
-    std::string response;
-    std::cin >> response;
-    if (response != "ack") {
-        std::cerr << response << std::endl;
-        throw;
-    }
+    MAZE_API_PROBE(MOVE_FORWARD);
+    backend().move_forward(distance);
 }
 
 void maze::MazeControlAPI::turn_right() {
-    std::cout << "turnRight\n";
-    std::string ack;
-    std::cin >> ack;
+    MAZE_API_PROBE(TURN_RIGHT);
+    backend().turn_right();
 }
 
 void maze::MazeControlAPI::turn_left() {
-    std::cout << "turnLeft\n";
-    std::string ack;
-    std::cin >> ack;
+    MAZE_API_PROBE(TURN_LEFT);
+    backend().turn_left();
 }
 
 void maze::MazeControlAPI::set_wall(int x, int y, char direction) {
-    std::cout << "setWall " << x << " " << y << " " << direction << std::endl;
+    MAZE_API_PROBE(SET_WALL);
+    backend().set_wall(x, y, direction);
 }
 
 void maze::MazeControlAPI::clear_wall(int x, int y, char direction) {
-    std::cout << "clearWall " << x << " " << y << " " << direction << std::endl;
+    MAZE_API_PROBE(CLEAR_WALL);
+    backend().clear_wall(x, y, direction);
 }
 
 void maze::MazeControlAPI::set_color(int x, int y, char color) {
-    std::cout << "setColor " << x << " " << y << " " << color << std::endl;
+    MAZE_API_PROBE(SET_COLOR);
+    backend().set_color(x, y, color);
 }
 
 void maze::MazeControlAPI::clear_color(int x, int y) {
-    std::cout << "clearColor " << x << " " << y << std::endl;
+    MAZE_API_PROBE(CLEAR_COLOR);
+    backend().clear_color(x, y);
 }
 
 void maze::MazeControlAPI::clear_all_color() {
-    std::cout << "clearAllColor\n";
+    MAZE_API_PROBE(CLEAR_ALL_COLOR);
+    backend().clear_all_color();
 }
 
 void maze::MazeControlAPI::set_text(int x, int y, const std::string& text) {
-    std::cout << "setText " << x << " " << y << " " << text << std::endl;
+    MAZE_API_PROBE(SET_TEXT);
+    backend().set_text(x, y, text);
 }
 
 void maze::MazeControlAPI::clear_text(int x, int y) {
-    std::cout << "clearText " << x << " " << y << std::endl;
+    MAZE_API_PROBE(CLEAR_TEXT);
+    backend().clear_text(x, y);
 }
 
 void maze::MazeControlAPI::clear_all_text() {
-    std::cout << "clearAllText\n";
+    MAZE_API_PROBE(CLEAR_ALL_TEXT);
+    backend().clear_all_text();
 }
 
 bool maze::MazeControlAPI::was_reset() {
-    std::cout << "wasReset\n";
-    std::string response;
-    std::cin >> response;
-    return response == "true";
+    MAZE_API_PROBE(WAS_RESET);
+    return backend().was_reset();
 }
 
 void maze::MazeControlAPI::ack_reset() {
-    std::cout << "ackReset\n";
-    std::string ack;
-    std::cin >> ack;
+    MAZE_API_PROBE(ACK_RESET);
+    backend().ack_reset();
 }
 
 void maze::MazeControlAPI::log(std::string_view text) { std::cerr << text << '\n'; }
+
+void maze::MazeControlAPI::set_batching(bool enabled) { backend().set_batching(enabled); }
+
+bool maze::MazeControlAPI::is_batching() { return backend().is_batching(); }
+
+void maze::MazeControlAPI::flush() {
+    MAZE_API_PROBE(FLUSH);
+    backend().flush();
+}
+
+maze::WallReadings maze::MazeControlAPI::sense_walls() {
+    MAZE_API_PROBE(SENSE_WALLS);
+    return backend().sense_walls();
+}
+
+maze::WallFuture maze::MazeControlAPI::has_wall_front_async() {
+    MAZE_API_PROBE(QUERY_WALL);
+    return backend().query_wall(WallSide::FRONT);
+}
+
+maze::WallFuture maze::MazeControlAPI::has_wall_right_async() {
+    MAZE_API_PROBE(QUERY_WALL);
+    return backend().query_wall(WallSide::RIGHT);
+}
+
+maze::WallFuture maze::MazeControlAPI::has_wall_left_async() {
+    MAZE_API_PROBE(QUERY_WALL);
+    return backend().query_wall(WallSide::LEFT);
+}
+
+void maze::MazeControlAPI::set_backend(std::unique_ptr<MazeBackend> backend) {
+    if (!backend) {
+        backend = std::make_unique<StdioBackend>();
+    }
+    active_backend() = std::move(backend);
+}
+
+maze::MazeBackend& maze::MazeControlAPI::backend() { return *active_backend(); }
@@ -0,0 +1,178 @@
+#include "maze_solver/maze_corpus.hpp"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic{'M', 'A', 'Z', 'E', 'C', 'O', 'R', 'P'};
+constexpr std::uint32_t kVersion{1};
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t count;
+    std::uint64_t index_offset;
+};
+
+struct RecordHeader {
+    std::uint16_t width;
+    std::uint16_t height;
+    std::uint8_t goal_count;
+    std::array<std::uint8_t, 3> reserved;
+    std::array<std::uint32_t, maze::MazeView::MAX_GOALS> goals;
+};
+
+static_assert(sizeof(FileHeader) == 24, "Corpus header must have no padding");
+static_assert(sizeof(RecordHeader) == 24, "Record header must have no padding");
+
+constexpr std::size_t kAlignment{8};
+
+std::size_t aligned(std::size_t size) { return (size + kAlignment - 1) / kAlignment * kAlignment; }
+
+} // namespace
+
+maze::MazeCorpus::MazeCorpus(const std::uint8_t* data, std::size_t size)
+    : data_{data}, size_{size} {
+    FileHeader header;
+    if (size_ < sizeof header) {
+        throw std::runtime_error("Maze corpus is too short");
+    }
+    std::memcpy(&header, data_, sizeof header);
+    if (header.magic != kMagic || header.version != kVersion) {
+        throw std::runtime_error("Not a maze corpus, or an unsupported version");
+    }
+    count_ = header.count;
+    if (header.index_offset % kAlignment != 0 || header.index_offset > size_ ||
+        (size_ - header.index_offset) / sizeof(std::uint64_t) < count_) {
+        throw std::runtime_error("Maze corpus index is out of bounds");
+    }
+    offsets_ = reinterpret_cast<const std::uint64_t*>(data_ + header.index_offset);
+
+    // Checked once here, so that operator[] needs no checks
+    for (std::size_t i = 0; i < count_; ++i) {
+        const std::uint64_t offset{offsets_[i]};
+        if (offset % kAlignment != 0 || offset > size_ || size_ - offset < sizeof(RecordHeader)) {
+            throw std::runtime_error("Maze corpus record is out of bounds");
+        }
+        const auto* record{reinterpret_cast<const RecordHeader*>(data_ + offset)};
+        const std::size_t cells{static_cast<std::size_t>(record->width) * record->height};
+        if (cells == 0 || size_ - offset - sizeof(RecordHeader) < cells ||
+            record->goal_count > MazeView::MAX_GOALS) {
+            throw std::runtime_error("Maze corpus record is malformed");
+        }
+        for (std::size_t g = 0; g < record->goal_count; ++g) {
+            if (record->goals[g] >= cells) {
+                throw std::runtime_error("Maze corpus goal is out of the maze");
+            }
+        }
+    }
+}
+
+maze::MazeCorpus maze::MazeCorpus::open(const std::string& path) {
+    const int fd{::open(path.c_str(), O_RDONLY)};
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open maze corpus " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot read maze corpus " + path);
+    }
+    const auto size{static_cast<std::size_t>(info.st_size)};
+    void* mapping{::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)};
+    // The mapping stays valid once the descriptor is closed
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Cannot map maze corpus " + path);
+    }
+    try {
+        return MazeCorpus{static_cast<const std::uint8_t*>(mapping), size};
+    } catch (const std::runtime_error& e) {
+        ::munmap(mapping, size);
+        throw std::runtime_error(std::string{e.what()} + ": " + path);
+    }
+}
+
+void maze::MazeCorpus::write(const std::string& path, const std::vector<MazeMap>& mazes) {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    if (!out) {
+        throw std::runtime_error("Cannot create maze corpus " + path);
+    }
+    std::vector<std::uint64_t> offsets;
+    offsets.reserve(mazes.size());
+    std::uint64_t offset{sizeof(FileHeader)};
+    for (const MazeMap& map : mazes) {
+        offsets.push_back(offset);
+        offset += sizeof(RecordHeader) + aligned(static_cast<std::size_t>(map.cell_count()));
+    }
+
+    FileHeader header{kMagic, kVersion, static_cast<std::uint32_t>(mazes.size()), offset};
+    out.write(reinterpret_cast<const char*>(&header), sizeof header);
+    const std::array<char, kAlignment> padding{};
+    for (const MazeMap& map : mazes) {
+        if (map.width() > UINT16_MAX || map.height() > UINT16_MAX) {
+            throw std::runtime_error("Maze is too large for a maze corpus");
+        }
+        RecordHeader record{};
+        record.width = static_cast<std::uint16_t>(map.width());
+        record.height = static_cast<std::uint16_t>(map.height());
+        const std::vector<int> goals{map.centre_cells()};
+        record.goal_count = static_cast<std::uint8_t>(goals.size());
+        for (std::size_t g = 0; g < goals.size(); ++g) {
+            record.goals[g] = static_cast<std::uint32_t>(goals[g]);
+        }
+        out.write(reinterpret_cast<const char*>(&record), sizeof record);
+        const auto cells{static_cast<std::size_t>(map.cell_count())};
+        out.write(reinterpret_cast<const char*>(map.data()), static_cast<std::streamsize>(cells));
+        out.write(padding.data(), static_cast<std::streamsize>(aligned(cells) - cells));
+    }
+    out.write(reinterpret_cast<const char*>(offsets.data()),
+              static_cast<std::streamsize>(offsets.size() * sizeof(std::uint64_t)));
+    if (!out) {
+        throw std::runtime_error("Cannot write maze corpus " + path);
+    }
+}
+
+maze::MazeCorpus::MazeCorpus(MazeCorpus&& other) noexcept
+    : data_{std::exchange(other.data_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      count_{std::exchange(other.count_, 0)},
+      offsets_{std::exchange(other.offsets_, nullptr)} {}
+
+maze::MazeCorpus& maze::MazeCorpus::operator=(MazeCorpus&& other) noexcept {
+    if (this != &other) {
+        if (data_ != nullptr) {
+            ::munmap(const_cast<std::uint8_t*>(data_), size_);
+        }
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        count_ = std::exchange(other.count_, 0);
+        offsets_ = std::exchange(other.offsets_, nullptr);
+    }
+    return *this;
+}
+
+maze::MazeCorpus::~MazeCorpus() {
+    if (data_ != nullptr) {
+        ::munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+}
+
+maze::MazeView maze::MazeCorpus::operator[](std::size_t i) const {
+    const std::uint8_t* record_data{data_ + offsets_[i]};
+    const auto* record{reinterpret_cast<const RecordHeader*>(record_data)};
+    std::array<int, MazeView::MAX_GOALS> goals{};
+    for (std::size_t g = 0; g < record->goal_count; ++g) {
+        goals[g] = static_cast<int>(record->goals[g]);
+    }
+    return MazeView{record->width, record->height, record_data + sizeof(RecordHeader), goals,
+                    record->goal_count};
+}
@@ -0,0 +1,76 @@
+#include "maze_solver/maze_display.hpp"
+#include "maze_solver/maze_api.hpp"
+#include <array>
+#include <charconv>
+#include <stdexcept>
+
+maze::MazeDisplay::MazeDisplay(int width, int height) : width_{width} {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Maze dimensions must be positive");
+    }
+    const std::size_t cells{static_cast<std::size_t>(width) * static_cast<std::size_t>(height)};
+    shown_.resize(cells);
+    staged_.resize(cells);
+    dirty_.resize(cells, false);
+}
+
+void maze::MazeDisplay::touch(std::size_t index) {
+    ++requested_;
+    if (!dirty_[index]) {
+        dirty_[index] = true;
+        dirty_cells_.push_back(index);
+    }
+}
+
+void maze::MazeDisplay::set_color(int x, int y, char color) {
+    const std::size_t i{index(x, y)};
+    staged_[i].color = color;
+    touch(i);
+}
+
+void maze::MazeDisplay::set_text(int x, int y, std::string_view text) {
+    const std::size_t i{index(x, y)};
+    staged_[i].text.assign(text);
+    touch(i);
+}
+
+void maze::MazeDisplay::set_text(int x, int y, int value) {
+    std::array<char, 16> digits;
+    const auto result{std::to_chars(digits.data(), digits.data() + digits.size(), value)};
+    set_text(x, y, std::string_view{digits.data(), static_cast<std::size_t>(result.ptr - digits.data())});
+}
+
+int maze::MazeDisplay::present() {
+    int sent{0};
+    for (std::size_t i : dirty_cells_) {
+        dirty_[i] = false;
+        Cell& shown{shown_[i]};
+        const Cell& staged{staged_[i]};
+        const int x{static_cast<int>(i) % width_};
+        const int y{static_cast<int>(i) / width_};
+        if (staged.color != shown.color) {
+            if (staged.color == NO_COLOR) {
+                MazeControlAPI::clear_color(x, y);
+            } else {
+                MazeControlAPI::set_color(x, y, staged.color);
+            }
+            shown.color = staged.color;
+            ++sent;
+        }
+        if (staged.text != shown.text) {
+            if (staged.text.empty()) {
+                MazeControlAPI::clear_text(x, y);
+            } else {
+                MazeControlAPI::set_text(x, y, staged.text);
+            }
+            shown.text = staged.text;
+            ++sent;
+        }
+    }
+    dirty_cells_.clear();
+    if (sent > 0) {
+        MazeControlAPI::flush();
+    }
+    emitted_ += sent;
+    return sent;
+}
@@ -0,0 +1,207 @@
+#include "maze_solver/maze_generator.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr maze::Heading kSides[]{maze::Heading::NORTH, maze::Heading::EAST,
+                                 maze::Heading::SOUTH, maze::Heading::WEST};
+
+// Maze with every wall standing
+maze::MazeMap closed_maze(int width, int height) {
+    maze::MazeMap map{width, height};
+    for (int index = 0; index < map.cell_count(); ++index) {
+        map.set_cell_walls(index, maze::MazeMap::WALL_MASK);
+    }
+    return map;
+}
+
+bool is_inner(const maze::MazeMap& map, int index, maze::Heading side) {
+    return map.contains(map.x_of(index) + maze::dx(side), map.y_of(index) + maze::dy(side));
+}
+
+bool is_dead_end(const maze::MazeMap& map, int index) {
+    int walls{0};
+    for (maze::Heading side : kSides) {
+        walls += map.has_wall(index, side) ? 1 : 0;
+    }
+    return walls == 3;
+}
+
+/**
+ * @brief Disjoint sets of cells, with path halving and union by size
+ */
+class UnionFind {
+public:
+    explicit UnionFind(int count)
+        : parent_(static_cast<std::size_t>(count)), size_(static_cast<std::size_t>(count), 1) {
+        std::iota(parent_.begin(), parent_.end(), 0);
+    }
+
+    int find(int item) {
+        while (parent_[static_cast<std::size_t>(item)] != item) {
+            int& parent{parent_[static_cast<std::size_t>(item)]};
+            parent = parent_[static_cast<std::size_t>(parent)];
+            item = parent;
+        }
+        return item;
+    }
+
+    /// @return false if both were already in the same set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (size_[static_cast<std::size_t>(a)] < size_[static_cast<std::size_t>(b)]) {
+            std::swap(a, b);
+        }
+        parent_[static_cast<std::size_t>(b)] = a;
+        size_[static_cast<std::size_t>(a)] += size_[static_cast<std::size_t>(b)];
+        return true;
+    }
+
+private:
+    std::vector<int> parent_;
+    std::vector<int> size_;
+};
+
+} // namespace
+
+std::string_view maze::to_string(MazeAlgorithm algorithm) {
+    switch (algorithm) {
+    case MazeAlgorithm::BACKTRACKER:
+        return "backtracker";
+    case MazeAlgorithm::KRUSKAL:
+        return "kruskal";
+    case MazeAlgorithm::BRAIDED:
+        return "braided";
+    }
+    return "unknown";
+}
+
+maze::MazeAlgorithm maze::maze_algorithm_from_string(std::string_view name) {
+    for (MazeAlgorithm algorithm : ALL_MAZE_ALGORITHMS) {
+        if (to_string(algorithm) == name) {
+            return algorithm;
+        }
+    }
+    throw std::invalid_argument("Unknown maze generator: " + std::string{name});
+}
+
+maze::MazeMap maze::generate_maze(MazeAlgorithm algorithm, int width, int height, unsigned seed) {
+    switch (algorithm) {
+    case MazeAlgorithm::KRUSKAL:
+        return generate_kruskal_maze(width, height, seed);
+    case MazeAlgorithm::BRAIDED:
+        return generate_braided_maze(width, height, seed);
+    case MazeAlgorithm::BACKTRACKER:
+    default:
+        return generate_backtracker_maze(width, height, seed);
+    }
+}
+
+maze::MazeMap maze::generate_backtracker_maze(int width, int height, unsigned seed) {
+    MazeMap map{closed_maze(width, height)};
+    std::mt19937 gen{seed};
+    std::vector<bool> visited(static_cast<std::size_t>(map.cell_count()), false);
+    std::vector<int> stack{0};
+    visited[0] = true;
+    Heading options[4];
+    while (!stack.empty()) {
+        const int cell{stack.back()};
+        int count{0};
+        for (Heading side : kSides) {
+            if (!map.contains(map.x_of(cell) + dx(side), map.y_of(cell) + dy(side))) {
+                continue;
+            }
+            if (!visited[static_cast<std::size_t>(map.neighbour(cell, side))]) {
+                options[count++] = side;
+            }
+        }
+        if (count == 0) {
+            stack.pop_back();
+            continue;
+        }
+        const Heading side{options[gen() % static_cast<unsigned>(count)]};
+        const int next{map.neighbour(cell, side)};
+        map.set_wall(cell, side, false);
+        visited[static_cast<std::size_t>(next)] = true;
+        stack.push_back(next);
+    }
+    return map;
+}
+
+maze::MazeMap maze::generate_kruskal_maze(int width, int height, unsigned seed) {
+    MazeMap map{closed_maze(width, height)};
+    std::mt19937 gen{seed};
+    // Each inner wall once, as the north or east side of a cell
+    std::vector<std::pair<int, Heading>> walls;
+    walls.reserve(static_cast<std::size_t>(map.cell_count()) * 2);
+    for (int index = 0; index < map.cell_count(); ++index) {
+        for (Heading side : {Heading::NORTH, Heading::EAST}) {
+            if (is_inner(map, index, side)) {
+                walls.emplace_back(index, side);
+            }
+        }
+    }
+    std::shuffle(walls.begin(), walls.end(), gen);
+    UnionFind regions{map.cell_count()};
+    for (const auto& [index, side] : walls) {
+        if (regions.unite(index, map.neighbour(index, side))) {
+            map.set_wall(index, side, false);
+        }
+    }
+    return map;
+}
+
+maze::MazeMap maze::generate_braided_maze(int width, int height, unsigned seed, double braid) {
+    MazeMap map{generate_backtracker_maze(width, height, seed)};
+    std::mt19937 gen{seed ^ 0x9E3779B9u};
+    std::bernoulli_distribution remove{braid};
+    std::vector<Heading> options;
+    std::vector<Heading> preferred;
+    for (int index = 0; index < map.cell_count(); ++index) {
+        // Dead ends are checked when reached, so one opened by an earlier
+        // cell is not opened twice
+        if (!is_dead_end(map, index) || !remove(gen)) {
+            continue;
+        }
+        options.clear();
+        preferred.clear();
+        for (Heading side : kSides) {
+            if (!map.has_wall(index, side) || !is_inner(map, index, side)) {
+                continue;
+            }
+            options.push_back(side);
+            if (is_dead_end(map, map.neighbour(index, side))) {
+                preferred.push_back(side);
+            }
+        }
+        const std::vector<Heading>& pick{preferred.empty() ? options : preferred};
+        if (!pick.empty()) {
+            map.set_wall(index, pick[gen() % pick.size()], false);
+        }
+    }
+    return map;
+}
+
+void maze::remove_random_walls(MazeMap& map, double fraction, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::bernoulli_distribution knock_down{fraction};
+    for (int index = 0; index < map.cell_count(); ++index) {
+        // Each inner wall is seen once, from the cell south or west of it
+        for (Heading side : {Heading::NORTH, Heading::EAST}) {
+            const bool inner{map.contains(map.x_of(index) + dx(side), map.y_of(index) + dy(side))};
+            if (inner && map.has_wall(index, side) && knock_down(gen)) {
+                map.set_wall(index, side, false);
+            }
+        }
+    }
+}
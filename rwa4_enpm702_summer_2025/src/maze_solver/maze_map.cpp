@@ -0,0 +1,128 @@
+#include "maze_solver/maze_map.hpp"
+#include "maze_solver/maze_api.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t kWordBytes{sizeof(std::uint64_t)};
+constexpr std::uint64_t kOnes{0x0101010101010101ULL};
+
+std::size_t padded_size(int cells) {
+    const auto count{static_cast<std::size_t>(cells)};
+    return (count + kWordBytes - 1) / kWordBytes * kWordBytes;
+}
+
+// Wall and known bit of a side
+std::uint8_t known_wall(maze::Heading side) {
+    return static_cast<std::uint8_t>(maze::wall_bit(side) | maze::wall_bit(side) << 4);
+}
+
+} // namespace
+
+maze::MazeMap::MazeMap(int width, int height)
+    : width_{width},
+      height_{height},
+      step_{width, 1, -width, -1},
+      cells_(padded_size(width > 0 && height > 0 ? width * height : 0), 0) {
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument("Maze dimensions must be positive");
+    }
+    mark_boundary();
+}
+
+maze::MazeMap maze::MazeMap::from_api() {
+    return MazeMap{MazeControlAPI::get_maze_width(), MazeControlAPI::get_maze_height()};
+}
+
+std::vector<int> maze::MazeMap::centre_cells() const {
+    std::vector<int> xs{width_ / 2};
+    if (width_ % 2 == 0) {
+        xs.push_back(width_ / 2 - 1);
+    }
+    std::vector<int> ys{height_ / 2};
+    if (height_ % 2 == 0) {
+        ys.push_back(height_ / 2 - 1);
+    }
+    std::vector<int> cells;
+    for (int y : ys) {
+        for (int x : xs) {
+            cells.push_back(index(x, y));
+        }
+    }
+    return cells;
+}
+
+bool maze::MazeMap::set_wall(int index, Heading side, bool wall) {
+    const std::uint8_t before{cell(index)};
+    const std::uint8_t bit{wall_bit(side)};
+    std::uint8_t& own{cells_[static_cast<std::size_t>(index)]};
+    own = static_cast<std::uint8_t>((own & ~bit) | (wall ? bit : 0) | bit << 4);
+
+    const int x{x_of(index) + dx(side)};
+    const int y{y_of(index) + dy(side)};
+    if (contains(x, y)) {
+        const std::uint8_t opposite{wall_bit(reversed(side))};
+        std::uint8_t& other{cells_[static_cast<std::size_t>(neighbour(index, side))]};
+        other = static_cast<std::uint8_t>((other & ~opposite) | (wall ? opposite : 0) |
+                                          opposite << 4);
+    }
+    return own != before;
+}
+
+void maze::MazeMap::assign_cells(const std::uint8_t* cells) {
+    std::memcpy(cells_.data(), cells, static_cast<std::size_t>(cell_count()));
+}
+
+void maze::MazeMap::clear() {
+    std::fill(cells_.begin(), cells_.end(), std::uint8_t{0});
+    mark_boundary();
+}
+
+void maze::MazeMap::or_run(int first, int count, std::uint8_t pattern) {
+    std::uint8_t* bytes{cells_.data() + first};
+    const std::uint64_t broadcast{kOnes * pattern};
+    int i{0};
+    for (; i + static_cast<int>(kWordBytes) <= count; i += static_cast<int>(kWordBytes)) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes + i, kWordBytes);
+        word |= broadcast;
+        std::memcpy(bytes + i, &word, kWordBytes);
+    }
+    for (; i < count; ++i) {
+        bytes[i] |= pattern;
+    }
+}
+
+void maze::MazeMap::mark_boundary() {
+    or_run(index(0, 0), width_, known_wall(Heading::SOUTH));
+    or_run(index(0, height_ - 1), width_, known_wall(Heading::NORTH));
+    for (int y = 0; y < height_; ++y) {
+        cells_[static_cast<std::size_t>(index(0, y))] |= known_wall(Heading::WEST);
+        cells_[static_cast<std::size_t>(index(width_ - 1, y))] |= known_wall(Heading::EAST);
+    }
+}
+
+int maze::MazeMap::explored_cell_count() const {
+    constexpr std::uint64_t kHighBits{kOnes * 0x80};
+    const std::size_t cells{static_cast<std::size_t>(cell_count())};
+    int explored{0};
+    std::size_t i{0};
+    for (; i + kWordBytes <= cells; i += kWordBytes) {
+        std::uint64_t word;
+        std::memcpy(&word, cells_.data() + i, kWordBytes);
+        // A byte is explored when its high nibble is 0xF: keep the four
+        // known bits of each byte and AND them into its top bit
+        const std::uint64_t known{word & (word << 1) & (word << 2) & (word << 3)};
+        word = known & kHighBits;
+        while (word != 0) {
+            word &= word - 1;
+            ++explored;
+        }
+    }
+    for (; i < cells; ++i) {
+        explored += is_explored(static_cast<int>(i)) ? 1 : 0;
+    }
+    return explored;
+}
@@ -0,0 +1,116 @@
+#include "maze_solver/path_planner.hpp"
+#include "maze_solver/maze_api.hpp"
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+namespace {
+
+// A search state is (cell, heading, moving straight), packed into one index
+int state_of(int cell, maze::Heading heading, bool straight) {
+    return (cell * 4 + static_cast<int>(heading)) * 2 + (straight ? 1 : 0);
+}
+
+int cell_of(int state) { return state / 8; }
+
+maze::Heading heading_of(int state) { return static_cast<maze::Heading>(state / 2 % 4); }
+
+bool straight_of(int state) { return state % 2 == 1; }
+
+} // namespace
+
+maze::Plan maze::PathPlanner::plan(const MazeMap& map, int start, Heading heading,
+                                   const std::vector<int>& goals, bool known_only) const {
+    constexpr double kInfinity{std::numeric_limits<double>::infinity()};
+    const std::size_t states{static_cast<std::size_t>(map.cell_count()) * 8};
+    std::vector<double> cost(states, kInfinity);
+    std::vector<int> parent(states, -1);
+    std::vector<bool> is_goal(static_cast<std::size_t>(map.cell_count()), false);
+    for (int goal : goals) {
+        is_goal[static_cast<std::size_t>(goal)] = true;
+    }
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> open;
+    const int first{state_of(start, heading, false)};
+    cost[static_cast<std::size_t>(first)] = 0.0;
+    open.emplace(0.0, first);
+
+    Plan result;
+    int reached{-1};
+    while (!open.empty()) {
+        const auto [state_cost, state] = open.top();
+        open.pop();
+        if (state_cost > cost[static_cast<std::size_t>(state)]) {
+            continue;
+        }
+        const int cell{cell_of(state)};
+        if (is_goal[static_cast<std::size_t>(cell)]) {
+            reached = state;
+            break;
+        }
+        const Heading facing{heading_of(state)};
+        const auto relax = [&](int next, double step) {
+            const double next_cost{state_cost + step};
+            if (next_cost < cost[static_cast<std::size_t>(next)]) {
+                cost[static_cast<std::size_t>(next)] = next_cost;
+                parent[static_cast<std::size_t>(next)] = state;
+                open.emplace(next_cost, next);
+            }
+        };
+        const bool blocked{map.has_wall(cell, facing) ||
+                           (known_only && !map.is_known(cell, facing))};
+        if (!blocked) {
+            relax(state_of(map.neighbour(cell, facing), facing, true),
+                  straight_of(state) ? cost_.straight_cell : cost_.first_cell);
+        }
+        relax(state_of(cell, turned_left(facing), false), cost_.quarter_turn);
+        relax(state_of(cell, turned_right(facing), false), cost_.quarter_turn);
+    }
+    if (reached < 0) {
+        return result;
+    }
+
+    result.found = true;
+    result.cost = cost[static_cast<std::size_t>(reached)];
+    result.goal = cell_of(reached);
+    result.final_heading = heading_of(reached);
+    std::vector<int> path;
+    for (int state = reached; state >= 0; state = parent[static_cast<std::size_t>(state)]) {
+        path.push_back(state);
+    }
+    std::reverse(path.begin(), path.end());
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        const Heading before{heading_of(path[i - 1])};
+        const Heading after{heading_of(path[i])};
+        if (after == turned_left(before)) {
+            result.motions.push_back({Motion::Kind::TURN_LEFT, 0});
+        } else if (after == turned_right(before)) {
+            result.motions.push_back({Motion::Kind::TURN_RIGHT, 0});
+        } else if (!result.motions.empty() &&
+                   result.motions.back().kind == Motion::Kind::FORWARD) {
+            ++result.motions.back().cells;
+        } else {
+            result.motions.push_back({Motion::Kind::FORWARD, 1});
+        }
+    }
+    return result;
+}
+
+void maze::PathPlanner::execute(const Plan& plan) {
+    for (const Motion& motion : plan.motions) {
+        switch (motion.kind) {
+        case Motion::Kind::FORWARD:
+            MazeControlAPI::move_forward(motion.cells);
+            break;
+        case Motion::Kind::TURN_LEFT:
+            MazeControlAPI::turn_left();
+            break;
+        case Motion::Kind::TURN_RIGHT:
+            MazeControlAPI::turn_right();
+            break;
+        }
+    }
+}
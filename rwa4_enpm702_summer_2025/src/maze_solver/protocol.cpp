@@ -0,0 +1,82 @@
+#include "maze_solver/protocol.hpp"
+#include "maze_solver/instrumentation.hpp"
+#include <cctype>
+#include <charconv>
+#include <istream>
+#include <ostream>
+
+maze::ProtocolWriter::ProtocolWriter(std::ostream& out) : out_{&out} {
+    // Room for a few hundred commands before the first reallocation
+    buffer_.reserve(4096);
+}
+
+maze::ProtocolWriter& maze::ProtocolWriter::command(std::string_view name) {
+    buffer_.append(name);
+    return *this;
+}
+
+maze::ProtocolWriter& maze::ProtocolWriter::arg(int value) {
+    std::array<char, 16> digits;
+    const auto result{std::to_chars(digits.data(), digits.data() + digits.size(), value)};
+    buffer_.push_back(' ');
+    buffer_.append(digits.data(), static_cast<std::size_t>(result.ptr - digits.data()));
+    return *this;
+}
+
+maze::ProtocolWriter& maze::ProtocolWriter::arg(char value) {
+    buffer_.push_back(' ');
+    buffer_.push_back(value);
+    return *this;
+}
+
+maze::ProtocolWriter& maze::ProtocolWriter::arg(std::string_view value) {
+    buffer_.push_back(' ');
+    buffer_.append(value);
+    return *this;
+}
+
+void maze::ProtocolWriter::end() { buffer_.push_back('\n'); }
+
+void maze::ProtocolWriter::flush() {
+    if (!buffer_.empty()) {
+        out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        MAZE_API_COUNT_BYTES_WRITTEN(buffer_.size());
+        buffer_.clear();
+    }
+    out_->flush();
+}
+
+maze::ProtocolReader::ProtocolReader(std::istream& in) : in_{&in} {}
+
+std::string_view maze::ProtocolReader::read_token() {
+    using traits = std::istream::traits_type;
+    std::streambuf* buf{in_->rdbuf()};
+    auto ch{buf->sgetc()};
+    while (ch != traits::eof() && std::isspace(ch)) {
+        ch = buf->snextc();
+    }
+    std::size_t length{0};
+    while (ch != traits::eof() && !std::isspace(ch)) {
+        if (length < token_.size()) {
+            token_[length++] = traits::to_char_type(ch);
+        }
+        ch = buf->snextc();
+    }
+    if (length == 0) {
+        in_->setstate(std::ios_base::eofbit | std::ios_base::failbit);
+    }
+    // Replies are one token per line: count the token and its newline
+    MAZE_API_COUNT_BYTES_READ(length + 1);
+    return {token_.data(), length};
+}
+
+bool maze::ProtocolReader::read_bool() { return read_token() == "true"; }
+
+bool maze::ProtocolReader::read_ack() { return read_token() == "ack"; }
+
+int maze::ProtocolReader::read_int() {
+    const std::string_view token{read_token()};
+    int value{0};
+    std::from_chars(token.data(), token.data() + token.size(), value);
+    return value;
+}
@@ -0,0 +1,260 @@
+#include "maze_solver/recording_backend.hpp"
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace {
+
+maze::ReplayRecord command(maze::ReplayOp op, int x = 0, int y = 0, char symbol = 0) {
+    maze::ReplayRecord record;
+    record.op = op;
+    record.x = x;
+    record.y = y;
+    record.symbol = symbol;
+    return record;
+}
+
+// Display commands are not answered; every other command is a round trip
+bool has_reply(maze::ReplayOp op) {
+    return op < maze::ReplayOp::SET_WALL || op > maze::ReplayOp::CLEAR_ALL_TEXT;
+}
+
+} // namespace
+
+maze::RecordingBackend::RecordingBackend(std::unique_ptr<MazeBackend> inner,
+                                         const std::string& path)
+    : inner_{std::move(inner)}, writer_{path} {}
+
+maze::RecordingBackend::~RecordingBackend() {
+    for (Entry& entry : entries_) {
+        if (entry.pending) {
+            entry.pending = false;
+            entry.record.unread = true;
+        }
+    }
+    try {
+        commit();
+    } catch (const std::exception&) {
+        // Nothing can be reported from a destructor
+    }
+}
+
+template <typename Call>
+void maze::RecordingBackend::forward(ReplayRecord& record, Call&& call) {
+    try {
+        call();
+    } catch (const std::exception& e) {
+        record.threw = true;
+        record.error = e.what();
+        append(std::move(record));
+        throw;
+    }
+}
+
+void maze::RecordingBackend::append(ReplayRecord record) {
+    entries_.push_back(Entry{std::move(record), false});
+    commit();
+}
+
+void maze::RecordingBackend::commit() {
+    bool answered{false};
+    while (!entries_.empty() && !entries_.front().pending) {
+        answered = answered || has_reply(entries_.front().record.op);
+        writer_.append(entries_.front().record);
+        entries_.pop_front();
+        ++first_entry_;
+    }
+    // The log reaches the file at every round trip, so that a run killed
+    // from the simulator keeps everything up to its last reply
+    if (answered) {
+        writer_.flush();
+    }
+}
+
+int maze::RecordingBackend::get_maze_width() {
+    ReplayRecord record{command(ReplayOp::MAZE_WIDTH)};
+    forward(record, [&] { record.value = inner_->get_maze_width(); });
+    const int width{record.value};
+    append(std::move(record));
+    return width;
+}
+
+int maze::RecordingBackend::get_maze_height() {
+    ReplayRecord record{command(ReplayOp::MAZE_HEIGHT)};
+    forward(record, [&] { record.value = inner_->get_maze_height(); });
+    const int height{record.value};
+    append(std::move(record));
+    return height;
+}
+
+bool maze::RecordingBackend::has_wall_front() {
+    ReplayRecord record{command(ReplayOp::WALL_FRONT)};
+    forward(record, [&] { record.value = inner_->has_wall_front() ? 1 : 0; });
+    const bool wall{record.value != 0};
+    append(std::move(record));
+    return wall;
+}
+
+bool maze::RecordingBackend::has_wall_right() {
+    ReplayRecord record{command(ReplayOp::WALL_RIGHT)};
+    forward(record, [&] { record.value = inner_->has_wall_right() ? 1 : 0; });
+    const bool wall{record.value != 0};
+    append(std::move(record));
+    return wall;
+}
+
+bool maze::RecordingBackend::has_wall_left() {
+    ReplayRecord record{command(ReplayOp::WALL_LEFT)};
+    forward(record, [&] { record.value = inner_->has_wall_left() ? 1 : 0; });
+    const bool wall{record.value != 0};
+    append(std::move(record));
+    return wall;
+}
+
+void maze::RecordingBackend::move_forward(int distance) {
+    ReplayRecord record{command(ReplayOp::MOVE_FORWARD)};
+    record.value = distance;
+    forward(record, [&] { inner_->move_forward(distance); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::turn_right() {
+    ReplayRecord record{command(ReplayOp::TURN_RIGHT)};
+    forward(record, [&] { inner_->turn_right(); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::turn_left() {
+    ReplayRecord record{command(ReplayOp::TURN_LEFT)};
+    forward(record, [&] { inner_->turn_left(); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::set_wall(int x, int y, char direction) {
+    ReplayRecord record{command(ReplayOp::SET_WALL, x, y, direction)};
+    forward(record, [&] { inner_->set_wall(x, y, direction); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::clear_wall(int x, int y, char direction) {
+    ReplayRecord record{command(ReplayOp::CLEAR_WALL, x, y, direction)};
+    forward(record, [&] { inner_->clear_wall(x, y, direction); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::set_color(int x, int y, char color) {
+    ReplayRecord record{command(ReplayOp::SET_COLOR, x, y, color)};
+    forward(record, [&] { inner_->set_color(x, y, color); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::clear_color(int x, int y) {
+    ReplayRecord record{command(ReplayOp::CLEAR_COLOR, x, y)};
+    forward(record, [&] { inner_->clear_color(x, y); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::clear_all_color() {
+    ReplayRecord record{command(ReplayOp::CLEAR_ALL_COLOR)};
+    forward(record, [&] { inner_->clear_all_color(); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::set_text(int x, int y, const std::string& text) {
+    ReplayRecord record{command(ReplayOp::SET_TEXT, x, y)};
+    record.text = text;
+    forward(record, [&] { inner_->set_text(x, y, text); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::clear_text(int x, int y) {
+    ReplayRecord record{command(ReplayOp::CLEAR_TEXT, x, y)};
+    forward(record, [&] { inner_->clear_text(x, y); });
+    append(std::move(record));
+}
+
+void maze::RecordingBackend::clear_all_text() {
+    ReplayRecord record{command(ReplayOp::CLEAR_ALL_TEXT)};
+    forward(record, [&] { inner_->clear_all_text(); });
+    append(std::move(record));
+}
+
+bool maze::RecordingBackend::was_reset() {
+    ReplayRecord record{command(ReplayOp::WAS_RESET)};
+    forward(record, [&] { record.value = inner_->was_reset() ? 1 : 0; });
+    const bool reset{record.value != 0};
+    append(std::move(record));
+    return reset;
+}
+
+void maze::RecordingBackend::ack_reset() {
+    ReplayRecord record{command(ReplayOp::ACK_RESET)};
+    forward(record, [&] { inner_->ack_reset(); });
+    append(std::move(record));
+}
+
+maze::WallReadings maze::RecordingBackend::sense_walls() {
+    ReplayRecord record{command(ReplayOp::SENSE_WALLS)};
+    WallReadings walls;
+    forward(record, [&] { walls = inner_->sense_walls(); });
+    record.value = (walls.front ? 1 : 0) | (walls.left ? 2 : 0) | (walls.right ? 4 : 0);
+    append(std::move(record));
+    return walls;
+}
+
+maze::WallFuture maze::RecordingBackend::query_wall(WallSide side) {
+    ReplayOp op{ReplayOp::WALL_FRONT};
+    if (side == WallSide::LEFT) {
+        op = ReplayOp::WALL_LEFT;
+    } else if (side == WallSide::RIGHT) {
+        op = ReplayOp::WALL_RIGHT;
+    }
+    ReplayRecord record{command(op)};
+    std::optional<WallFuture> future;
+    forward(record, [&] { future.emplace(inner_->query_wall(side)); });
+    // The record keeps its place in the log until the reply is read
+    const std::uint64_t number{first_entry_ + entries_.size()};
+    entries_.push_back(Entry{std::move(record), true});
+    const std::uint64_t ticket{next_ticket_++};
+    queries_.emplace(ticket, Query{number, std::move(*future)});
+    return WallFuture{*this, ticket};
+}
+
+bool maze::RecordingBackend::is_wall_query_ready(std::uint64_t ticket) const {
+    return queries_.at(ticket).future.is_ready();
+}
+
+bool maze::RecordingBackend::await_wall_query(std::uint64_t ticket) {
+    const auto query{queries_.find(ticket)};
+    const std::uint64_t number{query->second.entry};
+    WallFuture future{std::move(query->second.future)};
+    queries_.erase(query);
+    Entry& pending{entry(number)};
+    pending.pending = false;
+    bool wall{false};
+    try {
+        wall = future.get();
+    } catch (const std::exception& e) {
+        pending.record.threw = true;
+        pending.record.error = e.what();
+        commit();
+        throw;
+    }
+    pending.record.value = wall ? 1 : 0;
+    commit();
+    return wall;
+}
+
+void maze::RecordingBackend::release_wall_query(std::uint64_t ticket) {
+    const auto query{queries_.find(ticket)};
+    Entry& pending{entry(query->second.entry)};
+    pending.pending = false;
+    pending.record.unread = true;
+    queries_.erase(query);
+    commit();
+}
+
+void maze::RecordingBackend::flush() {
+    inner_->flush();
+    writer_.flush();
+}
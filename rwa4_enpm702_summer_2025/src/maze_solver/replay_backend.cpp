@@ -0,0 +1,128 @@
+#include "maze_solver/replay_backend.hpp"
+#include "maze_solver/wall_future.hpp"
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+maze::ReplayRecord command(maze::ReplayOp op, int x = 0, int y = 0, char symbol = 0) {
+    maze::ReplayRecord record;
+    record.op = op;
+    record.x = x;
+    record.y = y;
+    record.symbol = symbol;
+    return record;
+}
+
+} // namespace
+
+maze::ReplayBackend::ReplayBackend(const std::string& path) : records_{ReplayLog::load(path)} {}
+
+maze::ReplayBackend::ReplayBackend(std::vector<ReplayRecord> records)
+    : records_{std::move(records)} {}
+
+const maze::ReplayRecord& maze::ReplayBackend::next(const ReplayRecord& expected, bool raise) {
+    if (position_ == records_.size()) {
+        throw std::runtime_error("Replay log ended after " + std::to_string(position_) +
+                                 " records, solver sent " + describe(expected));
+    }
+    const ReplayRecord& record{records_[position_]};
+    if (!same_command(record, expected)) {
+        throw std::runtime_error("Replay diverged at record " + std::to_string(position_) +
+                                 ": log has " + describe(record) + ", solver sent " +
+                                 describe(expected));
+    }
+    ++position_;
+    if (raise && record.threw) {
+        throw std::runtime_error(record.error);
+    }
+    return record;
+}
+
+int maze::ReplayBackend::get_maze_width() { return next(command(ReplayOp::MAZE_WIDTH)).value; }
+
+int maze::ReplayBackend::get_maze_height() { return next(command(ReplayOp::MAZE_HEIGHT)).value; }
+
+bool maze::ReplayBackend::has_wall_front() {
+    return next(command(ReplayOp::WALL_FRONT)).value != 0;
+}
+
+bool maze::ReplayBackend::has_wall_right() {
+    return next(command(ReplayOp::WALL_RIGHT)).value != 0;
+}
+
+bool maze::ReplayBackend::has_wall_left() { return next(command(ReplayOp::WALL_LEFT)).value != 0; }
+
+void maze::ReplayBackend::move_forward(int distance) {
+    ReplayRecord expected{command(ReplayOp::MOVE_FORWARD)};
+    expected.value = distance;
+    next(expected);
+}
+
+void maze::ReplayBackend::turn_right() { next(command(ReplayOp::TURN_RIGHT)); }
+
+void maze::ReplayBackend::turn_left() { next(command(ReplayOp::TURN_LEFT)); }
+
+void maze::ReplayBackend::set_wall(int x, int y, char direction) {
+    next(command(ReplayOp::SET_WALL, x, y, direction));
+}
+
+void maze::ReplayBackend::clear_wall(int x, int y, char direction) {
+    next(command(ReplayOp::CLEAR_WALL, x, y, direction));
+}
+
+void maze::ReplayBackend::set_color(int x, int y, char color) {
+    next(command(ReplayOp::SET_COLOR, x, y, color));
+}
+
+void maze::ReplayBackend::clear_color(int x, int y) { next(command(ReplayOp::CLEAR_COLOR, x, y)); }
+
+void maze::ReplayBackend::clear_all_color() { next(command(ReplayOp::CLEAR_ALL_COLOR)); }
+
+void maze::ReplayBackend::set_text(int x, int y, const std::string& text) {
+    ReplayRecord expected{command(ReplayOp::SET_TEXT, x, y)};
+    expected.text = text;
+    next(expected);
+}
+
+void maze::ReplayBackend::clear_text(int x, int y) { next(command(ReplayOp::CLEAR_TEXT, x, y)); }
+
+void maze::ReplayBackend::clear_all_text() { next(command(ReplayOp::CLEAR_ALL_TEXT)); }
+
+bool maze::ReplayBackend::was_reset() { return next(command(ReplayOp::WAS_RESET)).value != 0; }
+
+void maze::ReplayBackend::ack_reset() { next(command(ReplayOp::ACK_RESET)); }
+
+maze::WallReadings maze::ReplayBackend::sense_walls() {
+    const int bits{next(command(ReplayOp::SENSE_WALLS)).value};
+    WallReadings walls;
+    walls.front = bits & 1;
+    walls.left = bits & 2;
+    walls.right = bits & 4;
+    return walls;
+}
+
+maze::WallFuture maze::ReplayBackend::query_wall(WallSide side) {
+    ReplayOp op{ReplayOp::WALL_FRONT};
+    if (side == WallSide::LEFT) {
+        op = ReplayOp::WALL_LEFT;
+    } else if (side == WallSide::RIGHT) {
+        op = ReplayOp::WALL_RIGHT;
+    }
+    // Errors of a query surface when its reply is read
+    next(command(op), false);
+    return WallFuture{*this, static_cast<std::uint64_t>(position_ - 1)};
+}
+
+bool maze::ReplayBackend::await_wall_query(std::uint64_t ticket) {
+    const ReplayRecord& record{records_[static_cast<std::size_t>(ticket)]};
+    if (record.unread) {
+        throw std::runtime_error("Replay diverged at record " + std::to_string(ticket) +
+                                 ": solver read the reply of " + describe(record) +
+                                 ", which the recorded run never read");
+    }
+    if (record.threw) {
+        throw std::runtime_error(record.error);
+    }
+    return record.value != 0;
+}
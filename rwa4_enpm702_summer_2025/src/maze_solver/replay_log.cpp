@@ -0,0 +1,300 @@
+#include "maze_solver/replay_log.hpp"
+#include <array>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic{'M', 'A', 'Z', 'E', 'R', 'E', 'P', 'L'};
+constexpr std::uint32_t kVersion{1};
+constexpr std::uint8_t kOpMask{0x1F};
+constexpr std::uint8_t kReplyBit{0x20};
+constexpr std::uint8_t kUnreadBit{0x40};
+constexpr std::uint8_t kThrewBit{0x80};
+// Records are written once this many bytes are buffered
+constexpr std::size_t kBlockSize{1 << 16};
+
+constexpr std::string_view kNames[]{
+    "mazeWidth", "mazeHeight",    "wallFront",    "wallRight",  "wallLeft",
+    "senseWalls", "moveForward",  "turnRight",    "turnLeft",   "setWall",
+    "clearWall", "setColor",      "clearColor",   "clearAllColor", "setText",
+    "clearText", "clearAllText",  "wasReset",     "ackReset"};
+static_assert(std::size(kNames) == static_cast<std::size_t>(maze::ReplayOp::COUNT));
+
+bool has_boolean_reply(maze::ReplayOp op) {
+    switch (op) {
+    case maze::ReplayOp::WALL_FRONT:
+    case maze::ReplayOp::WALL_RIGHT:
+    case maze::ReplayOp::WALL_LEFT:
+    case maze::ReplayOp::WAS_RESET:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool has_cell(maze::ReplayOp op) {
+    switch (op) {
+    case maze::ReplayOp::SET_WALL:
+    case maze::ReplayOp::CLEAR_WALL:
+    case maze::ReplayOp::SET_COLOR:
+    case maze::ReplayOp::CLEAR_COLOR:
+    case maze::ReplayOp::SET_TEXT:
+    case maze::ReplayOp::CLEAR_TEXT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool has_symbol(maze::ReplayOp op) {
+    return op == maze::ReplayOp::SET_WALL || op == maze::ReplayOp::CLEAR_WALL ||
+           op == maze::ReplayOp::SET_COLOR;
+}
+
+// Whether the record stores `value` as a varint
+bool has_varint_value(maze::ReplayOp op) {
+    return op == maze::ReplayOp::MAZE_WIDTH || op == maze::ReplayOp::MAZE_HEIGHT ||
+           op == maze::ReplayOp::SENSE_WALLS || op == maze::ReplayOp::MOVE_FORWARD;
+}
+
+void put_varint(std::string& out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char>(value);
+}
+
+void put_text(std::string& out, const std::string& text) {
+    put_varint(out, static_cast<std::uint32_t>(text.size()));
+    out += text;
+}
+
+/**
+ * @brief Reads the fields of a record, telling a truncated record apart
+ */
+class Cursor {
+public:
+    Cursor(const std::string& bytes, std::size_t position) : bytes_{bytes}, position_{position} {}
+
+    std::optional<std::uint8_t> byte() {
+        if (position_ == bytes_.size()) {
+            return std::nullopt;
+        }
+        return static_cast<std::uint8_t>(bytes_[position_++]);
+    }
+
+    std::optional<std::uint32_t> varint() {
+        std::uint32_t value{0};
+        for (int shift = 0; shift < 35; shift += 7) {
+            const std::optional<std::uint8_t> next{byte()};
+            if (!next) {
+                return std::nullopt;
+            }
+            value |= static_cast<std::uint32_t>(*next & 0x7F) << shift;
+            if (!(*next & 0x80)) {
+                return value;
+            }
+        }
+        throw std::runtime_error("Replay log holds a malformed number");
+    }
+
+    std::optional<std::string> text() {
+        const std::optional<std::uint32_t> size{varint()};
+        if (!size || bytes_.size() - position_ < *size) {
+            return std::nullopt;
+        }
+        std::string result{bytes_.substr(position_, *size)};
+        position_ += *size;
+        return result;
+    }
+
+    [[nodiscard]] std::size_t position() const { return position_; }
+
+private:
+    const std::string& bytes_;
+    std::size_t position_;
+};
+
+/**
+ * @brief Decode the record at the cursor
+ * @return The record, or nothing if the log ends in the middle of it
+ */
+std::optional<maze::ReplayRecord> decode(Cursor& in) {
+    const std::optional<std::uint8_t> head{in.byte()};
+    if (!head) {
+        return std::nullopt;
+    }
+    if ((*head & kOpMask) >= static_cast<std::uint8_t>(maze::ReplayOp::COUNT)) {
+        throw std::runtime_error("Replay log holds an unknown command");
+    }
+    maze::ReplayRecord record;
+    record.op = static_cast<maze::ReplayOp>(*head & kOpMask);
+    record.unread = *head & kUnreadBit;
+    record.threw = *head & kThrewBit;
+    if (has_boolean_reply(record.op)) {
+        record.value = (*head & kReplyBit) ? 1 : 0;
+    }
+    if (has_varint_value(record.op)) {
+        const std::optional<std::uint32_t> value{in.varint()};
+        if (!value) {
+            return std::nullopt;
+        }
+        record.value = static_cast<int>(*value);
+    }
+    if (has_cell(record.op)) {
+        const std::optional<std::uint32_t> x{in.varint()};
+        const std::optional<std::uint32_t> y{x ? in.varint() : std::nullopt};
+        if (!y) {
+            return std::nullopt;
+        }
+        record.x = static_cast<int>(*x);
+        record.y = static_cast<int>(*y);
+    }
+    if (has_symbol(record.op)) {
+        const std::optional<std::uint8_t> symbol{in.byte()};
+        if (!symbol) {
+            return std::nullopt;
+        }
+        record.symbol = static_cast<char>(*symbol);
+    }
+    if (record.op == maze::ReplayOp::SET_TEXT) {
+        std::optional<std::string> text{in.text()};
+        if (!text) {
+            return std::nullopt;
+        }
+        record.text = std::move(*text);
+    }
+    if (record.threw) {
+        std::optional<std::string> error{in.text()};
+        if (!error) {
+            return std::nullopt;
+        }
+        record.error = std::move(*error);
+    }
+    return record;
+}
+
+} // namespace
+
+bool maze::same_command(const ReplayRecord& a, const ReplayRecord& b) {
+    return a.op == b.op && a.x == b.x && a.y == b.y && a.symbol == b.symbol && a.text == b.text &&
+           (a.op != ReplayOp::MOVE_FORWARD || a.value == b.value);
+}
+
+std::string maze::describe(const ReplayRecord& record) {
+    std::string result{kNames[static_cast<std::size_t>(record.op)]};
+    if (record.op == ReplayOp::MOVE_FORWARD) {
+        result += ' ' + std::to_string(record.value);
+    }
+    if (has_cell(record.op)) {
+        result += ' ' + std::to_string(record.x) + ' ' + std::to_string(record.y);
+    }
+    if (has_symbol(record.op)) {
+        result += ' ';
+        result += record.symbol;
+    }
+    if (record.op == ReplayOp::SET_TEXT) {
+        result += ' ' + record.text;
+    }
+    return result;
+}
+
+void maze::ReplayLog::encode(std::string& out, const ReplayRecord& record) {
+    std::uint8_t head{static_cast<std::uint8_t>(record.op)};
+    if (has_boolean_reply(record.op) && record.value != 0) {
+        head |= kReplyBit;
+    }
+    if (record.unread) {
+        head |= kUnreadBit;
+    }
+    if (record.threw) {
+        head |= kThrewBit;
+    }
+    out += static_cast<char>(head);
+    if (has_varint_value(record.op)) {
+        put_varint(out, static_cast<std::uint32_t>(record.value));
+    }
+    if (has_cell(record.op)) {
+        put_varint(out, static_cast<std::uint32_t>(record.x));
+        put_varint(out, static_cast<std::uint32_t>(record.y));
+    }
+    if (has_symbol(record.op)) {
+        out += record.symbol;
+    }
+    if (record.op == ReplayOp::SET_TEXT) {
+        put_text(out, record.text);
+    }
+    if (record.threw) {
+        put_text(out, record.error);
+    }
+}
+
+std::vector<maze::ReplayRecord> maze::ReplayLog::load(const std::string& path) {
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("Cannot open replay log " + path);
+    }
+    const std::string bytes{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    std::uint32_t version{0};
+    if (bytes.size() < kMagic.size() + sizeof version ||
+        std::memcmp(bytes.data(), kMagic.data(), kMagic.size()) != 0) {
+        throw std::runtime_error("Not a replay log: " + path);
+    }
+    std::memcpy(&version, bytes.data() + kMagic.size(), sizeof version);
+    if (version != kVersion) {
+        throw std::runtime_error("Unsupported replay log version: " + path);
+    }
+
+    std::vector<ReplayRecord> records;
+    Cursor cursor{bytes, kMagic.size() + sizeof version};
+    try {
+        // A partial last record is left by a run that was killed; drop it
+        while (std::optional<ReplayRecord> record{decode(cursor)}) {
+            records.push_back(std::move(*record));
+        }
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(std::string{e.what()} + ": " + path);
+    }
+    return records;
+}
+
+maze::ReplayLogWriter::ReplayLogWriter(const std::string& path)
+    : path_{path}, out_{path, std::ios::binary | std::ios::trunc} {
+    buffer_.append(kMagic.data(), kMagic.size());
+    buffer_.append(reinterpret_cast<const char*>(&kVersion), sizeof kVersion);
+    bytes_ = static_cast<long>(buffer_.size());
+    flush();
+}
+
+maze::ReplayLogWriter::~ReplayLogWriter() {
+    try {
+        flush();
+    } catch (const std::runtime_error&) {
+        // Nothing can be reported from a destructor
+    }
+}
+
+void maze::ReplayLogWriter::append(const ReplayRecord& record) {
+    const std::size_t before{buffer_.size()};
+    ReplayLog::encode(buffer_, record);
+    bytes_ += static_cast<long>(buffer_.size() - before);
+    ++records_;
+    if (buffer_.size() >= kBlockSize) {
+        flush();
+    }
+}
+
+void maze::ReplayLogWriter::flush() {
+    out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    out_.flush();
+    buffer_.clear();
+    if (!out_) {
+        throw std::runtime_error("Cannot write replay log " + path_);
+    }
+}
@@ -0,0 +1,152 @@
+#include "maze_solver/sensing_cache.hpp"
+#include "maze_solver/wall_future.hpp"
+#include <array>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief Turns batching on for a scope and gives the caller its mode back
+ *
+ * close() restores the mode on the normal path, where reading the replies
+ * still owed may throw. Leaving the scope without close() means an
+ * exception is already on its way out: the mode is restored, and a further
+ * error from the owed replies is dropped in favour of that one.
+ */
+class BatchingScope {
+public:
+    BatchingScope() : previous_{maze::MazeControlAPI::is_batching()} {
+        maze::MazeControlAPI::set_batching(true);
+    }
+
+    ~BatchingScope() {
+        if (open_) {
+            try {
+                maze::MazeControlAPI::set_batching(previous_);
+            } catch (const std::exception&) {
+                // The exception that ended the scope is the one to report
+            }
+        }
+    }
+
+    BatchingScope(const BatchingScope&) = delete;
+    BatchingScope& operator=(const BatchingScope&) = delete;
+
+    void close() {
+        open_ = false;
+        maze::MazeControlAPI::set_batching(previous_);
+    }
+
+private:
+    bool previous_;   ///< Caller's batching mode
+    bool open_{true}; ///< close() not called yet
+};
+
+} // namespace
+
+maze::SensingCache::SensingCache() : map_{MazeMap::from_api()} {}
+
+maze::SensingCache::SensingCache(int width, int height) : map_{width, height} {}
+
+bool maze::SensingCache::has_wall(Heading side) {
+    const int cell{map_.index(x_, y_)};
+    if (map_.is_known(cell, side)) {
+        ++hits_;
+        return map_.has_wall(cell, side);
+    }
+    ++misses_;
+    bool wall{false};
+    if (side == heading_) {
+        wall = MazeControlAPI::has_wall_front();
+    } else if (side == turned_left(heading_)) {
+        wall = MazeControlAPI::has_wall_left();
+    } else {
+        wall = MazeControlAPI::has_wall_right();
+    }
+    map_.set_wall(cell, side, wall);
+    return wall;
+}
+
+maze::WallReadings maze::SensingCache::sense() { return sense_at(x_, y_); }
+
+maze::WallReadings maze::SensingCache::sense_at(int x, int y) {
+    const int cell{map_.index(x, y)};
+    const std::array<Heading, 3> sides{heading_, turned_left(heading_), turned_right(heading_)};
+    using Query = WallFuture (*)();
+    const std::array<Query, 3> queries{&MazeControlAPI::has_wall_front_async,
+                                       &MazeControlAPI::has_wall_left_async,
+                                       &MazeControlAPI::has_wall_right_async};
+
+    // Send every missing query before waiting for the first reply
+    std::array<std::optional<WallFuture>, 3> pending;
+    for (std::size_t i = 0; i < sides.size(); ++i) {
+        if (map_.is_known(cell, sides[i])) {
+            ++hits_;
+        } else {
+            ++misses_;
+            pending[i].emplace(queries[i]());
+        }
+    }
+    for (std::size_t i = 0; i < sides.size(); ++i) {
+        if (pending[i]) {
+            map_.set_wall(cell, sides[i], pending[i]->get());
+        }
+    }
+
+    WallReadings walls;
+    walls.front = map_.has_wall(cell, sides[0]);
+    walls.left = map_.has_wall(cell, sides[1]);
+    walls.right = map_.has_wall(cell, sides[2]);
+    return walls;
+}
+
+maze::WallReadings maze::SensingCache::move_forward_and_sense(int distance) {
+    // With batching on, the movement's acknowledgement is read together with
+    // the replies to the queries. The pose only changes once the move was
+    // acknowledged, so a failed move leaves it where the robot still is
+    BatchingScope batching;
+    MazeControlAPI::move_forward(distance);
+    const WallReadings walls{
+        sense_at(x_ + dx(heading_) * distance, y_ + dy(heading_) * distance)};
+    batching.close();
+    advance(distance);
+    return walls;
+}
+
+void maze::SensingCache::move_forward(int distance) {
+    MazeControlAPI::move_forward(distance);
+    advance(distance);
+}
+
+void maze::SensingCache::advance(int distance) {
+    for (int i = 0; i < distance; ++i) {
+        map_.set_wall(map_.index(x_, y_), heading_, false);
+        x_ += dx(heading_);
+        y_ += dy(heading_);
+    }
+}
+
+void maze::SensingCache::turn_right() {
+    MazeControlAPI::turn_right();
+    heading_ = turned_right(heading_);
+}
+
+void maze::SensingCache::turn_left() {
+    MazeControlAPI::turn_left();
+    heading_ = turned_left(heading_);
+}
+
+void maze::SensingCache::reset() {
+    x_ = 0;
+    y_ = 0;
+    heading_ = Heading::NORTH;
+}
+
+void maze::SensingCache::load_map(const MazeMap &map) {
+    if (map.width() != map_.width() || map.height() != map_.height()) {
+        throw std::invalid_argument("Map does not match the maze dimensions");
+    }
+    map_ = map;
+}
@@ -0,0 +1,208 @@
+#include "maze_solver/shm_backend.hpp"
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+
+namespace {
+
+maze::ShmRequest command(maze::ReplayOp op, int x = 0, int y = 0, char symbol = 0) {
+    maze::ShmRequest request;
+    request.op = op;
+    request.x = x;
+    request.y = y;
+    request.symbol = symbol;
+    return request;
+}
+
+/// Display commands are posted; everything else waits for a reply
+bool has_reply(maze::ReplayOp op) {
+    switch (op) {
+    case maze::ReplayOp::SET_WALL:
+    case maze::ReplayOp::CLEAR_WALL:
+    case maze::ReplayOp::SET_COLOR:
+    case maze::ReplayOp::CLEAR_COLOR:
+    case maze::ReplayOp::CLEAR_ALL_COLOR:
+    case maze::ReplayOp::SET_TEXT:
+    case maze::ReplayOp::CLEAR_TEXT:
+    case maze::ReplayOp::CLEAR_ALL_TEXT:
+        return false;
+    default:
+        return true;
+    }
+}
+
+/// Run a command on a backend, returning its reply value
+int execute(maze::MazeBackend& backend, const maze::ShmRequest& request) {
+    using maze::ReplayOp;
+    switch (request.op) {
+    case ReplayOp::MAZE_WIDTH:
+        return backend.get_maze_width();
+    case ReplayOp::MAZE_HEIGHT:
+        return backend.get_maze_height();
+    case ReplayOp::WALL_FRONT:
+        return backend.has_wall_front() ? 1 : 0;
+    case ReplayOp::WALL_RIGHT:
+        return backend.has_wall_right() ? 1 : 0;
+    case ReplayOp::WALL_LEFT:
+        return backend.has_wall_left() ? 1 : 0;
+    case ReplayOp::SENSE_WALLS: {
+        const maze::WallReadings walls{backend.sense_walls()};
+        return (walls.front ? 1 : 0) | (walls.left ? 2 : 0) | (walls.right ? 4 : 0);
+    }
+    case ReplayOp::MOVE_FORWARD:
+        backend.move_forward(request.x);
+        return 0;
+    case ReplayOp::TURN_RIGHT:
+        backend.turn_right();
+        return 0;
+    case ReplayOp::TURN_LEFT:
+        backend.turn_left();
+        return 0;
+    case ReplayOp::SET_WALL:
+        backend.set_wall(request.x, request.y, request.symbol);
+        return 0;
+    case ReplayOp::CLEAR_WALL:
+        backend.clear_wall(request.x, request.y, request.symbol);
+        return 0;
+    case ReplayOp::SET_COLOR:
+        backend.set_color(request.x, request.y, request.symbol);
+        return 0;
+    case ReplayOp::CLEAR_COLOR:
+        backend.clear_color(request.x, request.y);
+        return 0;
+    case ReplayOp::CLEAR_ALL_COLOR:
+        backend.clear_all_color();
+        return 0;
+    case ReplayOp::SET_TEXT:
+        backend.set_text(request.x, request.y,
+                         std::string(request.text, std::min<std::size_t>(
+                                                       request.text_size,
+                                                       maze::ShmRequest::MAX_TEXT)));
+        return 0;
+    case ReplayOp::CLEAR_TEXT:
+        backend.clear_text(request.x, request.y);
+        return 0;
+    case ReplayOp::CLEAR_ALL_TEXT:
+        backend.clear_all_text();
+        return 0;
+    case ReplayOp::WAS_RESET:
+        return backend.was_reset() ? 1 : 0;
+    case ReplayOp::ACK_RESET:
+        backend.ack_reset();
+        return 0;
+    default:
+        throw std::invalid_argument("Unknown command on the shared-memory channel");
+    }
+}
+
+} // namespace
+
+maze::SharedMemoryBackend::SharedMemoryBackend(const std::string& name)
+    : channel_{ShmChannel::open(name)} {}
+
+int maze::SharedMemoryBackend::call(const ShmRequest& request) {
+    channel_.send_request(request);
+    const ShmReply reply{channel_.receive_reply()};
+    if (reply.threw) {
+        throw std::runtime_error(
+            std::string(reply.error, std::min<std::size_t>(reply.error_size, ShmReply::MAX_ERROR)));
+    }
+    return reply.value;
+}
+
+void maze::SharedMemoryBackend::post(const ShmRequest& request) { channel_.send_request(request); }
+
+int maze::SharedMemoryBackend::get_maze_width() { return call(command(ReplayOp::MAZE_WIDTH)); }
+
+int maze::SharedMemoryBackend::get_maze_height() { return call(command(ReplayOp::MAZE_HEIGHT)); }
+
+bool maze::SharedMemoryBackend::has_wall_front() {
+    return call(command(ReplayOp::WALL_FRONT)) != 0;
+}
+
+bool maze::SharedMemoryBackend::has_wall_right() {
+    return call(command(ReplayOp::WALL_RIGHT)) != 0;
+}
+
+bool maze::SharedMemoryBackend::has_wall_left() { return call(command(ReplayOp::WALL_LEFT)) != 0; }
+
+void maze::SharedMemoryBackend::move_forward(int distance) {
+    call(command(ReplayOp::MOVE_FORWARD, distance));
+}
+
+void maze::SharedMemoryBackend::turn_right() { call(command(ReplayOp::TURN_RIGHT)); }
+
+void maze::SharedMemoryBackend::turn_left() { call(command(ReplayOp::TURN_LEFT)); }
+
+void maze::SharedMemoryBackend::set_wall(int x, int y, char direction) {
+    post(command(ReplayOp::SET_WALL, x, y, direction));
+}
+
+void maze::SharedMemoryBackend::clear_wall(int x, int y, char direction) {
+    post(command(ReplayOp::CLEAR_WALL, x, y, direction));
+}
+
+void maze::SharedMemoryBackend::set_color(int x, int y, char color) {
+    post(command(ReplayOp::SET_COLOR, x, y, color));
+}
+
+void maze::SharedMemoryBackend::clear_color(int x, int y) {
+    post(command(ReplayOp::CLEAR_COLOR, x, y));
+}
+
+void maze::SharedMemoryBackend::clear_all_color() { post(command(ReplayOp::CLEAR_ALL_COLOR)); }
+
+void maze::SharedMemoryBackend::set_text(int x, int y, const std::string& text) {
+    if (text.size() > ShmRequest::MAX_TEXT) {
+        throw std::invalid_argument("Cell text is too long for the shared-memory channel");
+    }
+    ShmRequest request{command(ReplayOp::SET_TEXT, x, y)};
+    request.text_size = static_cast<std::uint8_t>(text.size());
+    std::memcpy(request.text, text.data(), text.size());
+    post(request);
+}
+
+void maze::SharedMemoryBackend::clear_text(int x, int y) {
+    post(command(ReplayOp::CLEAR_TEXT, x, y));
+}
+
+void maze::SharedMemoryBackend::clear_all_text() { post(command(ReplayOp::CLEAR_ALL_TEXT)); }
+
+bool maze::SharedMemoryBackend::was_reset() { return call(command(ReplayOp::WAS_RESET)) != 0; }
+
+void maze::SharedMemoryBackend::ack_reset() { call(command(ReplayOp::ACK_RESET)); }
+
+maze::WallReadings maze::SharedMemoryBackend::sense_walls() {
+    const int bits{call(command(ReplayOp::SENSE_WALLS))};
+    WallReadings walls;
+    walls.front = bits & 1;
+    walls.left = bits & 2;
+    walls.right = bits & 4;
+    return walls;
+}
+
+maze::SharedMemoryServer::SharedMemoryServer(const std::string& name)
+    : channel_{ShmChannel::create(name)} {}
+
+long maze::SharedMemoryServer::serve(MazeBackend& backend) {
+    long served{0};
+    while (const std::optional<ShmRequest> request{channel_.receive_request()}) {
+        ++served;
+        ShmReply reply;
+        try {
+            reply.value = execute(backend, *request);
+        } catch (const std::exception& e) {
+            reply.threw = true;
+            const std::size_t size{std::min(std::strlen(e.what()), ShmReply::MAX_ERROR)};
+            std::memcpy(reply.error, e.what(), size);
+            reply.error_size = static_cast<std::uint8_t>(size);
+        }
+        // A failed display command has no one to tell
+        if (has_reply(request->op)) {
+            channel_.send_reply(reply);
+        }
+    }
+    return served;
+}
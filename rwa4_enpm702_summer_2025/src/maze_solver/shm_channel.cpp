@@ -0,0 +1,325 @@
+#include "maze_solver/shm_channel.hpp"
+#include <atomic>
+#include <cerrno>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::uint64_t kMagic{0x4C4E4843455A414DULL}; // "MAZECHNL"
+constexpr std::uint32_t kVersion{1};
+
+static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+                  sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+              "Futex words must be plain 32-bit integers");
+
+/**
+ * @brief Single-producer single-consumer ring of slots
+ *
+ * head and tail count slots forever and wrap at 2^32, which SLOTS divides.
+ * Each side sleeps on the counter the other side advances: the consumer on
+ * tail while the ring is empty, the producer on head while it is full.
+ */
+template <typename Slot>
+struct Ring {
+    alignas(64) std::atomic<std::uint32_t> tail{0};  ///< Written by the producer
+    std::atomic<std::uint32_t> tail_sleepers{0};      ///< Consumers asleep on tail
+    alignas(64) std::atomic<std::uint32_t> head{0};  ///< Written by the consumer
+    std::atomic<std::uint32_t> head_sleepers{0};      ///< Producers asleep on head
+    alignas(64) Slot slots[maze::ShmChannel::SLOTS];
+};
+
+static_assert((maze::ShmChannel::SLOTS & (maze::ShmChannel::SLOTS - 1)) == 0,
+              "Ring size must be a power of two");
+
+} // namespace
+
+struct maze::ShmChannel::Region {
+    std::atomic<std::uint64_t> magic{0}; ///< kMagic once initialised
+    std::uint32_t version{kVersion};
+    std::atomic<std::int32_t> server_pid{0};
+    std::atomic<std::int32_t> client_pid{0};
+    std::atomic<std::uint32_t> closed{0}; ///< Set by the client when it leaves
+    Ring<ShmRequest> requests;
+    Ring<ShmReply> replies;
+};
+
+#ifdef __linux__
+
+namespace {
+
+void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/// Spinning only pays off when the peer runs on another core
+int spin_limit() {
+    static const int limit{std::thread::hardware_concurrency() > 1 ? 2000 : 0};
+    return limit;
+}
+
+bool process_alive(std::int32_t pid) { return kill(pid, 0) == 0 || errno == EPERM; }
+
+void futex_wait(std::atomic<std::uint32_t>& word, std::uint32_t value) {
+    // Bounded, so that a peer dying while we sleep is noticed
+    const timespec timeout{0, 100'000'000};
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT, value, &timeout,
+            nullptr, 0);
+}
+
+void futex_wake(std::atomic<std::uint32_t>& word) {
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE, 1, nullptr, nullptr,
+            0);
+}
+
+/**
+ * @brief Wait until a counter moves away from a value
+ * @param peer_alive Checked before each sleep
+ * @return false if peer_alive() returned false first
+ */
+template <typename Alive>
+bool wait_while(std::atomic<std::uint32_t>& word, std::uint32_t value,
+                std::atomic<std::uint32_t>& sleepers, Alive peer_alive) {
+    for (int i = 0; i < spin_limit(); ++i) {
+        if (word.load(std::memory_order_acquire) != value) {
+            return true;
+        }
+        cpu_relax();
+    }
+    while (word.load(std::memory_order_acquire) == value) {
+        if (!peer_alive()) {
+            return false;
+        }
+        // Pairs with the fence in advance(): either the other side sees the
+        // sleeper and wakes it, or this side sees the new counter
+        sleepers.fetch_add(1, std::memory_order_seq_cst);
+        if (word.load(std::memory_order_seq_cst) == value) {
+            futex_wait(word, value);
+        }
+        sleepers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+    return true;
+}
+
+/// Publish a new counter value and wake the other side if it sleeps on it
+void advance(std::atomic<std::uint32_t>& word, std::uint32_t value,
+             std::atomic<std::uint32_t>& sleepers) {
+    word.store(value, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepers.load(std::memory_order_relaxed) != 0) {
+        futex_wake(word);
+    }
+}
+
+template <typename Slot, typename Alive>
+bool push(Ring<Slot>& ring, const Slot& slot, Alive peer_alive) {
+    const std::uint32_t tail{ring.tail.load(std::memory_order_relaxed)};
+    std::uint32_t head{ring.head.load(std::memory_order_acquire)};
+    while (tail - head == maze::ShmChannel::SLOTS) {
+        if (!wait_while(ring.head, head, ring.head_sleepers, peer_alive)) {
+            return false;
+        }
+        head = ring.head.load(std::memory_order_acquire);
+    }
+    ring.slots[tail % maze::ShmChannel::SLOTS] = slot;
+    advance(ring.tail, tail + 1, ring.tail_sleepers);
+    return true;
+}
+
+template <typename Slot, typename Alive>
+std::optional<Slot> pop(Ring<Slot>& ring, Alive peer_alive) {
+    const std::uint32_t head{ring.head.load(std::memory_order_relaxed)};
+    if (ring.tail.load(std::memory_order_acquire) == head &&
+        !wait_while(ring.tail, head, ring.tail_sleepers, peer_alive)) {
+        return std::nullopt;
+    }
+    Slot slot{ring.slots[head % maze::ShmChannel::SLOTS]};
+    advance(ring.head, head + 1, ring.head_sleepers);
+    return slot;
+}
+
+std::string region_path(const std::string& name) { return "/" + name; }
+
+} // namespace
+
+maze::ShmChannel maze::ShmChannel::create(const std::string& name) {
+    const std::string path{region_path(name)};
+    int fd{shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600)};
+    if (fd < 0 && errno == EEXIST) {
+        // A server that was killed leaves its region behind; take it over
+        bool stale{false};
+        const int old{shm_open(path.c_str(), O_RDONLY, 0)};
+        struct stat status {};
+        if (old >= 0 && fstat(old, &status) == 0 &&
+            static_cast<std::size_t>(status.st_size) == sizeof(Region)) {
+            void* memory{mmap(nullptr, sizeof(Region), PROT_READ, MAP_SHARED, old, 0)};
+            if (memory != MAP_FAILED) {
+                const auto* region{static_cast<const Region*>(memory)};
+                stale = region->magic.load(std::memory_order_acquire) == kMagic &&
+                        !process_alive(region->server_pid.load(std::memory_order_relaxed));
+                munmap(memory, sizeof(Region));
+            }
+        }
+        if (old >= 0) {
+            ::close(old);
+        }
+        if (stale) {
+            shm_unlink(path.c_str());
+            fd = shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+        }
+    }
+    if (fd < 0) {
+        throw std::runtime_error("Cannot create shared memory " + path);
+    }
+    void* memory{MAP_FAILED};
+    if (ftruncate(fd, sizeof(Region)) == 0) {
+        memory = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(path.c_str());
+        throw std::runtime_error("Cannot map shared memory " + path);
+    }
+    auto* region{new (memory) Region{}};
+    region->server_pid.store(getpid(), std::memory_order_relaxed);
+    // A client only trusts the region once the magic is there
+    region->magic.store(kMagic, std::memory_order_release);
+    return ShmChannel{region, name, true};
+}
+
+maze::ShmChannel maze::ShmChannel::open(const std::string& name) {
+    const std::string path{region_path(name)};
+    const int fd{shm_open(path.c_str(), O_RDWR, 0)};
+    if (fd < 0) {
+        throw std::runtime_error("No shared memory " + path);
+    }
+    struct stat status {};
+    void* memory{MAP_FAILED};
+    if (fstat(fd, &status) == 0 && static_cast<std::size_t>(status.st_size) == sizeof(Region)) {
+        memory = mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+        throw std::runtime_error("Shared memory " + path + " is not a maze channel");
+    }
+    auto* region{static_cast<Region*>(memory)};
+    if (region->magic.load(std::memory_order_acquire) != kMagic || region->version != kVersion) {
+        munmap(memory, sizeof(Region));
+        throw std::runtime_error("Shared memory " + path +
+                                 " is not ready, or of an unsupported version");
+    }
+    std::int32_t expected{0};
+    if (!region->client_pid.compare_exchange_strong(expected, getpid())) {
+        munmap(memory, sizeof(Region));
+        throw std::runtime_error("Another client is attached to " + path);
+    }
+    return ShmChannel{region, name, false};
+}
+
+void maze::ShmChannel::send_request(const ShmRequest& request) {
+    const std::int32_t server{region_->server_pid.load(std::memory_order_relaxed)};
+    if (!push(region_->requests, request, [server] { return process_alive(server); })) {
+        throw std::runtime_error("Simulator went away");
+    }
+}
+
+maze::ShmReply maze::ShmChannel::receive_reply() {
+    const std::int32_t server{region_->server_pid.load(std::memory_order_relaxed)};
+    std::optional<ShmReply> reply{
+        pop(region_->replies, [server] { return process_alive(server); })};
+    if (!reply) {
+        throw std::runtime_error("Simulator went away");
+    }
+    return *reply;
+}
+
+std::optional<maze::ShmRequest> maze::ShmChannel::receive_request() {
+    Region& region{*region_};
+    return pop(region.requests, [&region] {
+        // The wake-up from close() can come just before we sleep; the
+        // bounded sleep then notices the flag
+        const std::int32_t client{region.client_pid.load(std::memory_order_relaxed)};
+        return region.closed.load(std::memory_order_acquire) == 0 &&
+               (client == 0 || process_alive(client));
+    });
+}
+
+void maze::ShmChannel::send_reply(const ShmReply& reply) {
+    Region& region{*region_};
+    push(region.replies, reply, [&region] {
+        const std::int32_t client{region.client_pid.load(std::memory_order_relaxed)};
+        return region.closed.load(std::memory_order_acquire) == 0 && process_alive(client);
+    });
+}
+
+void maze::ShmChannel::close() {
+    if (region_ != nullptr && !owner_) {
+        region_->closed.store(1, std::memory_order_release);
+        futex_wake(region_->requests.tail);
+    }
+}
+
+maze::ShmChannel::~ShmChannel() {
+    if (region_ == nullptr) {
+        return;
+    }
+    close();
+    munmap(region_, sizeof(Region));
+    if (owner_) {
+        shm_unlink(region_path(name_).c_str());
+    }
+}
+
+#else
+
+maze::ShmChannel maze::ShmChannel::create(const std::string&) {
+    throw std::runtime_error("Shared-memory channels need Linux");
+}
+
+maze::ShmChannel maze::ShmChannel::open(const std::string&) {
+    throw std::runtime_error("Shared-memory channels need Linux");
+}
+
+void maze::ShmChannel::send_request(const ShmRequest&) {}
+maze::ShmReply maze::ShmChannel::receive_reply() { return {}; }
+std::optional<maze::ShmRequest> maze::ShmChannel::receive_request() { return std::nullopt; }
+void maze::ShmChannel::send_reply(const ShmReply&) {}
+void maze::ShmChannel::close() {}
+maze::ShmChannel::~ShmChannel() = default;
+
+#endif
+
+maze::ShmChannel::ShmChannel(Region* region, std::string name, bool owner)
+    : region_{region}, name_{std::move(name)}, owner_{owner} {}
+
+maze::ShmChannel::ShmChannel(ShmChannel&& other) noexcept
+    : region_{std::exchange(other.region_, nullptr)},
+      name_{std::move(other.name_)},
+      owner_{other.owner_} {}
+
+maze::ShmChannel& maze::ShmChannel::operator=(ShmChannel&& other) noexcept {
+    if (this != &other) {
+        ShmChannel old{std::move(*this)};
+        region_ = std::exchange(other.region_, nullptr);
+        name_ = std::move(other.name_);
+        owner_ = other.owner_;
+    }
+    return *this;
+}
@@ -0,0 +1,216 @@
+#include "maze_solver/simulator_backend.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+std::vector<std::uint8_t> read_bytes(const std::string& path) {
+    std::ifstream file{path, std::ios::binary};
+    if (!file) {
+        throw std::runtime_error("Cannot open maze file " + path);
+    }
+    return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+// Binary .maz: one byte per cell of a square maze, column-major
+std::unique_ptr<maze::SimulatorBackend> load_maz(const std::string& path) {
+    const std::vector<std::uint8_t> bytes{read_bytes(path)};
+    const int size{static_cast<int>(std::lround(std::sqrt(bytes.size())))};
+    if (size == 0 || static_cast<std::size_t>(size * size) != bytes.size()) {
+        throw std::runtime_error("Maze file " + path + " is not a square .maz maze");
+    }
+    std::vector<std::uint8_t> walls(bytes.size());
+    for (int x = 0; x < size; ++x) {
+        for (int y = 0; y < size; ++y) {
+            walls[static_cast<std::size_t>(y * size + x)] =
+                bytes[static_cast<std::size_t>(x * size + y)] & 0x0F;
+        }
+    }
+    return std::make_unique<maze::SimulatorBackend>(size, size, std::move(walls));
+}
+
+// Text .num: one "x y N E S W" line per cell
+std::unique_ptr<maze::SimulatorBackend> load_num(const std::string& path) {
+    std::ifstream file{path};
+    if (!file) {
+        throw std::runtime_error("Cannot open maze file " + path);
+    }
+    struct Cell {
+        int x;
+        int y;
+        std::uint8_t walls;
+    };
+    std::vector<Cell> cells;
+    int width{0};
+    int height{0};
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields{line};
+        int x{0};
+        int y{0};
+        int sides[4]{};
+        if (!(fields >> x >> y >> sides[0] >> sides[1] >> sides[2] >> sides[3])) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            throw std::runtime_error("Malformed line in maze file " + path + ": " + line);
+        }
+        if (x < 0 || y < 0) {
+            throw std::runtime_error("Negative cell coordinate in maze file " + path);
+        }
+        std::uint8_t mask{0};
+        for (int side = 0; side < 4; ++side) {
+            if (sides[side] != 0) {
+                mask |= maze::wall_bit(static_cast<maze::Heading>(side));
+            }
+        }
+        cells.push_back({x, y, mask});
+        width = std::max(width, x + 1);
+        height = std::max(height, y + 1);
+    }
+    if (cells.empty()) {
+        throw std::runtime_error("Maze file " + path + " lists no cells");
+    }
+    // The size comes from the largest coordinates, so every cell up to them
+    // must be listed exactly once
+    std::vector<std::uint8_t> walls(static_cast<std::size_t>(width * height), 0);
+    std::vector<bool> listed(walls.size(), false);
+    for (const auto& cell : cells) {
+        const auto index{static_cast<std::size_t>(cell.y * width + cell.x)};
+        if (listed[index]) {
+            throw std::runtime_error("Cell (" + std::to_string(cell.x) + ", " +
+                                     std::to_string(cell.y) + ") is listed twice in maze file " +
+                                     path);
+        }
+        listed[index] = true;
+        walls[index] = cell.walls;
+    }
+    if (cells.size() != walls.size()) {
+        throw std::runtime_error("Maze file " + path + " lists " + std::to_string(cells.size()) +
+                                 " of the " + std::to_string(walls.size()) + " cells of a " +
+                                 std::to_string(width) + "x" + std::to_string(height) + " maze");
+    }
+    return std::make_unique<maze::SimulatorBackend>(width, height, std::move(walls));
+}
+
+maze::MazeMap to_map(int width, int height, const std::vector<std::uint8_t>& walls) {
+    maze::MazeMap map{width, height};
+    if (walls.size() != static_cast<std::size_t>(map.cell_count())) {
+        throw std::invalid_argument("Wall masks do not match the maze dimensions");
+    }
+    for (int index = 0; index < map.cell_count(); ++index) {
+        map.set_cell_walls(index, walls[static_cast<std::size_t>(index)]);
+    }
+    return map;
+}
+
+bool has_extension(const std::string& path, const std::string& extension) {
+    return path.size() >= extension.size() &&
+           path.compare(path.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+} // namespace
+
+maze::SimulatorBackend::SimulatorBackend(int width, int height, std::vector<std::uint8_t> walls)
+    : SimulatorBackend{to_map(width, height, walls)} {}
+
+maze::SimulatorBackend::SimulatorBackend(MazeMap maze)
+    : owned_{std::make_unique<MazeMap>(std::move(maze))}, maze_{*owned_} {
+    // The outer boundary is closed even if the maze leaves it open
+    owned_->mark_boundary();
+}
+
+maze::SimulatorBackend::SimulatorBackend(MazeView maze) : maze_{maze} {}
+
+std::unique_ptr<maze::SimulatorBackend> maze::SimulatorBackend::load(const std::string& path) {
+    if (has_extension(path, ".maz")) {
+        return load_maz(path);
+    }
+    if (has_extension(path, ".num")) {
+        return load_num(path);
+    }
+    throw std::runtime_error("Unsupported maze file format: " + path);
+}
+
+bool maze::SimulatorBackend::has_wall(int x, int y, Heading side) const {
+    return !maze_.contains(x, y) || maze_.has_wall(maze_.index(x, y), side);
+}
+
+bool maze::SimulatorBackend::at_goal() const { return maze_.is_goal(maze_.index(x_, y_)); }
+
+bool maze::SimulatorBackend::has_wall_front() {
+    ++commands_;
+    return has_wall(x_, y_, heading_);
+}
+
+bool maze::SimulatorBackend::has_wall_right() {
+    ++commands_;
+    return has_wall(x_, y_, turned_right(heading_));
+}
+
+bool maze::SimulatorBackend::has_wall_left() {
+    ++commands_;
+    return has_wall(x_, y_, turned_left(heading_));
+}
+
+void maze::SimulatorBackend::move_forward(int distance) {
+    ++commands_;
+    for (int i = 0; i < distance; ++i) {
+        if (has_wall(x_, y_, heading_)) {
+            throw std::runtime_error("Robot crashed into a wall");
+        }
+        x_ += dx(heading_);
+        y_ += dy(heading_);
+        ++cells_moved_;
+    }
+}
+
+void maze::SimulatorBackend::turn_right() {
+    ++commands_;
+    ++turns_;
+    heading_ = turned_right(heading_);
+}
+
+void maze::SimulatorBackend::turn_left() {
+    ++commands_;
+    ++turns_;
+    heading_ = turned_left(heading_);
+}
+
+void maze::SimulatorBackend::set_wall(int, int, char) { ++commands_; }
+
+void maze::SimulatorBackend::clear_wall(int, int, char) { ++commands_; }
+
+void maze::SimulatorBackend::set_color(int, int, char) { ++commands_; }
+
+void maze::SimulatorBackend::clear_color(int, int) { ++commands_; }
+
+void maze::SimulatorBackend::clear_all_color() { ++commands_; }
+
+void maze::SimulatorBackend::set_text(int, int, const std::string&) { ++commands_; }
+
+void maze::SimulatorBackend::clear_text(int, int) { ++commands_; }
+
+void maze::SimulatorBackend::clear_all_text() { ++commands_; }
+
+bool maze::SimulatorBackend::was_reset() {
+    ++commands_;
+    return reset_pending_;
+}
+
+void maze::SimulatorBackend::ack_reset() {
+    ++commands_;
+    reset_pending_ = false;
+}
+
+void maze::SimulatorBackend::reset() {
+    x_ = 0;
+    y_ = 0;
+    heading_ = Heading::NORTH;
+    reset_pending_ = true;
+}
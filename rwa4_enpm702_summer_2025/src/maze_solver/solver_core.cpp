@@ -0,0 +1,4 @@
+#include "maze_solver/solver_core.hpp"
+
+maze::DynamicSolverCore::DynamicSolverCore(int width, int height)
+    : map_{width, height}, field_{map_, map_.centre_cells()} {}
@@ -0,0 +1,179 @@
+#include "maze_solver/solver_snapshot.hpp"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic{'M', 'A', 'Z', 'E', 'S', 'N', 'A', 'P'};
+constexpr std::uint32_t kVersion{1};
+
+std::uint32_t fnv1a(const char* data, std::size_t size) {
+    std::uint32_t hash{2166136261u};
+    for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<std::uint8_t>(data[i])) * 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof value);
+}
+
+/**
+ * @brief Reads fixed-size values from a byte string, failing past its end
+ */
+class Cursor {
+public:
+    explicit Cursor(const std::string& bytes) : bytes_{bytes} {}
+
+    template <typename T>
+    T get() {
+        T value;
+        std::memcpy(&value, take(sizeof value), sizeof value);
+        return value;
+    }
+
+    const char* take(std::size_t size) {
+        if (bytes_.size() - position_ < size) {
+            throw std::runtime_error("Solver snapshot is truncated");
+        }
+        const char* data{bytes_.data() + position_};
+        position_ += size;
+        return data;
+    }
+
+    [[nodiscard]] std::size_t position() const { return position_; }
+
+private:
+    const std::string& bytes_;
+    std::size_t position_{0};
+};
+
+} // namespace
+
+maze::SolverSnapshot maze::SolverSnapshot::capture(const MazeMap& map, const FloodFill& field) {
+    SolverSnapshot snapshot;
+    snapshot.width_ = map.width();
+    snapshot.height_ = map.height();
+    snapshot.goals_ = field.goals();
+    snapshot.cells_.assign(map.data(), map.data() + map.cell_count());
+    snapshot.distances_ = field.distances();
+    return snapshot;
+}
+
+void maze::SolverSnapshot::restore(MazeMap& map, FloodFill& field) const {
+    if (map.width() != width_ || map.height() != height_) {
+        throw std::invalid_argument("Snapshot is of a maze of another size");
+    }
+    if (field.goals() != goals_) {
+        throw std::invalid_argument("Snapshot is of a solver with other goals");
+    }
+    map.assign_cells(cells_.data());
+    field.restore(distances_);
+}
+
+std::string maze::SolverSnapshot::serialize() const {
+    // Distances fit in 16 bits on mazes of up to 65535 cells
+    const std::size_t cells{cells_.size()};
+    const bool narrow{cells < std::numeric_limits<std::uint16_t>::max()};
+    std::string out;
+    out.reserve(32 + goals_.size() * 4 + cells * (narrow ? 3 : 5));
+    out.append(kMagic.data(), kMagic.size());
+    put(out, kVersion);
+    put(out, static_cast<std::uint16_t>(width_));
+    put(out, static_cast<std::uint16_t>(height_));
+    put(out, static_cast<std::uint16_t>(goals_.size()));
+    put(out, static_cast<std::uint8_t>(narrow ? 2 : 4));
+    put(out, std::uint8_t{0});
+    for (int goal : goals_) {
+        put(out, static_cast<std::uint32_t>(goal));
+    }
+    out.append(reinterpret_cast<const char*>(cells_.data()), cells);
+    for (int distance : distances_) {
+        if (narrow) {
+            put(out, distance == FloodFill::UNREACHABLE ? std::numeric_limits<std::uint16_t>::max()
+                                                        : static_cast<std::uint16_t>(distance));
+        } else {
+            put(out, distance == FloodFill::UNREACHABLE ? std::numeric_limits<std::uint32_t>::max()
+                                                        : static_cast<std::uint32_t>(distance));
+        }
+    }
+    put(out, fnv1a(out.data(), out.size()));
+    return out;
+}
+
+maze::SolverSnapshot maze::SolverSnapshot::deserialize(const std::string& bytes) {
+    Cursor in{bytes};
+    if (std::memcmp(in.take(kMagic.size()), kMagic.data(), kMagic.size()) != 0 ||
+        in.get<std::uint32_t>() != kVersion) {
+        throw std::runtime_error("Not a solver snapshot, or an unsupported version");
+    }
+    SolverSnapshot snapshot;
+    snapshot.width_ = in.get<std::uint16_t>();
+    snapshot.height_ = in.get<std::uint16_t>();
+    const std::size_t goal_count{in.get<std::uint16_t>()};
+    const std::uint8_t distance_bytes{in.get<std::uint8_t>()};
+    in.get<std::uint8_t>();
+    const std::size_t cells{static_cast<std::size_t>(snapshot.width_) *
+                            static_cast<std::size_t>(snapshot.height_)};
+    if (cells == 0 || (distance_bytes != 2 && distance_bytes != 4)) {
+        throw std::runtime_error("Solver snapshot is malformed");
+    }
+
+    for (std::size_t i = 0; i < goal_count; ++i) {
+        const std::uint32_t goal{in.get<std::uint32_t>()};
+        if (goal >= cells) {
+            throw std::runtime_error("Solver snapshot goal is out of the maze");
+        }
+        snapshot.goals_.push_back(static_cast<int>(goal));
+    }
+    const auto* cell_bytes{reinterpret_cast<const std::uint8_t*>(in.take(cells))};
+    snapshot.cells_.assign(cell_bytes, cell_bytes + cells);
+    snapshot.distances_.reserve(cells);
+    for (std::size_t i = 0; i < cells; ++i) {
+        if (distance_bytes == 2) {
+            const std::uint16_t distance{in.get<std::uint16_t>()};
+            snapshot.distances_.push_back(distance == std::numeric_limits<std::uint16_t>::max()
+                                              ? FloodFill::UNREACHABLE
+                                              : static_cast<int>(distance));
+        } else {
+            const std::uint32_t distance{in.get<std::uint32_t>()};
+            snapshot.distances_.push_back(distance == std::numeric_limits<std::uint32_t>::max()
+                                              ? FloodFill::UNREACHABLE
+                                              : static_cast<int>(distance));
+        }
+    }
+
+    const std::size_t payload{in.position()};
+    if (in.get<std::uint32_t>() != fnv1a(bytes.data(), payload)) {
+        throw std::runtime_error("Solver snapshot fails its checksum");
+    }
+    return snapshot;
+}
+
+void maze::SolverSnapshot::save(const std::string& path) const {
+    const std::string bytes{serialize()};
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    if (!out) {
+        throw std::runtime_error("Cannot write solver snapshot " + path);
+    }
+}
+
+maze::SolverSnapshot maze::SolverSnapshot::load(const std::string& path) {
+    std::ifstream in{path, std::ios::binary};
+    if (!in) {
+        throw std::runtime_error("Cannot open solver snapshot " + path);
+    }
+    const std::string bytes{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    try {
+        return deserialize(bytes);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error(std::string{e.what()} + ": " + path);
+    }
+}
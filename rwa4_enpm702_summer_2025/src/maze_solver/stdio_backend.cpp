@@ -0,0 +1,211 @@
+#include "maze_solver/stdio_backend.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+void check_move_ack(std::string_view response) {
+    if (response != "ack") {
+        std::cerr << response << std::endl;
+        throw std::runtime_error{"Unexpected move reply: " + std::string{response}};
+    }
+}
+
+} // namespace
+
+maze::StdioBackend::StdioBackend() : StdioBackend(std::cout, std::cin) {}
+
+maze::StdioBackend::StdioBackend(std::ostream& out, std::istream& in)
+    : writer_{out}, reader_{in} {}
+
+// Commands still buffered when the backend goes away must reach the simulator
+maze::StdioBackend::~StdioBackend() { writer_.flush(); }
+
+void maze::StdioBackend::read_deferred_reply() {
+    const std::string_view response{reader_.read_token()};
+    const std::string_view command{deferred_replies_.front()};
+    deferred_replies_.pop_front();
+    if (command == "moveForward") {
+        check_move_ack(response);
+    } else if (command.substr(0, 4) == "wall") {
+        // Queries are answered in the order they were sent
+        const std::uint64_t ticket{answered_queries_++};
+        if (ticket >= first_query_) {
+            QueryState& state{query_state(ticket)};
+            if (state == QueryState::PENDING) {
+                state = response == "true" ? QueryState::WALL : QueryState::OPEN;
+            }
+        }
+        retire_queries();
+    }
+}
+
+void maze::StdioBackend::drain_deferred_replies() {
+    while (!deferred_replies_.empty()) {
+        read_deferred_reply();
+    }
+}
+
+void maze::StdioBackend::retire_queries() {
+    while (!query_states_.empty() && query_states_.front() == QueryState::DONE &&
+           first_query_ < answered_queries_) {
+        query_states_.pop_front();
+        ++first_query_;
+    }
+}
+
+maze::ProtocolReader& maze::StdioBackend::await_reply() {
+    writer_.flush();
+    drain_deferred_replies();
+    return reader_;
+}
+
+void maze::StdioBackend::acknowledged_command(std::string_view command) {
+    writer_.command(command).end();
+    if (batching_) {
+        deferred_replies_.push_back(command);
+        return;
+    }
+    await_reply().read_ack();
+}
+
+int maze::StdioBackend::get_maze_width() {
+    writer_.command("mazeWidth").end();
+    return await_reply().read_int();
+}
+
+int maze::StdioBackend::get_maze_height() {
+    writer_.command("mazeHeight").end();
+    return await_reply().read_int();
+}
+
+bool maze::StdioBackend::has_wall_front() {
+    writer_.command("wallFront").end();
+    return await_reply().read_bool();
+}
+
+bool maze::StdioBackend::has_wall_right() {
+    writer_.command("wallRight").end();
+    return await_reply().read_bool();
+}
+
+bool maze::StdioBackend::has_wall_left() {
+    writer_.command("wallLeft").end();
+    return await_reply().read_bool();
+}
+
+void maze::StdioBackend::move_forward(int distance) {
+    writer_.command("moveForward");
+    // Don't print distance argument unless explicitly specified, for
+    // backwards compatibility with older versions of the simulator
+    if (distance != 1) {
+        writer_.arg(distance);
+    }
+    writer_.end();
+    if (batching_) {
+        deferred_replies_.push_back("moveForward");
+        return;
+    }
+    check_move_ack(await_reply().read_token());
+}
+
+void maze::StdioBackend::turn_right() { acknowledged_command("turnRight"); }
+
+void maze::StdioBackend::turn_left() { acknowledged_command("turnLeft"); }
+
+void maze::StdioBackend::set_wall(int x, int y, char direction) {
+    writer_.command("setWall").arg(x).arg(y).arg(direction).end();
+}
+
+void maze::StdioBackend::clear_wall(int x, int y, char direction) {
+    writer_.command("clearWall").arg(x).arg(y).arg(direction).end();
+}
+
+void maze::StdioBackend::set_color(int x, int y, char color) {
+    writer_.command("setColor").arg(x).arg(y).arg(color).end();
+}
+
+void maze::StdioBackend::clear_color(int x, int y) {
+    writer_.command("clearColor").arg(x).arg(y).end();
+}
+
+void maze::StdioBackend::clear_all_color() { writer_.command("clearAllColor").end(); }
+
+void maze::StdioBackend::set_text(int x, int y, const std::string& text) {
+    writer_.command("setText").arg(x).arg(y).arg(std::string_view{text}).end();
+}
+
+void maze::StdioBackend::clear_text(int x, int y) {
+    writer_.command("clearText").arg(x).arg(y).end();
+}
+
+void maze::StdioBackend::clear_all_text() { writer_.command("clearAllText").end(); }
+
+bool maze::StdioBackend::was_reset() {
+    writer_.command("wasReset").end();
+    return await_reply().read_bool();
+}
+
+void maze::StdioBackend::ack_reset() {
+    writer_.command("ackReset").end();
+    await_reply().read_ack();
+}
+
+maze::WallReadings maze::StdioBackend::sense_walls() {
+    // The three queries go out together; their replies come back in order
+    writer_.command("wallFront").end();
+    writer_.command("wallLeft").end();
+    writer_.command("wallRight").end();
+    ProtocolReader& reader{await_reply()};
+    WallReadings walls;
+    walls.front = reader.read_bool();
+    walls.left = reader.read_bool();
+    walls.right = reader.read_bool();
+    return walls;
+}
+
+maze::WallFuture maze::StdioBackend::query_wall(WallSide side) {
+    static constexpr std::string_view kCommands[]{"wallFront", "wallLeft", "wallRight"};
+    const std::string_view command{kCommands[static_cast<std::size_t>(side)]};
+    writer_.command(command).end();
+    deferred_replies_.push_back(command);
+    query_states_.push_back(QueryState::PENDING);
+    return WallFuture{*this, first_query_ + query_states_.size() - 1};
+}
+
+bool maze::StdioBackend::is_wall_query_ready(std::uint64_t ticket) const {
+    return ticket < answered_queries_;
+}
+
+bool maze::StdioBackend::await_wall_query(std::uint64_t ticket) {
+    if (ticket >= answered_queries_) {
+        // Read up to this query's reply only, leaving later ones in flight
+        writer_.flush();
+        while (ticket >= answered_queries_) {
+            read_deferred_reply();
+        }
+    }
+    QueryState& state{query_state(ticket)};
+    const bool wall{state == QueryState::WALL};
+    state = QueryState::DONE;
+    retire_queries();
+    return wall;
+}
+
+void maze::StdioBackend::release_wall_query(std::uint64_t ticket) {
+    query_state(ticket) = QueryState::DONE;
+    retire_queries();
+}
+
+void maze::StdioBackend::set_batching(bool enabled) {
+    // The mode changes even if an owed reply turns out to be an error
+    const bool was_batching{batching_};
+    batching_ = enabled;
+    if (!enabled && was_batching) {
+        writer_.flush();
+        drain_deferred_replies();
+    }
+}
+
+void maze::StdioBackend::flush() { writer_.flush(); }
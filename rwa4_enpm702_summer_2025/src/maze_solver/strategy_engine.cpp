@@ -0,0 +1,162 @@
+#include "maze_solver/strategy_engine.hpp"
+#include "maze_solver/flood_fill.hpp"
+#include "maze_solver/maze_api.hpp"
+#include <algorithm>
+#include <chrono>
+
+maze::StrategyEngine::StrategyEngine(StrategyKind kind)
+    : StrategyEngine{kind, MazeControlAPI::get_maze_width(), MazeControlAPI::get_maze_height()} {}
+
+maze::StrategyEngine::StrategyEngine(StrategyKind kind, int width, int height)
+    : kind_{kind},
+      cache_{width, height},
+      goals_{cache_.map().centre_cells()},
+      strategy_{make_strategy(kind, cache_.map(), goals_)},
+      visited_(static_cast<std::size_t>(cache_.map().cell_count()), 0) {}
+
+void maze::StrategyEngine::notify(int index, std::uint8_t before, std::optional<Heading> skip) {
+    const std::uint8_t changed{static_cast<std::uint8_t>(before ^ cache_.map().cell(index))};
+    for (Heading side : {Heading::NORTH, Heading::EAST, Heading::SOUTH, Heading::WEST}) {
+        const unsigned bit{wall_bit(side)};
+        if (side != skip && (changed & (bit | bit << 4))) {
+            strategy_->on_wall_changed(index, side);
+        }
+    }
+}
+
+maze::SolverSnapshot maze::StrategyEngine::snapshot() const {
+    // The wall follower and A* keep no field; one is computed for them
+    if (const FloodFill* field{strategy_->field()}) {
+        return SolverSnapshot::capture(cache_.map(), *field);
+    }
+    const FloodFill field{cache_.map(), goals_};
+    return SolverSnapshot::capture(cache_.map(), field);
+}
+
+void maze::StrategyEngine::restore(const SolverSnapshot &snapshot) {
+    MazeMap map{cache_.map().width(), cache_.map().height()};
+    FloodFill field{map, goals_};
+    snapshot.restore(map, field);
+    cache_.load_map(map);
+    strategy_ = make_strategy(kind_, cache_.map(), goals_, field);
+}
+
+maze::ExplorationStats maze::StrategyEngine::run() {
+    using clock = std::chrono::steady_clock;
+    const auto start{clock::now()};
+    const MazeMap &map{cache_.map()};
+    const long max_steps{STEPS_PER_CELL * map.cell_count()};
+    ExplorationStats stats;
+
+    // The start cell is sensed on its own; every later cell is sensed in
+    // the round trip of the move that reaches it
+    int cell{map.index(cache_.x(), cache_.y())};
+    long misses{cache_.misses()};
+    const std::uint8_t start_walls{map.cell(cell)};
+    cache_.sense();
+    notify(cell, start_walls);
+
+    while (true) {
+        if (cache_.misses() != misses) {
+            ++stats.wall_queries;
+            misses = cache_.misses();
+        }
+        if (!visited_[static_cast<std::size_t>(cell)]) {
+            visited_[static_cast<std::size_t>(cell)] = 1;
+            ++stats.explored_cells;
+        }
+        if (std::find(goals_.begin(), goals_.end(), cell) != goals_.end()) {
+            stats.reached_goal = true;
+            break;
+        }
+        if (stats.steps >= max_steps) {
+            break;
+        }
+        if (watch_resets_ && MazeControlAPI::was_reset()) {
+            stats.interrupted = true;
+            break;
+        }
+        const Heading heading{cache_.heading()};
+        const std::optional<Heading> next{strategy_->next_side(cell, heading)};
+        if (!next || map.has_wall(cell, *next)) {
+            break;
+        }
+        if (*next == turned_left(heading)) {
+            cache_.turn_left();
+            ++stats.turns;
+        } else if (*next == turned_right(heading)) {
+            cache_.turn_right();
+            ++stats.turns;
+        } else if (*next != heading) {
+            cache_.turn_right();
+            cache_.turn_right();
+            stats.turns += 2;
+        }
+        const int to{map.neighbour(cell, *next)};
+        const std::uint8_t from_walls{map.cell(cell)};
+        const std::uint8_t to_walls{map.cell(to)};
+        cache_.move_forward_and_sense();
+        // The opening between the two cells is reported once, from the cell
+        // left behind
+        notify(cell, from_walls);
+        notify(to, to_walls, reversed(*next));
+        cell = to;
+        ++stats.steps;
+        ++stats.moves;
+    }
+    stats.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    return stats;
+}
+
+bool maze::StrategyEngine::follow(const Plan &plan, ExplorationStats &stats) {
+    for (const Motion &motion : plan.motions) {
+        if (watch_resets_ && MazeControlAPI::was_reset()) {
+            stats.interrupted = true;
+            return false;
+        }
+        switch (motion.kind) {
+        case Motion::Kind::FORWARD:
+            cache_.move_forward(motion.cells);
+            stats.steps += motion.cells;
+            ++stats.moves;
+            break;
+        case Motion::Kind::TURN_LEFT:
+            cache_.turn_left();
+            ++stats.turns;
+            break;
+        case Motion::Kind::TURN_RIGHT:
+            cache_.turn_right();
+            ++stats.turns;
+            break;
+        }
+    }
+    return true;
+}
+
+maze::ExplorationStats maze::StrategyEngine::speed_run() {
+    using clock = std::chrono::steady_clock;
+    const PathPlanner planner;
+    const MazeMap &map{cache_.map()};
+    ExplorationStats stats;
+
+    // The way back is not timed
+    const int start_cell{map.index(0, 0)};
+    const Plan back{planner.plan(map, map.index(cache_.x(), cache_.y()), cache_.heading(),
+                                 {start_cell})};
+    if (!back.found) {
+        return stats;
+    }
+    ExplorationStats return_leg;
+    if (!follow(back, return_leg)) {
+        stats.interrupted = true;
+        return stats;
+    }
+
+    const auto start{clock::now()};
+    const Plan run{planner.plan(map, start_cell, cache_.heading(), goals_)};
+    if (run.found && follow(run, stats)) {
+        stats.reached_goal = true;
+    }
+    stats.seconds = std::chrono::duration<double>(clock::now() - start).count();
+    return stats;
+}
@@ -0,0 +1,39 @@
+#include "maze_solver/wall_future.hpp"
+#include "maze_solver/maze_backend.hpp"
+#include <utility>
+
+maze::WallFuture::WallFuture(WallFuture&& other) noexcept
+    : backend_{std::exchange(other.backend_, nullptr)},
+      ticket_{other.ticket_},
+      wall_{other.wall_} {}
+
+maze::WallFuture& maze::WallFuture::operator=(WallFuture&& other) noexcept {
+    if (this != &other) {
+        release();
+        backend_ = std::exchange(other.backend_, nullptr);
+        ticket_ = other.ticket_;
+        wall_ = other.wall_;
+    }
+    return *this;
+}
+
+maze::WallFuture::~WallFuture() { release(); }
+
+void maze::WallFuture::release() {
+    if (backend_ != nullptr) {
+        backend_->release_wall_query(ticket_);
+        backend_ = nullptr;
+    }
+}
+
+bool maze::WallFuture::is_ready() const {
+    return backend_ == nullptr || backend_->is_wall_query_ready(ticket_);
+}
+
+bool maze::WallFuture::get() {
+    if (backend_ != nullptr) {
+        wall_ = backend_->await_wall_query(ticket_);
+        backend_ = nullptr;
+    }
+    return wall_;
+}